@@ -154,7 +154,8 @@ namespace Style {
 
 			flex_basis_type(LengthPercentageAuto::Auto), row_gap_type(LengthPercentage::Length), column_gap_type(LengthPercentage::Length),
 
-			vertical_align_type(VerticalAlign::Baseline), drag(Drag::None), tab_index(TabIndex::None), overscroll_behavior(OverscrollBehavior::Auto)
+			vertical_align_type(VerticalAlign::Baseline), drag(Drag::None), tab_index(TabIndex::None), overscroll_behavior(OverscrollBehavior::Auto),
+			contain(Contain::None)
 		{}
 
 		LengthPercentage::Type min_width_type : 1, max_width_type : 1;
@@ -170,6 +171,7 @@ namespace Style {
 		Drag drag : 3;
 		TabIndex tab_index : 1;
 		OverscrollBehavior overscroll_behavior : 1;
+		Contain contain : 1;
 
 		Clip clip;
 
@@ -193,6 +195,66 @@ namespace Style {
 		float scrollbar_margin = 0.f;
 	};
 
+	/*
+	    A reference-counted handle to a group of computed values, shared between elements until one of them writes to it.
+
+	    Handles initially refer to a shared group of default values. Reference counts are not atomic, computed values must only be modified
+	    from a single thread.
+	*/
+	template <typename T>
+	class CopyOnWrite {
+	public:
+		CopyOnWrite() : node(GetDefaultNode()) { node->ref_count += 1; }
+		CopyOnWrite(const CopyOnWrite& other) : node(other.node) { node->ref_count += 1; }
+		CopyOnWrite& operator=(const CopyOnWrite& other)
+		{
+			other.node->ref_count += 1;
+			Release();
+			node = other.node;
+			return *this;
+		}
+		~CopyOnWrite() { Release(); }
+
+		const T& operator*() const { return node->values; }
+		const T* operator->() const { return &node->values; }
+
+		/// Returns the values for modification, making a private copy first if they are shared.
+		T& Write()
+		{
+			if (node->ref_count > 1)
+			{
+				node->ref_count -= 1;
+				node = new Node{node->values, 1};
+			}
+			return node->values;
+		}
+
+		/// Returns true if both handles refer to the same group of values.
+		bool IsSharedWith(const CopyOnWrite& other) const { return node == other.node; }
+
+	private:
+		struct Node {
+			T values;
+			int ref_count;
+		};
+
+		void Release()
+		{
+			node->ref_count -= 1;
+			if (node->ref_count == 0)
+				delete node;
+		}
+
+		// The default node holds a reference to itself, thereby it is never deleted, not even during static destruction.
+		static Node* GetDefaultNode()
+		{
+			static Node* default_node = new Node{T(), 1};
+			return default_node;
+		}
+
+		Node* node;
+	};
+
 	class ComputedValues : NonCopyMoveable {
 	public:
 		ComputedValues(Element* element) : element(element) {}
@@ -237,37 +299,37 @@ namespace Style {
 		// -- Inherited --
 		String         font_family()      const;
 		String         cursor()           const;
-		FontFaceHandle font_face_handle() const { return inherited.font_face_handle; }
-		float          font_size()        const { return inherited.font_size; }
-		bool           has_font_effect()  const { return inherited.has_font_effect; }
-		FontStyle      font_style()       const { return inherited.font_style; }
-		FontWeight     font_weight()      const { return inherited.font_weight; }
-		PointerEvents  pointer_events()   const { return inherited.pointer_events; }
-		Focus          focus()            const { return inherited.focus; }
-		TextAlign      text_align()       const { return inherited.text_align; }
-		TextDecoration text_decoration()  const { return inherited.text_decoration; }
-		TextTransform  text_transform()   const { return inherited.text_transform; }
-		WhiteSpace     white_space()      const { return inherited.white_space; }
-		WordBreak      word_break()       const { return inherited.word_break; }
-		Colourb        color()            const { return inherited.color; }
-		float          opacity()          const { return inherited.opacity; }
-		LineHeight     line_height()      const { return LineHeight(inherited.line_height, inherited.line_height_inherit_type, inherited.line_height_inherit); }
+		FontFaceHandle font_face_handle() const { return inherited->font_face_handle; }
+		float          font_size()        const { return inherited->font_size; }
+		bool           has_font_effect()  const { return inherited->has_font_effect; }
+		FontStyle      font_style()       const { return inherited->font_style; }
+		FontWeight     font_weight()      const { return inherited->font_weight; }
+		PointerEvents  pointer_events()   const { return inherited->pointer_events; }
+		Focus          focus()            const { return inherited->focus; }
+		TextAlign      text_align()       const { return inherited->text_align; }
+		TextDecoration text_decoration()  const { return inherited->text_decoration; }
+		TextTransform  text_transform()   const { return inherited->text_transform; }
+		WhiteSpace     white_space()      const { return inherited->white_space; }
+		WordBreak      word_break()       const { return inherited->word_break; }
+		Colourb        color()            const { return inherited->color; }
+		float          opacity()          const { return inherited->opacity; }
+		LineHeight     line_height()      const { return LineHeight(inherited->line_height, inherited->line_height_inherit_type, inherited->line_height_inherit); }
 
 		// -- Rare --
-		MinWidth          min_width()                  const { return LengthPercentage(rare.min_width_type, rare.min_width); }
-		MaxWidth          max_width()                  const { return LengthPercentage(rare.max_width_type, rare.max_width); }
-		MinHeight         min_height()                 const { return LengthPercentage(rare.min_height_type, rare.min_height); }
-		MinHeight         max_height()                 const { return LengthPercentage(rare.max_height_type, rare.max_height); }
-		VerticalAlign     vertical_align()             const { return VerticalAlign(rare.vertical_align_type, rare.vertical_align_length); }
+		MinWidth          min_width()                  const { return LengthPercentage(rare->min_width_type, rare->min_width); }
+		MaxWidth          max_width()                  const { return LengthPercentage(rare->max_width_type, rare->max_width); }
+		MinHeight         min_height()                 const { return LengthPercentage(rare->min_height_type, rare->min_height); }
+		MinHeight         max_height()                 const { return LengthPercentage(rare->max_height_type, rare->max_height); }
+		VerticalAlign     vertical_align()             const { return VerticalAlign(rare->vertical_align_type, rare->vertical_align_length); }
 		const             AnimationList* animation()   const;
 		const             TransitionList* transition() const;
-		float             perspective()                const { return rare.perspective; }
-		PerspectiveOrigin perspective_origin_x()       const { return LengthPercentage(rare.perspective_origin_x_type, rare.perspective_origin_x); }
-		PerspectiveOrigin perspective_origin_y()       const { return LengthPercentage(rare.perspective_origin_y_type, rare.perspective_origin_y); }
+		float             perspective()                const { return rare->perspective; }
+		PerspectiveOrigin perspective_origin_x()       const { return LengthPercentage(rare->perspective_origin_x_type, rare->perspective_origin_x); }
+		PerspectiveOrigin perspective_origin_y()       const { return LengthPercentage(rare->perspective_origin_y_type, rare->perspective_origin_y); }
 		TransformPtr      transform()                  const { return GetLocalProperty(PropertyId::Transform, TransformPtr()); }
-		TransformOrigin   transform_origin_x()         const { return LengthPercentage(rare.transform_origin_x_type, rare.transform_origin_x); }
-		TransformOrigin   transform_origin_y()         const { return LengthPercentage(rare.transform_origin_y_type, rare.transform_origin_y); }
-		float             transform_origin_z()         const { return rare.transform_origin_z; }
+		TransformOrigin   transform_origin_x()         const { return LengthPercentage(rare->transform_origin_x_type, rare->transform_origin_x); }
+		TransformOrigin   transform_origin_y()         const { return LengthPercentage(rare->transform_origin_y_type, rare->transform_origin_y); }
+		float             transform_origin_z()         const { return rare->transform_origin_z; }
 		AlignContent      align_content()              const { return GetLocalPropertyKeyword(PropertyId::AlignContent, AlignContent::Stretch); }
 		AlignItems        align_items()                const { return GetLocalPropertyKeyword(PropertyId::AlignItems, AlignItems::Stretch); }
 		AlignSelf         align_self()                 const { return GetLocalPropertyKeyword(PropertyId::AlignSelf, AlignSelf::Auto); }
@@ -276,19 +338,20 @@ namespace Style {
 		JustifyContent    justify_content()            const { return GetLocalPropertyKeyword(PropertyId::JustifyContent, JustifyContent::FlexStart); }
 		float             flex_grow()                  const { return GetLocalProperty(PropertyId::FlexGrow, 0.f); }
 		float             flex_shrink()                const { return GetLocalProperty(PropertyId::FlexShrink, 1.f); }
-		FlexBasis         flex_basis()                 const { return LengthPercentageAuto(rare.flex_basis_type, rare.flex_basis); }
-		float             border_top_left_radius()     const { return (float)rare.border_top_left_radius; }
-		float             border_top_right_radius()    const { return (float)rare.border_top_right_radius; }
-		float             border_bottom_right_radius() const { return (float)rare.border_bottom_right_radius; }
-		float             border_bottom_left_radius()  const { return (float)rare.border_bottom_left_radius; }
-		Clip              clip()                       const { return rare.clip; }
-		Drag              drag()                       const { return rare.drag; }
-		TabIndex          tab_index()                  const { return rare.tab_index; }
-		Colourb           image_color()                const { return rare.image_color; }
-		LengthPercentage  row_gap()                    const { return LengthPercentage(rare.row_gap_type, rare.row_gap); }
-		LengthPercentage  column_gap()                 const { return LengthPercentage(rare.column_gap_type, rare.column_gap); }
-		OverscrollBehavior overscroll_behavior()       const { return rare.overscroll_behavior; }
-		float             scrollbar_margin()           const { return rare.scrollbar_margin; }
+		FlexBasis         flex_basis()                 const { return LengthPercentageAuto(rare->flex_basis_type, rare->flex_basis); }
+		float             border_top_left_radius()     const { return (float)rare->border_top_left_radius; }
+		float             border_top_right_radius()    const { return (float)rare->border_top_right_radius; }
+		float             border_bottom_right_radius() const { return (float)rare->border_bottom_right_radius; }
+		float             border_bottom_left_radius()  const { return (float)rare->border_bottom_left_radius; }
+		Clip              clip()                       const { return rare->clip; }
+		Drag              drag()                       const { return rare->drag; }
+		TabIndex          tab_index()                  const { return rare->tab_index; }
+		Colourb           image_color()                const { return rare->image_color; }
+		LengthPercentage  row_gap()                    const { return LengthPercentage(rare->row_gap_type, rare->row_gap); }
+		LengthPercentage  column_gap()                 const { return LengthPercentage(rare->column_gap_type, rare->column_gap); }
+		OverscrollBehavior overscroll_behavior()       const { return rare->overscroll_behavior; }
+		Contain           contain()                    const { return rare->contain; }
+		float             scrollbar_margin()           const { return rare->scrollbar_margin; }
 		
 		// -- Assignment --
 		// Common
@@ -326,50 +389,52 @@ namespace Style {
 		void border_left_color  (Colourb value)              { common.border_left_color   = value; }
 		void has_decorator      (bool value)                 { common.has_decorator       = value; }
 		// Inherited
-		void font_face_handle(FontFaceHandle value) { inherited.font_face_handle = value; }
-		void font_size       (float value)          { inherited.font_size        = value; }
-		void has_font_effect (bool value)           { inherited.has_font_effect  = value; }
-		void font_style      (FontStyle value)      { inherited.font_style       = value; }
-		void font_weight     (FontWeight value)     { inherited.font_weight      = value; }
-		void pointer_events  (PointerEvents value)  { inherited.pointer_events   = value; }
-		void focus           (Focus value)          { inherited.focus            = value; }
-		void text_align      (TextAlign value)      { inherited.text_align       = value; }
-		void text_decoration (TextDecoration value) { inherited.text_decoration  = value; }
-		void text_transform  (TextTransform value)  { inherited.text_transform   = value; }
-		void white_space     (WhiteSpace value)     { inherited.white_space      = value; }
-		void word_break      (WordBreak value)      { inherited.word_break       = value; }
-		void color           (Colourb value)        { inherited.color            = value; }
-		void opacity         (float value)          { inherited.opacity          = value; }
-		void line_height     (LineHeight value)     { inherited.line_height = value.value; inherited.line_height_inherit_type = value.inherit_type; inherited.line_height_inherit = value.inherit_value;  }
+		void font_face_handle(FontFaceHandle value) { if (value != inherited->font_face_handle) inherited.Write().font_face_handle = value; }
+		void font_size       (float value)          { if (value != inherited->font_size) inherited.Write().font_size = value; }
+		void has_font_effect (bool value)           { if (value != inherited->has_font_effect) inherited.Write().has_font_effect = value; }
+		void font_style      (FontStyle value)      { if (value != inherited->font_style) inherited.Write().font_style = value; }
+		void font_weight     (FontWeight value)     { if (value != inherited->font_weight) inherited.Write().font_weight = value; }
+		void pointer_events  (PointerEvents value)  { if (value != inherited->pointer_events) inherited.Write().pointer_events = value; }
+		void focus           (Focus value)          { if (value != inherited->focus) inherited.Write().focus = value; }
+		void text_align      (TextAlign value)      { if (value != inherited->text_align) inherited.Write().text_align = value; }
+		void text_decoration (TextDecoration value) { if (value != inherited->text_decoration) inherited.Write().text_decoration = value; }
+		void text_transform  (TextTransform value)  { if (value != inherited->text_transform) inherited.Write().text_transform = value; }
+		void white_space     (WhiteSpace value)     { if (value != inherited->white_space) inherited.Write().white_space = value; }
+		void word_break      (WordBreak value)      { if (value != inherited->word_break) inherited.Write().word_break = value; }
+		void color           (Colourb value)        { if (value != inherited->color) inherited.Write().color = value; }
+		void opacity         (float value)          { if (value != inherited->opacity) inherited.Write().opacity = value; }
+		void line_height     (LineHeight value)     { if (value.value != inherited->line_height || value.inherit_type != inherited->line_height_inherit_type || value.inherit_value != inherited->line_height_inherit) { InheritedValues& v = inherited.Write(); v.line_height = value.value; v.line_height_inherit_type = value.inherit_type; v.line_height_inherit = value.inherit_value; } }
 		// Rare
-		void min_width                 (MinWidth value)          { rare.min_width_type             = value.type; rare.min_width                  = value.value; }
-		void max_width                 (MaxWidth value)          { rare.max_width_type             = value.type; rare.max_width                  = value.value; }
-		void min_height                (MinHeight value)         { rare.min_height_type            = value.type; rare.min_height                 = value.value; }
-		void max_height                (MaxHeight value)         { rare.max_height_type            = value.type; rare.max_height                 = value.value; }
-		void vertical_align            (VerticalAlign value)     { rare.vertical_align_type        = value.type; rare.vertical_align_length      = value.value; }
-		void perspective_origin_x      (PerspectiveOrigin value) { rare.perspective_origin_x_type  = value.type; rare.perspective_origin_x       = value.value; }
-		void perspective_origin_y      (PerspectiveOrigin value) { rare.perspective_origin_y_type  = value.type; rare.perspective_origin_y       = value.value; }
-		void transform_origin_x        (TransformOrigin value)   { rare.transform_origin_x_type    = value.type; rare.transform_origin_x         = value.value; }
-		void transform_origin_y        (TransformOrigin value)   { rare.transform_origin_y_type    = value.type; rare.transform_origin_y         = value.value; }
-		void row_gap                   (LengthPercentage value)  { rare.row_gap_type               = value.type; rare.row_gap                    = value.value; }
-		void column_gap                (LengthPercentage value)  { rare.column_gap_type            = value.type; rare.column_gap                 = value.value; }
-		void flex_basis                (FlexBasis value)         { rare.flex_basis_type            = value.type; rare.flex_basis                 = value.value; }
-		void transform_origin_z        (float value)             { rare.transform_origin_z         = value; }
-		void perspective               (float value)             { rare.perspective                = value; }
-		void border_top_left_radius    (float value)             { rare.border_top_left_radius     = (int16_t)value; }
-		void border_top_right_radius   (float value)             { rare.border_top_right_radius    = (int16_t)value; }
-		void border_bottom_right_radius(float value)             { rare.border_bottom_right_radius = (int16_t)value; }
-		void border_bottom_left_radius (float value)             { rare.border_bottom_left_radius  = (int16_t)value; }
-		void clip                      (Clip value)              { rare.clip                       = value; }
-		void drag                      (Drag value)              { rare.drag                       = value; }
-		void tab_index                 (TabIndex value)          { rare.tab_index                  = value; }
-		void image_color               (Colourb value)           { rare.image_color                = value; }
-		void overscroll_behavior       (OverscrollBehavior value){ rare.overscroll_behavior        = value; }
-		void scrollbar_margin          (float value)             { rare.scrollbar_margin           = value; }
+		void min_width                 (MinWidth value)          { if (value.type != rare->min_width_type || value.value != rare->min_width) { RareValues& v = rare.Write(); v.min_width_type = value.type; v.min_width = value.value; } }
+		void max_width                 (MaxWidth value)          { if (value.type != rare->max_width_type || value.value != rare->max_width) { RareValues& v = rare.Write(); v.max_width_type = value.type; v.max_width = value.value; } }
+		void min_height                (MinHeight value)         { if (value.type != rare->min_height_type || value.value != rare->min_height) { RareValues& v = rare.Write(); v.min_height_type = value.type; v.min_height = value.value; } }
+		void max_height                (MaxHeight value)         { if (value.type != rare->max_height_type || value.value != rare->max_height) { RareValues& v = rare.Write(); v.max_height_type = value.type; v.max_height = value.value; } }
+		void vertical_align            (VerticalAlign value)     { if (value.type != rare->vertical_align_type || value.value != rare->vertical_align_length) { RareValues& v = rare.Write(); v.vertical_align_type = value.type; v.vertical_align_length = value.value; } }
+		void perspective_origin_x      (PerspectiveOrigin value) { if (value.type != rare->perspective_origin_x_type || value.value != rare->perspective_origin_x) { RareValues& v = rare.Write(); v.perspective_origin_x_type = value.type; v.perspective_origin_x = value.value; } }
+		void perspective_origin_y      (PerspectiveOrigin value) { if (value.type != rare->perspective_origin_y_type || value.value != rare->perspective_origin_y) { RareValues& v = rare.Write(); v.perspective_origin_y_type = value.type; v.perspective_origin_y = value.value; } }
+		void transform_origin_x        (TransformOrigin value)   { if (value.type != rare->transform_origin_x_type || value.value != rare->transform_origin_x) { RareValues& v = rare.Write(); v.transform_origin_x_type = value.type; v.transform_origin_x = value.value; } }
+		void transform_origin_y        (TransformOrigin value)   { if (value.type != rare->transform_origin_y_type || value.value != rare->transform_origin_y) { RareValues& v = rare.Write(); v.transform_origin_y_type = value.type; v.transform_origin_y = value.value; } }
+		void row_gap                   (LengthPercentage value)  { if (value.type != rare->row_gap_type || value.value != rare->row_gap) { RareValues& v = rare.Write(); v.row_gap_type = value.type; v.row_gap = value.value; } }
+		void column_gap                (LengthPercentage value)  { if (value.type != rare->column_gap_type || value.value != rare->column_gap) { RareValues& v = rare.Write(); v.column_gap_type = value.type; v.column_gap = value.value; } }
+		void flex_basis                (FlexBasis value)         { if (value.type != rare->flex_basis_type || value.value != rare->flex_basis) { RareValues& v = rare.Write(); v.flex_basis_type = value.type; v.flex_basis = value.value; } }
+		void transform_origin_z        (float value)             { if (value != rare->transform_origin_z) rare.Write().transform_origin_z = value; }
+		void perspective               (float value)             { if (value != rare->perspective) rare.Write().perspective = value; }
+		void border_top_left_radius    (float value)             { if ((int16_t)value != rare->border_top_left_radius) rare.Write().border_top_left_radius = (int16_t)value; }
+		void border_top_right_radius   (float value)             { if ((int16_t)value != rare->border_top_right_radius) rare.Write().border_top_right_radius = (int16_t)value; }
+		void border_bottom_right_radius(float value)             { if ((int16_t)value != rare->border_bottom_right_radius) rare.Write().border_bottom_right_radius = (int16_t)value; }
+		void border_bottom_left_radius (float value)             { if ((int16_t)value != rare->border_bottom_left_radius) rare.Write().border_bottom_left_radius = (int16_t)value; }
+		void clip                      (Clip value)              { if (value != rare->clip) rare.Write().clip = value; }
+		void drag                      (Drag value)              { if (value != rare->drag) rare.Write().drag = value; }
+		void tab_index                 (TabIndex value)          { if (value != rare->tab_index) rare.Write().tab_index = value; }
+		void image_color               (Colourb value)           { if (value != rare->image_color) rare.Write().image_color = value; }
+		void overscroll_behavior       (OverscrollBehavior value){ if (value != rare->overscroll_behavior) rare.Write().overscroll_behavior = value; }
+		void contain                   (Contain value)           { if (value != rare->contain) rare.Write().contain = value; }
+		void scrollbar_margin          (float value)             { if (value != rare->scrollbar_margin) rare.Write().scrollbar_margin = value; }
 
 		// clang-format on
 
 		// -- Management --
+		// The inherited and rare values are shared with the source until they are modified.
 		void CopyNonInherited(const ComputedValues& other)
 		{
 			common = other.common;
@@ -377,6 +442,9 @@ namespace Style {
 		}
 		void CopyInherited(const ComputedValues& parent) { inherited = parent.inherited; }
 
+		/// Returns true if the inherited values are shared with the given values, such as those of the parent element.
+		bool SharesInheritedWith(const ComputedValues& other) const { return inherited.IsSharedWith(other.inherited); }
+
 	private:
 		template <typename T>
 		inline T GetLocalPropertyKeyword(PropertyId id, T default_value) const
@@ -395,9 +463,10 @@ namespace Style {
 
 		Element* element = nullptr;
 
+		// The common values are set on most elements and are stored in place, the others are shared when possible.
 		CommonValues common;
-		InheritedValues inherited;
-		RareValues rare;
+		CopyOnWrite<InheritedValues> inherited;
+		CopyOnWrite<RareValues> rare;
 	};
 
 } // namespace Style
@@ -47,8 +47,23 @@ class DataModel;
 class DataModelConstructor;
 class DataTypeRegister;
 class ScrollController;
+class WorkerPool;
 enum class EventId : uint16_t;
 
+/**
+	Counters for the layouts performed during the last call to Context::Update().
+ */
+struct LayoutStats {
+	// Number of documents formatted in full.
+	int full_layouts = 0;
+	// Number of layout boundaries formatted on their own, see 'contain: layout'.
+	int boundary_layouts = 0;
+	// Number of elements formatted within their parent's formatting context, by either kind of layout.
+	int formatted_elements = 0;
+	// Largest number of bytes used for layout boxes during a single layout.
+	int layout_arena_bytes = 0;
+};
+
 /**
 	A context for storing, rendering and processing RML documents. Multiple contexts can exist simultaneously.
 
@@ -239,6 +254,16 @@ public:
 	/// @param[in] speed_factor A factor for adjusting the final smooth scrolling speed, must be strictly positive, defaults to 1.0.
 	void SetDefaultScrollBehavior(ScrollBehavior scroll_behavior, float speed_factor);
 
+	/// Sets the number of threads used to match element definitions during Update(), including the calling thread.
+	/// @param[in] num_threads The number of threads, a value of one or less matches all definitions on the calling thread.
+	/// @note Only definition matching is parallelized, computed values, events and property change notifications are still processed serially.
+	void SetStyleThreadCount(int num_threads);
+	/// Returns the number of threads used to match element definitions during Update().
+	int GetStyleThreadCount() const;
+
+	/// Returns the layouts performed during the last call to Update().
+	const LayoutStats& GetLayoutStats() const;
+
 	/// Gets the context's render interface.
 	/// @return The render interface the context renders through.
 	RenderInterface* GetRenderInterface() const;
@@ -295,6 +320,15 @@ public:
 	/// @return Time until next update is expected.
 	double GetNextUpdateDelay() const;
 
+	/// Marks the context as changed since it was last rendered. This is called internally whenever the style, layout
+	/// or position of an element is dirtied. Applications may call it after changing state that RmlUi can't observe.
+	void DirtyRender();
+
+	/// Returns true if anything changed since the last call to Render(), including data model variables pending an
+	/// update. Together with GetNextUpdateDelay(), this allows skipping both Update and Render while the interface is idle.
+	/// @return True if the context should be updated and rendered again.
+	bool IsRenderDirty() const;
+
 protected:
 	void Release() override;
 
@@ -379,6 +413,17 @@ private:
 	// See RequestNextUpdate() and NextUpdateRequested() for details.
 	double next_update_timeout;
 
+	// Set whenever an element is dirtied, cleared when rendering. See DirtyRender().
+	bool render_dirty;
+
+	// Threads for matching element definitions in parallel, null when matching on the calling thread only.
+	UniquePtr<WorkerPool> style_worker_pool;
+	// Elements whose definitions are matched in parallel during the current update, kept to reuse its allocation.
+	ElementList prepared_definition_elements;
+
+	// Layouts performed during the last update.
+	LayoutStats layout_stats;
+
 	// Internal callback for when an element is detached or removed from the hierarchy.
 	void OnElementDetach(Element* element);
 	// Internal callback for when a new element gains focus.
@@ -414,6 +459,11 @@ private:
 	// Releases all unloaded documents pending destruction.
 	void ReleaseUnloadedDocuments();
 
+	// Matches the definitions of all elements that will have their definition updated during this update, in parallel on the style workers.
+	void PrepareDefinitions();
+	// Collects the elements whose definitions are dirty, following the same propagation rules as Element::UpdateDefinition().
+	static void CollectDirtyDefinitions(Element* element, bool parent_dirty, ElementList& elements);
+
 	// Sends the specified event to all elements in new_items that don't appear in old_items.
 	static void SendEvents(const ElementSet& old_items, const ElementSet& new_items, EventId id, const Dictionary& parameters);
 
@@ -45,6 +45,16 @@ class SystemInterface;
 enum class DefaultActionPhase;
 
 
+/// Counters of the selector matching performed while resolving element definitions.
+struct SelectorMatchStats {
+	// Selectors rejected by the ancestor filter, without walking the element hierarchy.
+	uint64_t ancestor_filter_rejects = 0;
+	// Selectors that had to be matched against the element hierarchy.
+	uint64_t hierarchy_walks = 0;
+	// Selectors that fully matched an element.
+	uint64_t matches = 0;
+};
+
 /**
 	RmlUi library core API.
 
@@ -156,12 +166,35 @@ RMLUICORE_API StringList GetTextureSourceList();
 /// Forces all texture handles loaded and generated by RmlUi to be released.
 /// @param[in] render_interface Release all textures belonging to the given interface, or nullptr to release all textures in all interfaces.
 RMLUICORE_API void ReleaseTextures(RenderInterface* render_interface = nullptr);
+/// Forces the texture with the given source to be reloaded through a render interface, and regenerates the images and
+/// decorators displaying it. This allows render interfaces to replace placeholders of textures loaded asynchronously.
+/// @param[in] source The source of the texture, as passed to RenderInterface::LoadTexture().
+/// @param[in] render_interface The render interface the texture was loaded through.
+/// @return True if the texture was loaded through the render interface, otherwise false.
+RMLUICORE_API bool ReloadTexture(const String& source, RenderInterface* render_interface);
 /// Forces all compiled geometry handles generated by RmlUi to be released.
 RMLUICORE_API void ReleaseCompiledGeometry();
 /// Releases unused font textures and rendered glyphs to free up memory, and regenerates actively used fonts.
 /// @note Invalidates all existing FontFaceHandles returned from the font engine.
 RMLUICORE_API void ReleaseFontResources();
 
+/// Serialises the glyph bitmaps and metrics rasterised so far, to be restored with LoadFontGlyphCache() on a later run.
+/// @param[out] data The serialised glyphs, keyed by the contents of their font face and their size.
+/// @return True on success, false if the default font engine is not in use.
+/// @note Only supported by the default font engine.
+RMLUICORE_API bool SaveFontGlyphCache(Vector<byte>& data);
+/// Restores glyphs saved with SaveFontGlyphCache(). Font faces used afterwards at a cached size take their glyphs and
+/// metrics from the cache instead of rasterising them.
+/// @param[in] data The serialised glyphs.
+/// @param[in] data_size The size of the data in bytes.
+/// @return True if the data was restored, false if it is invalid or the default font engine is not in use.
+RMLUICORE_API bool LoadFontGlyphCache(const byte* data, size_t data_size);
+
+/// Returns the selector matching counters accumulated since initialisation or the last call to ResetSelectorMatchStats().
+RMLUICORE_API SelectorMatchStats GetSelectorMatchStats();
+/// Resets the selector matching counters.
+RMLUICORE_API void ResetSelectorMatchStats();
+
 /// Forces all memory pools used by RmlUi to be released.
 RMLUICORE_API void ReleaseMemoryPools();
 
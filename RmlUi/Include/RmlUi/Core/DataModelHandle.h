@@ -46,7 +46,12 @@ public:
 	DataModelHandle(DataModel* model = nullptr);
 
 	bool IsVariableDirty(const String& variable_name);
-	void DirtyVariable(const String& variable_name);
+	// Dirty a variable by its name, or only part of it by its path such as "players[12].hp". When dirtying part of a variable,
+	// only the views depending on that part, or on the variable as a whole, are updated.
+	void DirtyVariable(const String& variable_path);
+	// Dirty a single element of an array variable, such as ("players", 12). Optionally, only a member of the element.
+	// Adding or removing elements still requires DirtyVariable() on the array itself, as views such as 'data-for' depend on its size.
+	void DirtyArrayElement(const String& array_path, int index, const String& member_path = String());
 	void DirtyAllVariables();
 
 	explicit operator bool() { return model; }
@@ -64,6 +64,7 @@ struct DataAddressEntry {
 	int index;
 };
 using DataAddress = Vector<DataAddressEntry>;
+using DirtyAddresses = Vector<DataAddress>;
 
 template<class T>
 struct PointerTraits {
@@ -59,6 +59,7 @@ public:
 	int Size();
 	DataVariable Child(const DataAddressEntry& address);
 	DataVariableType Type();
+	bool HasStableChildren();
 
 private:
 	VariableDefinition* definition = nullptr;
@@ -83,6 +84,9 @@ public:
 	virtual int Size(void* ptr);
 	virtual DataVariable Child(void* ptr, const DataAddressEntry& address);
 
+	// Returns true if the children returned by Child() remain valid for as long as the pointer itself, so that they can be cached.
+	virtual bool HasStableChildren() const { return false; }
+
 protected:
 	VariableDefinition(DataVariableType type) : type(type) {}
 
@@ -155,6 +159,7 @@ public:
 	StructDefinition();
 
 	DataVariable Child(void* ptr, const DataAddressEntry& address) override;
+	bool HasStableChildren() const override { return true; }
 
 	void AddMember(const String& name, UniquePtr<VariableDefinition> member);
 
@@ -66,6 +66,13 @@ public:
 	/// @param[in] element_data The handle to the data generated by the decorator for the element.
 	virtual void RenderElement(Element* element, DecoratorDataHandle element_data) const = 0;
 
+	/// Get number of textures in use by the decorator.
+	int GetNumTextures() const;
+	/// Returns one of the decorator's previously loaded textures.
+	/// @param[in] index The index of the desired texture.
+	/// @return The texture at the appropriate index, or nullptr if the index was invalid.
+	const Texture* GetTexture(int index = 0) const;
+
 	/// Value specifying an invalid or non-existent Decorator data handle.
 	static const DecoratorDataHandle INVALID_DECORATORDATAHANDLE = 0;
 
@@ -74,12 +81,6 @@ protected:
 	/// @param[in] texture The texture to add.
 	/// @return The index of the texture if it is successful, or -1 if it is invalid.
 	int AddTexture(const Texture& texture);
-	/// Get number of textures in use by the decorator.
-	int GetNumTextures() const;
-	/// Returns one of the decorator's previously loaded textures.
-	/// @param[in] index The index of the desired texture.
-	/// @return The texture at the appropriate index, or nullptr if the index was invalid.
-	const Texture* GetTexture(int index = 0) const;
 
 private:
 	// Stores a list of textures in use by this decorator.
@@ -46,6 +46,7 @@ namespace Rml {
 
 class Context;
 class DataModel;
+class DataViewFor;
 class Decorator;
 class ElementInstancer;
 class EventDispatcher;
@@ -55,6 +56,9 @@ class ElementDefinition;
 class ElementDocument;
 class ElementScroll;
 class ElementStyle;
+class HitTestIndex;
+class LayoutCache;
+class LayoutDetails;
 class LayoutEngine;
 class LayoutInlineBox;
 class LayoutBlockBox;
@@ -619,6 +623,9 @@ protected:
 	virtual void OnDpRatioChange();
 	/// Called when the current document's compiled style sheet has been changed. This may result in changed sprites.
 	virtual void OnStyleSheetChange();
+	/// Called when a texture was reloaded through the render interface, see Rml::ReloadTexture().
+	/// @param[in] source The source of the reloaded texture.
+	virtual void OnTextureReload(const String& source);
 
 	/// Called when attributes on the element are changed.
 	/// @param[in] changed_attributes Dictionary of attributes changed on the element. Attribute value will be empty if it was unset.
@@ -667,24 +674,32 @@ private:
 	void SetParent(Element* parent);
 	
 	void SetDataModel(DataModel* new_data_model);
+	// Moves a DOM child to before the adjacent child, or to the end of the DOM children if adjacent is null, without detaching it.
+	bool MoveChildBefore(Element* child, Element* adjacent_element);
 
 	void DirtyAbsoluteOffset();
 	void DirtyAbsoluteOffsetRecursive();
 	void UpdateOffset();
 	void SetBaseline(float baseline);
+	// Returns the cached layout results of this element, created on first use.
+	LayoutCache& GetLayoutCache();
 
 	void BuildLocalStackingContext();
 	void BuildStackingContext(ElementList* stacking_context);
 	static void BuildStackingContextForTable(Vector<StackingOrderedChild>& ordered_children, Element* child);
 	void DirtyStackingContext();
+	void DirtyHitTestIndex();
 
-	void UpdateDefinition();
+	void UpdateDefinition(Element* sibling = nullptr);
+	// Returns the preceding sibling if we are the child at the given index of our parent, and the sibling's style is up to date.
+	Element* GetStyleSharingSibling(size_t index) const;
 
 	void DirtyTransformState(bool perspective_dirty, bool transform_dirty);
 	void UpdateTransformState();
 
 	void OnDpRatioChangeRecursive();
 	void DirtyFontFaceRecursive();
+	void DirtyTexture(const String& source);
 
 	/// Start an animation, replacing any existing animations of the same property name. If start_value is null, the element's current value is used.
 	ElementAnimationList::iterator StartAnimation(PropertyId property_id, const Property * start_value, int num_iterations, bool alternate_direction, float delay, bool initiated_by_animation_property);
@@ -782,17 +797,25 @@ private:
 	
 	UniquePtr< TransformState > transform_state;
 
+	// Results from formatting this element, cleared whenever its layout is dirtied.
+	UniquePtr< LayoutCache > layout_cache;
+
 	ElementAnimationList animations;
 
 	ElementMeta* meta;
 
 	friend class Rml::Context;
+	friend class Rml::DataViewFor;
+	friend class Rml::ElementDocument;
 	friend class Rml::ElementStyle;
+	friend class Rml::HitTestIndex;
+	friend class Rml::LayoutDetails;
 	friend class Rml::LayoutEngine;
 	friend class Rml::LayoutBlockBox;
 	friend class Rml::LayoutInlineBox;
 	friend class Rml::ElementScroll;
 	friend RMLUICORE_API void Rml::ReleaseFontResources();
+	friend RMLUICORE_API bool Rml::ReloadTexture(const String& source, RenderInterface* render_interface);
 };
 
 } // namespace Rml
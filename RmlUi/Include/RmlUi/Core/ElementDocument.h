@@ -37,8 +37,10 @@ class Context;
 class Stream;
 class DocumentHeader;
 class ElementText;
+class HitTestIndex;
 class StyleSheet;
 class StyleSheetContainer;
+struct LayoutStats;
 
 /**
 	 ModalFlag used for controlling the modal state of the document.
@@ -167,14 +169,33 @@ private:
 	/// Updates all sizes defined by the 'vw' and the 'vh' units.
 	void DirtyVwAndVhProperties();
 
+	/// Marks the contents of a layout boundary as needing a re-layout, without dirtying the layout of the rest of the document.
+	void DirtyLayoutBoundary(Element* boundary);
+
 	/// Updates the layout if necessary.
-	void UpdateLayout();
+	/// @param[in,out] stats If set, the layouts performed are added to these statistics.
+	void UpdateLayout(LayoutStats* stats = nullptr);
+	/// Formats each dirty layout boundary on its own.
+	/// @return False if the layout outside of any of the boundaries was affected, then the document must be formatted in full.
+	bool FormatDirtyLayoutBoundaries(LayoutStats* stats);
+
+	/// Marks the spatial index for finding elements under a point as outdated.
+	void DirtyHitTestIndex();
+	/// Returns the topmost element of this document under the point, see Context::GetElementAtPoint().
+	Element* FindElementAtPoint(Vector2f point, const Element* ignore_element);
 
 	/// Updates the position of the document based on the style properties.
 	void UpdatePosition();
 	/// Sets the dirty flag for document positioning
 	void DirtyPosition();
 
+	/// Registers an element of this document under its current id.
+	void AddToIdIndex(Element* element);
+	/// Unregisters an element from its current id, before it leaves the document or its id changes.
+	void RemoveFromIdIndex(Element* element);
+	/// Looks up the element with the given id through the id index, returns the same element as a breadth-first search would.
+	Element* FindElementById(const String& id);
+
 	// Title of the document
 	String title;
 
@@ -192,8 +213,19 @@ private:
 	// Is the layout dirty?
 	bool layout_dirty;
 
+	// Layout boundaries whose contents need to be formatted again, only used while the layout of the document itself is clean.
+	Vector<ObserverPtr<Element>> dirty_layout_boundaries;
+
 	bool position_dirty;
 
+	// Spatial index of the elements in the document's stacking context, used for hit-testing.
+	UniquePtr<HitTestIndex> hit_test_index;
+
+	// Maps element ids to the elements carrying them, maintained as elements are attached, detached or change their id. Usually
+	// only a single element carries each id.
+	UnorderedMap<String, Vector<Element*>> id_index;
+
+	friend class Rml::Element;
 	friend class Rml::Context;
 	friend class Rml::Factory;
 
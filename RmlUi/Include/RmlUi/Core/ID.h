@@ -141,6 +141,7 @@ enum class PropertyId : uint8_t
 	TabIndex,
 	ScrollbarMargin,
 	OverscrollBehavior,
+	Contain,
 
 	Perspective,
 	PerspectiveOriginX,
@@ -102,6 +102,14 @@ public:
 	/// @param[in] source_dimensions The dimensions, in pixels, of the source data.
 	/// @return True if the texture generation succeeded and the handle is valid, false if not.
 	virtual bool GenerateTexture(TextureHandle& texture_handle, const byte* source, const Vector2i& source_dimensions);
+	/// Called by RmlUi when a region of a previously generated texture has changed, e.g. when glyphs are added to a font texture.
+	/// @param[in] texture_handle The handle of the generated texture.
+	/// @param[in] source The raw 8-bit texture data of the whole texture, in the same format as for GenerateTexture().
+	/// @param[in] source_dimensions The dimensions, in pixels, of the source data.
+	/// @param[in] region_offset The top-left pixel of the changed region.
+	/// @param[in] region_dimensions The dimensions, in pixels, of the changed region.
+	/// @return True if the texture was updated, false if the texture must be generated again instead.
+	virtual bool UpdateTexture(TextureHandle texture_handle, const byte* source, const Vector2i& source_dimensions, const Vector2i& region_offset, const Vector2i& region_dimensions);
 	/// Called by RmlUi when a loaded texture is no longer required.
 	/// @param texture The texture handle to release.
 	virtual void ReleaseTexture(TextureHandle texture);
@@ -33,6 +33,7 @@
 #include "Spritesheet.h"
 #include "StyleSheetTypes.h"
 #include "Traits.h"
+#include <mutex>
 
 namespace Rml {
 
@@ -80,7 +81,11 @@ public:
 	const Sprite* GetSprite(const String& name) const;
 
 	/// Returns the compiled element definition for a given element and its hierarchy.
-	SharedPtr<const ElementDefinition> GetElementDefinition(const Element* element) const;
+	/// @param[in] element The element to match.
+	/// @param[out] out_sibling_shareable If set, receives true when the definition only depends on the element's tag, id, classes, pseudo-classes
+	///		and ancestors, so that it also applies to any sibling with the same names and pseudo-classes.
+	/// @note May be called concurrently from multiple threads, as long as the element hierarchy is not modified meanwhile.
+	SharedPtr<const ElementDefinition> GetElementDefinition(const Element* element, bool* out_sibling_shareable = nullptr) const;
 
 	/// Returns a list of instanced decorators from the declarations. The instances are cached for faster future retrieval.
 	const DecoratorPtrList& InstanceDecorators(const DecoratorDeclarationList& declaration_list, const PropertySource* decorator_source) const;
@@ -113,6 +118,7 @@ private:
 	// Index of node sets to element definitions.
 	using ElementDefinitionCache = UnorderedMap<StyleSheetIndex::NodeList, SharedPtr<const ElementDefinition>>;
 	mutable ElementDefinitionCache node_cache;
+	mutable std::mutex node_cache_mutex;
 
 	// Cached decorator instances.
 	using DecoratorCache = UnorderedMap<String, Vector<SharedPtr<const Decorator>>>;
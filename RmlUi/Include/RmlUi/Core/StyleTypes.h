@@ -110,6 +110,8 @@ namespace Style {
 		int GetNumber() const { return value < 0 ? 0 : value; }
 		Type GetType() const { return value == 0 ? Type::Auto : (value == -1 ? Type::None : (value == -2 ? Type::Always : Type::Number)); }
 		bool operator==(Type type) const { return GetType() == type; }
+		bool operator==(const Clip& other) const { return value == other.value; }
+		bool operator!=(const Clip& other) const { return value != other.value; }
 	};
 
 	enum class Visibility : uint8_t { Visible, Hidden };
@@ -127,6 +129,7 @@ namespace Style {
 	enum class TabIndex : uint8_t { None, Auto };
 	enum class Focus : uint8_t { None, Auto };
 	enum class OverscrollBehavior : uint8_t { Auto, Contain };
+	enum class Contain : uint8_t { None, Layout };
 	enum class PointerEvents : uint8_t { None, Auto };
 
 	using PerspectiveOrigin = LengthPercentage;
@@ -78,6 +78,14 @@ public:
 	/// @return The texture's dimensions. This will be (0, 0) if the texture isn't loaded.
 	Vector2i GetDimensions(RenderInterface* render_interface) const;
 
+	/// Uploads a changed region of a texture set from a callback, for every render interface that has generated it.
+	/// Render interfaces that can't update the texture in-place release it, so it is generated again on next use.
+	/// @param[in] data The raw data of the whole texture, in the same format as returned by the callback.
+	/// @param[in] dimensions The dimensions of the whole texture.
+	/// @param[in] region_offset The top-left pixel of the changed region.
+	/// @param[in] region_dimensions The dimensions of the changed region.
+	void UpdateRegion(const byte* data, Vector2i dimensions, Vector2i region_offset, Vector2i region_dimensions);
+
 	/// Returns true if the texture points to the same underlying resource.
 	bool operator==(const Texture&) const;
 
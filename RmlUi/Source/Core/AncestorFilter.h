@@ -0,0 +1,87 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+#ifndef RMLUI_CORE_ANCESTORFILTER_H
+#define RMLUI_CORE_ANCESTORFILTER_H
+
+#include "../../Include/RmlUi/Core/Types.h"
+#include "Atom.h"
+
+namespace Rml {
+
+/**
+	A Bloom filter over interned names, used to summarize the tag, id and class names of an element's ancestors.
+
+	Selectors with descendant or child combinators can be rejected quickly when any of the names required from the ancestors is definitely
+	missing from the filter. False positives are possible, in which case the full hierarchy must still be matched.
+ */
+
+class AncestorFilter {
+public:
+	void Clear()
+	{
+		for (uint64_t& word : bits)
+			word = 0;
+	}
+
+	void Add(Atom atom)
+	{
+		const uint32_t hash = uint32_t(atom) * 0x9E3779B1u;
+		SetBit(hash >> 24);
+		SetBit((hash >> 16) & 0xFF);
+	}
+
+	bool IsEmpty() const
+	{
+		for (uint64_t word : bits)
+		{
+			if (word != 0)
+				return false;
+		}
+		return true;
+	}
+
+	/// Returns false if any of the names added to 'required' are definitely missing from this filter.
+	bool MayContainAll(const AncestorFilter& required) const
+	{
+		for (int i = 0; i < num_words; i++)
+		{
+			if ((bits[i] & required.bits[i]) != required.bits[i])
+				return false;
+		}
+		return true;
+	}
+
+private:
+	void SetBit(uint32_t index) { bits[index >> 6] |= (uint64_t(1) << (index & 63)); }
+
+	static constexpr int num_words = 4;
+	uint64_t bits[num_words] = {};
+};
+
+} // namespace Rml
+#endif
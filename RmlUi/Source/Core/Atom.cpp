@@ -0,0 +1,89 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+#include "Atom.h"
+#include <deque>
+
+namespace Rml {
+
+namespace {
+	struct AtomNameMap {
+		AtomNameMap()
+		{
+			// Reserve index zero for the invalid atom, it is not added to the reverse map so that no name can resolve to it.
+			names.emplace_back();
+		}
+
+		// Deque so that references to names stay valid as new atoms are added.
+		std::deque<String> names;
+		UnorderedMap<String, Atom> atoms;
+	};
+} // namespace
+
+static AtomNameMap& GetAtomNameMap()
+{
+	static AtomNameMap atom_name_map;
+	return atom_name_map;
+}
+
+Atom AtomTable::GetOrCreate(const String& name)
+{
+	if (name.empty())
+		return Atom::Invalid;
+
+	AtomNameMap& map = GetAtomNameMap();
+	auto result = map.atoms.emplace(name, static_cast<Atom>(map.names.size()));
+	if (result.second)
+		map.names.push_back(name);
+
+	return result.first->second;
+}
+
+Atom AtomTable::Find(const String& name)
+{
+	if (name.empty())
+		return Atom::Invalid;
+
+	const AtomNameMap& map = GetAtomNameMap();
+	auto it = map.atoms.find(name);
+	if (it == map.atoms.end())
+		return Atom::Invalid;
+
+	return it->second;
+}
+
+const String& AtomTable::GetName(Atom atom)
+{
+	const AtomNameMap& map = GetAtomNameMap();
+	const size_t index = static_cast<size_t>(atom);
+	if (index < map.names.size())
+		return map.names[index];
+
+	return map.names[0];
+}
+
+} // namespace Rml
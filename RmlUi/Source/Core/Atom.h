@@ -0,0 +1,57 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+#ifndef RMLUI_CORE_ATOM_H
+#define RMLUI_CORE_ATOM_H
+
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+/**
+	An atom is an integer handle to an interned name, such as a tag, id, class or pseudo-class name. Comparing and hashing atoms is much cheaper
+	than their strings, which makes them suitable for selector matching and the style sheet index.
+
+	Atoms are never released, thus their values stay valid for the lifetime of the application. New atoms should only be created from the main
+	thread, while looking up existing atoms is safe as long as no atoms are concurrently created.
+ */
+
+enum class Atom : uint32_t { Invalid = 0 };
+using AtomList = Vector<Atom>;
+
+namespace AtomTable {
+
+/// Returns the atom for the given name, creating it if necessary. The empty string always maps to the invalid atom.
+Atom GetOrCreate(const String& name);
+/// Returns the atom for the given name, or the invalid atom if the name has not yet been interned.
+Atom Find(const String& name);
+/// Returns the name of the given atom, or the empty string for the invalid atom.
+const String& GetName(Atom atom);
+
+} // namespace AtomTable
+} // namespace Rml
+#endif
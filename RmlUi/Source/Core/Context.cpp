@@ -39,11 +39,15 @@
 #include "../../Include/RmlUi/Core/StreamMemory.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
 #include "DataModel.h"
+#include "ElementStyle.h"
 #include "EventDispatcher.h"
+#include "HitTestIndex.h"
+#include "LayoutEngine.h"
 #include "PluginRegistry.h"
 #include "RmlUi/Core/Debug.h"
 #include "ScrollController.h"
 #include "StreamFile.h"
+#include "WorkerPool.h"
 #include <algorithm>
 #include <iterator>
 #include <limits>
@@ -55,7 +59,7 @@ static constexpr float DOUBLE_CLICK_TIME = 0.5f;    // [s]
 static constexpr float DOUBLE_CLICK_MAX_DIST = 3.f; // [dp]
 static constexpr float UNIT_SCROLL_LENGTH = 80.f;   // [dp]
 
-Context::Context(const String& name) : name(name), dimensions(0, 0), density_independent_pixel_ratio(1.0f), mouse_position(0, 0), clip_origin(-1, -1), clip_dimensions(-1, -1), next_update_timeout(0)
+Context::Context(const String& name) : name(name), dimensions(0, 0), density_independent_pixel_ratio(1.0f), mouse_position(0, 0), clip_origin(-1, -1), clip_dimensions(-1, -1), next_update_timeout(0), render_dirty(true)
 {
 	instancer = nullptr;
 
@@ -204,17 +208,27 @@ bool Context::Update()
 	root->dirty_definition = false;
 	root->dirty_child_definitions = false;
 
+	if (style_worker_pool)
+		PrepareDefinitions();
+
 	root->Update(density_independent_pixel_ratio, Vector2f(dimensions));
 
+	layout_stats = LayoutStats();
+	const uint64_t num_formatted_elements = LayoutEngine::GetNumFormattedElements();
+	LayoutEngine::ResetLayoutArenaHighWaterMark();
+
 	for (int i = 0; i < root->GetNumChildren(); ++i)
 	{
 		if (auto doc = root->GetChild(i)->GetOwnerDocument())
 		{
-			doc->UpdateLayout();
+			doc->UpdateLayout(&layout_stats);
 			doc->UpdatePosition();
 		}
 	}
 
+	layout_stats.formatted_elements = int(LayoutEngine::GetNumFormattedElements() - num_formatted_elements);
+	layout_stats.layout_arena_bytes = int(LayoutEngine::GetLayoutArenaHighWaterMark());
+
 	// Release any documents that were unloaded during the update.
 	ReleaseUnloadedDocuments();
 
@@ -230,6 +244,9 @@ bool Context::Render()
 	if (render_interface == nullptr)
 		return false;
 
+	// Cleared before rendering, so that anything dirtied while rendering is picked up by the next update.
+	render_dirty = false;
+
 	render_interface->context = this;
 	ElementUtilities::ApplyActiveClipRegion(this, render_interface);
 
@@ -893,6 +910,27 @@ void Context::SetDefaultScrollBehavior(ScrollBehavior scroll_behavior, float spe
 	scroll_controller->SetDefaultScrollBehavior(scroll_behavior, speed_factor);
 }
 
+void Context::SetStyleThreadCount(int num_threads)
+{
+	if (num_threads == GetStyleThreadCount())
+		return;
+
+	if (num_threads > 1)
+		style_worker_pool = MakeUnique<WorkerPool>(num_threads);
+	else
+		style_worker_pool.reset();
+}
+
+int Context::GetStyleThreadCount() const
+{
+	return style_worker_pool ? style_worker_pool->GetNumThreads() : 1;
+}
+
+const LayoutStats& Context::GetLayoutStats() const
+{
+	return layout_stats;
+}
+
 // Gets the context's render interface.
 RenderInterface* Context::GetRenderInterface() const
 {
@@ -1236,6 +1274,11 @@ Element* Context::GetElementAtPoint(Vector2f point, const Element* ignore_elemen
 	}
 
 
+	// Documents are searched through their spatial index, which covers the document's entire stacking context.
+	ElementDocument* document = element->GetOwnerDocument();
+	if (document == element)
+		return document->FindElementAtPoint(point, ignore_element);
+
 	// Check any elements within our stacking context. We want to return the lowest-down element
 	// that is under the cursor.
 	if (element->local_stacking_context)
@@ -1266,28 +1309,7 @@ Element* Context::GetElementAtPoint(Vector2f point, const Element* ignore_elemen
 		}
 	}
 
-	// Ignore elements whose pointer events are disabled.
-	if (element->GetComputedValues().pointer_events() == Style::PointerEvents::None)
-		return nullptr;
-
-	// Projection may fail if we have a singular transformation matrix.
-	bool projection_result = element->Project(point);
-
-	// Check if the point is actually within this element.
-	bool within_element = (projection_result && element->IsPointWithinElement(point));
-	if (within_element)
-	{
-		Vector2i clip_origin, clip_dimensions;
-		if (ElementUtilities::GetClippingRegion(clip_origin, clip_dimensions, element))
-		{
-			within_element = point.x >= clip_origin.x &&
-							 point.y >= clip_origin.y &&
-							 point.x <= (clip_origin.x + clip_dimensions.x) &&
-							 point.y <= (clip_origin.y + clip_dimensions.y);
-		}
-	}
-
-	if (within_element)
+	if (HitTestIndex::HitTest(element, point))
 		return element;
 
 	return nullptr;
@@ -1399,6 +1421,52 @@ void Context::GenerateDragEventParameters(Dictionary& parameters)
 	parameters["drag_element"] = (void*)drag;
 }
 
+void Context::PrepareDefinitions()
+{
+	RMLUI_ZoneScoped;
+
+	ElementList& elements = prepared_definition_elements;
+	elements.clear();
+	for (const ElementPtr& child : root->children)
+		CollectDirtyDefinitions(child.get(), false, elements);
+
+	// Below this amount the matching is cheaper than handing it over to the workers.
+	constexpr int min_parallel_elements = 128;
+	constexpr int elements_per_task = 32;
+
+	const int num_elements = (int)elements.size();
+	if (num_elements >= min_parallel_elements)
+	{
+		const int num_tasks = (num_elements + elements_per_task - 1) / elements_per_task;
+		style_worker_pool->ParallelFor(num_tasks, [&elements, num_elements](int task) {
+			const int end = Math::Min((task + 1) * elements_per_task, num_elements);
+			for (int i = task * elements_per_task; i < end; i++)
+			{
+				Element* element = elements[i];
+				if (const StyleSheet* style_sheet = element->GetStyleSheet())
+					element->GetStyle()->PrepareDefinition(style_sheet);
+			}
+		});
+	}
+
+	elements.clear();
+}
+
+void Context::CollectDirtyDefinitions(Element* element, bool parent_dirty, ElementList& elements)
+{
+	const bool dirty = (parent_dirty || element->dirty_definition);
+	if (dirty)
+	{
+		// Build the ancestor filter here, the workers must only read it.
+		element->GetStyle()->GetAncestorFilter();
+		elements.push_back(element);
+	}
+
+	const bool children_dirty = (dirty || element->dirty_child_definitions);
+	for (const ElementPtr& child : element->children)
+		CollectDirtyDefinitions(child.get(), children_dirty, elements);
+}
+
 // Releases all unloaded documents pending destruction.
 void Context::ReleaseUnloadedDocuments()
 {
@@ -1478,4 +1546,19 @@ double Context::GetNextUpdateDelay() const {
 	return next_update_timeout;
 }
 
+void Context::DirtyRender() {
+	render_dirty = true;
+}
+
+bool Context::IsRenderDirty() const {
+	if (render_dirty)
+		return true;
+	for (const auto& data_model : data_models)
+	{
+		if (data_model.second->HasDirtyVariables())
+			return true;
+	}
+	return false;
+}
+
 } // namespace Rml
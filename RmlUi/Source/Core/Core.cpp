@@ -43,6 +43,7 @@
 #include "GeometryDatabase.h"
 #include "PluginRegistry.h"
 #include "StyleSheetFactory.h"
+#include "StyleSheetNode.h"
 #include "StyleSheetParser.h"
 #include "TemplateCache.h"
 #include "TextureDatabase.h"
@@ -50,6 +51,7 @@
 
 #ifndef RMLUI_NO_FONT_INTERFACE_DEFAULT
 #include "FontEngineDefault/FontEngineInterfaceDefault.h"
+#include "FontEngineDefault/FontGlyphCache.h"
 #endif
 
 #ifdef RMLUI_ENABLE_LOTTIE_PLUGIN
@@ -375,11 +377,36 @@ void ReleaseTextures(RenderInterface* in_render_interface)
 	TextureDatabase::ReleaseTextures(in_render_interface);
 }
 
+bool ReloadTexture(const String& source, RenderInterface* in_render_interface)
+{
+	if (!TextureDatabase::ReleaseTexture(source, in_render_interface))
+		return false;
+
+	// Only the elements registered as users of the texture are visited.
+	for (Element* element : TextureDatabase::GetTextureUsers(source))
+	{
+		if (element->GetRenderInterface() == in_render_interface)
+			element->DirtyTexture(source);
+	}
+
+	return true;
+}
+
 void ReleaseCompiledGeometry()
 {
 	return GeometryDatabase::ReleaseAll();
 }
 
+SelectorMatchStats GetSelectorMatchStats()
+{
+	return StyleSheetNode::GetMatchStats();
+}
+
+void ResetSelectorMatchStats()
+{
+	StyleSheetNode::ResetMatchStats();
+}
+
 void ReleaseMemoryPools()
 {
 	if (observerPtrBlockPool && observerPtrBlockPool->GetNumAllocatedObjects() <= 0)
@@ -403,4 +430,28 @@ void ReleaseFontResources()
 	}
 }
 
+bool SaveFontGlyphCache(Vector<byte>& data)
+{
+#ifndef RMLUI_NO_FONT_INTERFACE_DEFAULT
+	if (font_interface && font_interface == default_font_interface.get())
+	{
+		FontGlyphCache::Save(data);
+		return true;
+	}
+#endif
+	(void)data;
+	return false;
+}
+
+bool LoadFontGlyphCache(const byte* data, size_t data_size)
+{
+#ifndef RMLUI_NO_FONT_INTERFACE_DEFAULT
+	if (font_interface && font_interface == default_font_interface.get())
+		return FontGlyphCache::Load(data, data_size);
+#endif
+	(void)data;
+	(void)data_size;
+	return false;
+}
+
 } // namespace Rml
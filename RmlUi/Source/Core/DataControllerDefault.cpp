@@ -83,7 +83,7 @@ void DataControllerValue::ProcessEvent(Event& event)
 
 		if (DataVariable variable = model->GetVariable(address))
 			if (variable.Set(value_to_set))
-				model->DirtyVariable(address.front().name);
+				model->DirtyAddress(address);
 	}
 }
 
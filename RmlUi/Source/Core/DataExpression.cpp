@@ -764,6 +764,123 @@ namespace Parse {
 
 } // </namespace Parse>
 
+static double ToNumber(const Variant& variant)
+{
+	switch (variant.GetType())
+	{
+	case Variant::DOUBLE: return variant.GetReference<double>();
+	case Variant::FLOAT:  return double(variant.GetReference<float>());
+	case Variant::INT:    return double(variant.GetReference<int>());
+	default: break;
+	}
+	return variant.Get<double>();
+}
+
+// Compares two values, or concatenates them for 'Add', as strings if any of them is a string.
+static bool CompareStrings(const Variant& v1, const Variant& v2)
+{
+	return v1.GetType() == Variant::STRING || v2.GetType() == Variant::STRING;
+}
+
+// Applies the binary operator to the registers, storing the result in R. Returns false if the instruction is not a binary operator.
+static bool ApplyBinaryOperator(const Instruction instruction, const Variant& L, Variant& R)
+{
+	const bool both_strings = (L.GetType() == Variant::STRING && R.GetType() == Variant::STRING);
+
+	switch (instruction)
+	{
+	case Instruction::Add:
+	{
+		if (both_strings)
+			R = Variant(L.GetReference<String>() + R.GetReference<String>());
+		else if (CompareStrings(L, R))
+			R = Variant(L.Get<String>() + R.Get<String>());
+		else
+			R = Variant(ToNumber(L) + ToNumber(R));
+	}
+	break;
+	case Instruction::Subtract:  R = Variant(ToNumber(L) - ToNumber(R));   break;
+	case Instruction::Multiply:  R = Variant(ToNumber(L) * ToNumber(R));   break;
+	case Instruction::Divide:    R = Variant(ToNumber(L) / ToNumber(R));   break;
+	case Instruction::And:       R = Variant(L.Get<bool>() && R.Get<bool>()); break;
+	case Instruction::Or:        R = Variant(L.Get<bool>() || R.Get<bool>()); break;
+	case Instruction::Less:      R = Variant(ToNumber(L) < ToNumber(R));   break;
+	case Instruction::LessEq:    R = Variant(ToNumber(L) <= ToNumber(R));  break;
+	case Instruction::Greater:   R = Variant(ToNumber(L) > ToNumber(R));   break;
+	case Instruction::GreaterEq: R = Variant(ToNumber(L) >= ToNumber(R));  break;
+	case Instruction::Equal:
+	case Instruction::NotEqual:
+	{
+		bool equal;
+		if (both_strings)
+			equal = (L.GetReference<String>() == R.GetReference<String>());
+		else if (CompareStrings(L, R))
+			equal = (L.Get<String>() == R.Get<String>());
+		else
+			equal = (ToNumber(L) == ToNumber(R));
+		R = Variant(instruction == Instruction::Equal ? equal : !equal);
+	}
+	break;
+	default:
+		return false;
+	}
+	return true;
+}
+
+/*
+	Folds operators whose operands are all literals into a single literal instruction. The parser emits the operands of binary
+	operators as '<lhs> Push <rhs> Pop(L) <op>', thus a literal on both sides can be evaluated ahead of time. Folding is repeated
+	until no more subexpressions can be reduced, so that nested constant subexpressions collapse completely.
+*/
+static void FoldConstants(Program& program)
+{
+	auto Is = [&program](size_t i, Instruction instruction) {
+		return i < program.size() && program[i].instruction == instruction;
+	};
+	auto IsPop = [&](size_t i, Register destination) {
+		return Is(i, Instruction::Pop) && Register(program[i].data.Get<int>(-1)) == destination;
+	};
+
+	bool folded = true;
+	while (folded)
+	{
+		folded = false;
+		for (size_t i = 0; i < program.size(); i++)
+		{
+			if (!Is(i, Instruction::Literal))
+				continue;
+
+			Variant result;
+			size_t length = 0;
+
+			if (Is(i + 1, Instruction::Not))
+			{
+				result = Variant(!program[i].data.Get<bool>());
+				length = 2;
+			}
+			else if (Is(i + 1, Instruction::Push) && Is(i + 2, Instruction::Literal) && IsPop(i + 3, Register::L) && i + 4 < program.size())
+			{
+				result = program[i + 2].data;
+				if (ApplyBinaryOperator(program[i + 4].instruction, program[i].data, result))
+					length = 5;
+			}
+			else if (Is(i + 1, Instruction::Push) && Is(i + 2, Instruction::Literal) && Is(i + 3, Instruction::Push) &&
+				Is(i + 4, Instruction::Literal) && IsPop(i + 5, Register::C) && IsPop(i + 6, Register::L) && Is(i + 7, Instruction::Ternary))
+			{
+				result = (program[i].data.Get<bool>() ? program[i + 2].data : program[i + 4].data);
+				length = 8;
+			}
+
+			if (length > 0)
+			{
+				program[i].data = std::move(result);
+				program.erase(program.begin() + i + 1, program.begin() + i + length);
+				folded = true;
+			}
+		}
+	}
+}
+
 static String DumpProgram(const Program& program)
 {
 	String str;
@@ -777,8 +894,8 @@ static String DumpProgram(const Program& program)
 
 class DataInterpreter {
 public:
-	DataInterpreter(const Program& program, const AddressList& addresses, DataExpressionInterface expression_interface)
-		: program(program), addresses(addresses), expression_interface(expression_interface) {}
+	DataInterpreter(const Program& program, const AddressList& addresses, HandleList& handles, DataExpressionInterface expression_interface)
+		: program(program), addresses(addresses), handles(handles), expression_interface(expression_interface) {}
 
 	bool Error(const String& message) const
 	{
@@ -823,14 +940,11 @@ private:
 
 	const Program& program;
 	const AddressList& addresses;
+	HandleList& handles;
 	DataExpressionInterface expression_interface;
 
 	bool Execute(const Instruction instruction, const Variant& data)
 	{
-		auto AnyString = [](const Variant& v1, const Variant& v2) {
-			return v1.GetType() == Variant::STRING || v2.GetType() == Variant::STRING;
-		};
-
 		switch (instruction)
 		{
 		case Instruction::Push:
@@ -845,13 +959,16 @@ private:
 				return Error("Cannot pop stack, it is empty.");
 
 			Register reg = Register(data.Get<int>(-1));
+			Variant* destination = nullptr;
 			switch (reg) {
-			case Register::R:  R = stack.back(); stack.pop_back(); break;
-			case Register::L:  L = stack.back(); stack.pop_back(); break;
-			case Register::C:  C = stack.back(); stack.pop_back(); break;
+			case Register::R:  destination = &R; break;
+			case Register::L:  destination = &L; break;
+			case Register::C:  destination = &C; break;
 			default:
 				return Error(CreateString(50, "Invalid register %d.", int(reg)));
 			}
+			*destination = std::move(stack.back());
+			stack.pop_back();
 		}
 		break;
 		case Instruction::Literal:
@@ -862,46 +979,28 @@ private:
 		case Instruction::Variable:
 		{
 			size_t variable_index = size_t(data.Get<int>(-1));
-			if (variable_index < addresses.size())
-				R = expression_interface.GetValue(addresses[variable_index]);
-			else
+			if (variable_index >= addresses.size())
 				return Error("Variable address not found.");
+			R = expression_interface.GetValue(addresses[variable_index], handles[variable_index]);
 		}
 		break;
 		case Instruction::Add:
-		{
-			if (AnyString(L, R))
-				R = Variant(L.Get<String>() + R.Get<String>());
-			else
-				R = Variant(L.Get<double>() + R.Get<double>());
-		}
-		break;
-		case Instruction::Subtract:  R = Variant(L.Get<double>() - R.Get<double>());  break;
-		case Instruction::Multiply:  R = Variant(L.Get<double>() * R.Get<double>());  break;
-		case Instruction::Divide:    R = Variant(L.Get<double>() / R.Get<double>());  break;
-		case Instruction::Not:       R = Variant(!R.Get<bool>());                     break;
-		case Instruction::And:       R = Variant(L.Get<bool>() && R.Get<bool>());     break;
-		case Instruction::Or:        R = Variant(L.Get<bool>() || R.Get<bool>());     break;
-		case Instruction::Less:      R = Variant(L.Get<double>() < R.Get<double>());  break;
-		case Instruction::LessEq:    R = Variant(L.Get<double>() <= R.Get<double>()); break;
-		case Instruction::Greater:   R = Variant(L.Get<double>() > R.Get<double>());  break;
-		case Instruction::GreaterEq: R = Variant(L.Get<double>() >= R.Get<double>()); break;
+		case Instruction::Subtract:
+		case Instruction::Multiply:
+		case Instruction::Divide:
+		case Instruction::And:
+		case Instruction::Or:
+		case Instruction::Less:
+		case Instruction::LessEq:
+		case Instruction::Greater:
+		case Instruction::GreaterEq:
 		case Instruction::Equal:
-		{
-			if (AnyString(L, R))
-				R = Variant(L.Get<String>() == R.Get<String>());
-			else
-				R = Variant(L.Get<double>() == R.Get<double>());
-		}
-		break;
 		case Instruction::NotEqual:
 		{
-			if (AnyString(L, R))
-				R = Variant(L.Get<String>() != R.Get<String>());
-			else
-				R = Variant(L.Get<double>() != R.Get<double>());
+			ApplyBinaryOperator(instruction, L, R);
 		}
 		break;
+		case Instruction::Not:       R = Variant(!R.Get<bool>()); break;
 		case Instruction::Ternary:
 		{
 			if (L.Get<bool>())
@@ -989,12 +1088,31 @@ bool DataExpression::Parse(const DataExpressionInterface& expression_interface,
 	program = parser.ReleaseProgram();
 	addresses = parser.ReleaseAddresses();
 
+	FoldConstants(program);
+	handles.assign(addresses.size(), DataVariableHandle());
+
 	return true;
 }
 
 bool DataExpression::Run(const DataExpressionInterface& expression_interface, Variant& out_value)
 {
-	DataInterpreter interpreter(program, addresses, expression_interface);
+	// Most expressions consist of a single variable or a folded literal, these are retrieved without setting up the interpreter.
+	if (program.size() == 1)
+	{
+		const InstructionData& instruction = program.front();
+		if (instruction.instruction == Instruction::Literal)
+		{
+			out_value = instruction.data;
+			return true;
+		}
+		if (instruction.instruction == Instruction::Variable && !addresses.empty())
+		{
+			out_value = expression_interface.GetValue(addresses.front(), handles.front());
+			return true;
+		}
+	}
+
+	DataInterpreter interpreter(program, addresses, handles, expression_interface);
 	
 	if (!interpreter.Run())
 		return false;
@@ -1003,18 +1121,6 @@ bool DataExpression::Run(const DataExpressionInterface& expression_interface, Va
 	return true;
 }
 
-StringList DataExpression::GetVariableNameList() const
-{
-	StringList list;
-	list.reserve(addresses.size());
-	for (const DataAddress& address : addresses)
-	{
-		if (!address.empty())
-			list.push_back(address[0].name);
-	}
-	return list;
-}
-
 DataExpressionInterface::DataExpressionInterface(DataModel* data_model, Element* element, Event* event) : data_model(data_model), element(element), event(event)
 {}
 
@@ -1042,6 +1148,27 @@ Variant DataExpressionInterface::GetValue(const DataAddress& address) const
 	return result;
 }
 
+Variant DataExpressionInterface::GetValue(const DataAddress& address, DataVariableHandle& handle) const
+{
+	if (!data_model || address.empty() || address.front().name == "ev")
+		return GetValue(address);
+
+	if (handle.data_model != data_model)
+	{
+		handle.data_model = data_model;
+		handle.variable = data_model->GetStableVariable(address, handle.num_entries);
+	}
+
+	Variant result;
+	DataVariable variable = (handle.variable ? data_model->GetVariable(handle.variable, address, handle.num_entries) : DataVariable());
+	if (variable)
+		data_model->GetVariableInto(variable, address, result);
+	else
+		// Fall back to the regular lookup, which also takes care of literal addresses and reports any errors.
+		data_model->GetVariableInto(address, result);
+	return result;
+}
+
 bool DataExpressionInterface::SetValue(const DataAddress& address, const Variant& value) const
 {
 	bool result = false;
@@ -1051,7 +1178,7 @@ bool DataExpressionInterface::SetValue(const DataAddress& address, const Variant
 			result = variable.Set(value);
 
 		if (result)
-			data_model->DirtyVariable(address.front().name);
+			data_model->DirtyAddress(address);
 	}
 	return result;
 }
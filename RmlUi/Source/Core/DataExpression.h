@@ -32,6 +32,7 @@
 #include "../../Include/RmlUi/Core/Header.h"
 #include "../../Include/RmlUi/Core/Types.h"
 #include "../../Include/RmlUi/Core/DataTypes.h"
+#include "../../Include/RmlUi/Core/DataVariable.h"
 
 namespace Rml {
 
@@ -41,6 +42,14 @@ struct InstructionData;
 using Program = Vector<InstructionData>;
 using AddressList = Vector<DataAddress>;
 
+// A variable resolved from the leading entries of an address, cached by compiled expressions. See DataModel::GetStableVariable().
+struct DataVariableHandle {
+    const DataModel* data_model = nullptr;
+    DataVariable variable;
+    int num_entries = 0;
+};
+using HandleList = Vector<DataVariableHandle>;
+
 class DataExpressionInterface {
 public:
     DataExpressionInterface() = default;
@@ -48,6 +57,8 @@ public:
 
     DataAddress ParseAddress(const String& address_str) const;
     Variant GetValue(const DataAddress& address) const;
+    // Retrieves the value using the handle to skip the leading entries of the address, the handle is resolved on first use.
+    Variant GetValue(const DataAddress& address, DataVariableHandle& handle) const;
     bool SetValue(const DataAddress& address, const Variant& value) const;
     bool CallTransform(const String& name, const VariantList& arguments, Variant& out_result);
     bool EventCallback(const String& name, const VariantList& arguments);
@@ -64,18 +75,21 @@ public:
     DataExpression(String expression);
     ~DataExpression();
 
+    // Parses and compiles the expression. Compiling folds constant subexpressions, variable handles are resolved on first run.
     bool Parse(const DataExpressionInterface& expression_interface, bool is_assignment_expression);
 
     bool Run(const DataExpressionInterface& expression_interface, Variant& out_value);
 
     // Available after Parse()
-    StringList GetVariableNameList() const;
+    const AddressList& GetVariableAddressList() const { return addresses; }
 
 private:
     String expression;
     
     Program program;
     AddressList addresses;
+
+    HandleList handles;
 };
 
 } // namespace Rml
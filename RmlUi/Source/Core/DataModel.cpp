@@ -31,6 +31,7 @@
 #include "../../Include/RmlUi/Core/Element.h"
 #include "DataController.h"
 #include "DataView.h"
+#include <algorithm>
 
 namespace Rml {
 
@@ -101,6 +102,8 @@ static const char* LegalVariableName(const String& name)
 	return nullptr;
 }
 
+static const String row_slot_name = "#row";
+
 static String DataAddressToString(const DataAddress& address)
 {
 	String result;
@@ -120,6 +123,11 @@ static String DataAddressToString(const DataAddress& address)
 	return result;
 }
 
+bool DataModel::IsRowSlotEntry(const DataAddressEntry& entry)
+{
+	return entry.index >= 0 && !entry.name.empty();
+}
+
 DataModel::DataModel(DataTypeRegister* data_type_register) :
 	data_type_register(data_type_register)
 {
@@ -233,6 +241,89 @@ bool DataModel::EraseAliases(Element* element)
 	return aliases.erase(element) == 1;
 }
 
+DataAddressEntry DataModel::InsertRowSlot(Element* element, int index)
+{
+	auto result = row_slot_elements.emplace(element, 0);
+	int& slot = result.first->second;
+	if (result.second)
+	{
+		if (free_row_slots.empty())
+		{
+			slot = (int)row_slot_indices.size();
+			row_slot_indices.push_back(index);
+		}
+		else
+		{
+			slot = free_row_slots.back();
+			free_row_slots.pop_back();
+		}
+	}
+	else
+	{
+		RemoveRowSlotIndex(slot);
+	}
+
+	AssignRowSlotIndex(slot, index);
+
+	DataAddressEntry entry(row_slot_name);
+	entry.index = slot;
+	return entry;
+}
+
+void DataModel::SetRowSlotIndex(const DataAddressEntry& slot_entry, int index)
+{
+	RMLUI_ASSERT(IsRowSlotEntry(slot_entry) && slot_entry.index < (int)row_slot_indices.size());
+	if (row_slot_indices[slot_entry.index] == index)
+		return;
+
+	RemoveRowSlotIndex(slot_entry.index);
+	AssignRowSlotIndex(slot_entry.index, index);
+}
+
+void DataModel::AssignRowSlotIndex(int slot, int index)
+{
+	row_slot_indices[slot] = index;
+	row_slots_by_index[index].push_back(slot);
+}
+
+void DataModel::RemoveRowSlotIndex(int slot)
+{
+	auto it = row_slots_by_index.find(row_slot_indices[slot]);
+	if (it == row_slots_by_index.end())
+		return;
+
+	Vector<int>& slots = it->second;
+	auto it_slot = std::find(slots.begin(), slots.end(), slot);
+	if (it_slot != slots.end())
+	{
+		*it_slot = slots.back();
+		slots.pop_back();
+	}
+	if (slots.empty())
+		row_slots_by_index.erase(it);
+}
+
+const Vector<int>& DataModel::GetRowSlotsWithIndex(int index) const
+{
+	static const Vector<int> empty_slots;
+	auto it = row_slots_by_index.find(index);
+	return it != row_slots_by_index.end() ? it->second : empty_slots;
+}
+
+int DataModel::GetRowSlotIndex(const DataAddressEntry& slot_entry) const
+{
+	RMLUI_ASSERT(IsRowSlotEntry(slot_entry) && slot_entry.index < (int)row_slot_indices.size());
+	return row_slot_indices[slot_entry.index];
+}
+
+void DataModel::DirtyRowSlotIndex(const DataAddressEntry& slot_entry)
+{
+	// The iterator index of rows is bound through a literal address, which cannot be dirtied through DirtyAddress().
+	DataAddress address = {DataAddressEntry("literal"), DataAddressEntry("int"), DataAddressEntry(GetRowSlotIndex(slot_entry))};
+	if (dirty_address_keys.insert(DataAddressToString(address)).second)
+		dirty_addresses.push_back(std::move(address));
+}
+
 DataAddress DataModel::ResolveAddress(const String& address_str, Element* element) const
 {
 	DataAddress address = ParseAddress(address_str);
@@ -287,26 +378,59 @@ DataVariable DataModel::GetVariable(const DataAddress& address) const
 
 	auto it = variables.find(address.front().name);
 	if (it != variables.end())
+		return GetVariable(it->second, address, 1);
+
+	if (address[0].name == "literal")
 	{
-		DataVariable variable = it->second;
+		if (address.size() > 2 && address[1].name == "int")
+			return MakeLiteralIntVariable(IsRowSlotEntry(address[2]) ? GetRowSlotIndex(address[2]) : address[2].index);
+	}
 
-		for (int i = 1; i < (int)address.size() && variable; i++)
-		{
-			variable = variable.Child(address[i]);
-			if (!variable)
-				return DataVariable();
-		}
+	return DataVariable();
+}
+
+DataVariable DataModel::GetStableVariable(const DataAddress& address, int& out_num_entries) const
+{
+	out_num_entries = 0;
+	if (address.empty())
+		return DataVariable();
 
-		return variable;
+	auto it = variables.find(address.front().name);
+	if (it == variables.end())
+		return DataVariable();
+
+	// Bound variables are never removed, and struct members are located at a fixed offset from their parent.
+	DataVariable variable = it->second;
+	int num_entries = 1;
+	for (; num_entries < (int)address.size(); num_entries++)
+	{
+		const DataAddressEntry& entry = address[num_entries];
+		if (IsRowSlotEntry(entry) || !variable.HasStableChildren())
+			break;
+		DataVariable child = variable.Child(entry);
+		if (!child)
+			break;
+		variable = child;
 	}
 
-	if (address[0].name == "literal")
+	out_num_entries = num_entries;
+	return variable;
+}
+
+DataVariable DataModel::GetVariable(DataVariable variable, const DataAddress& address, int first_entry) const
+{
+	for (int i = first_entry; i < (int)address.size() && variable; i++)
 	{
-		if (address.size() > 2 && address[1].name == "int")
-			return MakeLiteralIntVariable(address[2].index);
+		const DataAddressEntry& entry = address[i];
+		if (IsRowSlotEntry(entry))
+			variable = variable.Child(DataAddressEntry(GetRowSlotIndex(entry)));
+		else
+			variable = variable.Child(entry);
+		if (!variable)
+			return DataVariable();
 	}
 
-	return DataVariable();
+	return variable;
 }
 
 const DataEventFunc* DataModel::GetEventCallback(const String& name)
@@ -322,24 +446,66 @@ const DataEventFunc* DataModel::GetEventCallback(const String& name)
 }
 
 bool DataModel::GetVariableInto(const DataAddress& address, Variant& out_value) const {
-	DataVariable variable = GetVariable(address);
+	return GetVariableInto(GetVariable(address), address, out_value);
+}
+
+bool DataModel::GetVariableInto(DataVariable variable, const DataAddress& address, Variant& out_value) const {
 	bool result = (variable && variable.Get(out_value));
 	if (!result)
 		Log::Message(Log::LT_WARNING, "Could not get value from data variable '%s'.", DataAddressToString(address).c_str());
 	return result;
 }
 
-void DataModel::DirtyVariable(const String& variable_name)
+void DataModel::DirtyVariable(const String& variable_path)
 {
-	RMLUI_ASSERTMSG(LegalVariableName(variable_name) == nullptr, "Illegal variable name provided. Only top-level variables can be dirtied.");
-	RMLUI_ASSERTMSG(variables.count(variable_name) == 1, "In DirtyVariable: Variable name not found among added variables.");
-	dirty_variables.emplace(variable_name);
+	if (variable_path.find_first_of(".[") != String::npos)
+	{
+		DataAddress address = ParseAddress(variable_path);
+		RMLUI_ASSERTMSG(!address.empty(), "In DirtyVariable: Invalid variable path provided.");
+		DirtyAddress(std::move(address));
+		return;
+	}
+
+	RMLUI_ASSERTMSG(LegalVariableName(variable_path) == nullptr, "Illegal variable name provided. Only top-level variables can be dirtied.");
+	RMLUI_ASSERTMSG(variables.count(variable_path) == 1, "In DirtyVariable: Variable name not found among added variables.");
+	dirty_variables.emplace(variable_path);
+}
+
+void DataModel::DirtyAddress(DataAddress address)
+{
+	if (address.empty())
+		return;
+
+	if (address.size() == 1)
+	{
+		dirty_variables.emplace(address.front().name);
+		return;
+	}
+
+	RMLUI_ASSERTMSG(variables.count(address.front().name) == 1, "In DirtyAddress: Variable name not found among added variables.");
+
+	for (DataAddressEntry& entry : address)
+	{
+		if (IsRowSlotEntry(entry))
+			entry = DataAddressEntry(GetRowSlotIndex(entry));
+	}
+
+	if (dirty_address_keys.insert(DataAddressToString(address)).second)
+		dirty_addresses.push_back(std::move(address));
 }
 
 bool DataModel::IsVariableDirty(const String& variable_name) const
 {
 	RMLUI_ASSERTMSG(LegalVariableName(variable_name) == nullptr, "Illegal variable name provided. Only top-level variables can be dirtied.");
-	return dirty_variables.count(variable_name) == 1;
+	if (dirty_variables.count(variable_name) == 1)
+		return true;
+
+	for (const DataAddress& address : dirty_addresses)
+	{
+		if (address.front().name == variable_name)
+			return true;
+	}
+	return false;
 }
 
 void DataModel::DirtyAllVariables() {
@@ -369,6 +535,15 @@ ElementList DataModel::GetAttachedModelRootElements() const
 void DataModel::OnElementRemove(Element* element)
 {
 	EraseAliases(element);
+
+	auto it_row_slot = row_slot_elements.find(element);
+	if (it_row_slot != row_slot_elements.end())
+	{
+		RemoveRowSlotIndex(it_row_slot->second);
+		free_row_slots.push_back(it_row_slot->second);
+		row_slot_elements.erase(it_row_slot);
+	}
+
 	views->OnElementRemove(element);
 	controllers->OnElementRemove(element);
 	attached_elements.erase(element);
@@ -376,10 +551,14 @@ void DataModel::OnElementRemove(Element* element)
 
 bool DataModel::Update(bool clear_dirty_variables)
 {
-	const bool result = views->Update(*this, dirty_variables);
+	const bool result = views->Update(*this, dirty_variables, dirty_addresses);
 
 	if (clear_dirty_variables)
+	{
 		dirty_variables.clear();
+		dirty_addresses.clear();
+		dirty_address_keys.clear();
+	}
 	
 	return result;
 }
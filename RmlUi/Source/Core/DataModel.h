@@ -60,15 +60,39 @@ public:
 	bool InsertAlias(Element* element, const String& alias_name, DataAddress replace_with_address);
 	bool EraseAliases(Element* element);
 
+	// Row slots hold the current index of a row owned by the given element, such as the rows of keyed 'data-for' views. Addresses
+	// containing the slot's entry follow the row when its index changes. The slot is released when the element is removed.
+	DataAddressEntry InsertRowSlot(Element* element, int index);
+	void SetRowSlotIndex(const DataAddressEntry& slot_entry, int index);
+	int GetRowSlotIndex(const DataAddressEntry& slot_entry) const;
+	// Returns the numbers of the row slots currently holding the given index.
+	const Vector<int>& GetRowSlotsWithIndex(int index) const;
+	// Dirties the views using the literal index of the row slot, should be called after the index of the slot has changed.
+	void DirtyRowSlotIndex(const DataAddressEntry& slot_entry);
+	static bool IsRowSlotEntry(const DataAddressEntry& entry);
+
 	DataAddress ResolveAddress(const String& address_str, Element* element) const;
 	const DataEventFunc* GetEventCallback(const String& name);
 
 	DataVariable GetVariable(const DataAddress& address) const;
+	// Resolves the variable at the start of the address whose handle remains valid for the lifetime of the model. Stops at array
+	// indices, row slots and pointers. Returns an empty variable if the address does not start with a bound variable.
+	DataVariable GetStableVariable(const DataAddress& address, int& out_num_entries) const;
+	// Resolves the remaining entries of the address, starting from a variable retrieved by GetStableVariable().
+	DataVariable GetVariable(DataVariable variable, const DataAddress& address, int first_entry) const;
 	bool GetVariableInto(const DataAddress& address, Variant& out_value) const;
-
-	void DirtyVariable(const String& variable_name);
+	// Retrieves the value of a variable already resolved from the address, the address is only used for reporting errors.
+	bool GetVariableInto(DataVariable variable, const DataAddress& address, Variant& out_value) const;
+
+	// Dirties a variable by its name, or part of it by a path such as "players[12].hp".
+	void DirtyVariable(const String& variable_path);
+	// Dirties the part of a variable at the given address, such as a struct member or an array element. Only views depending
+	// on the address, or on any part of it, are updated. Row slots are replaced by their current index.
+	void DirtyAddress(DataAddress address);
+	// Returns true if the variable, or any part of it, is dirty.
 	bool IsVariableDirty(const String& variable_name) const;
 	void DirtyAllVariables();
+	bool HasDirtyVariables() const { return !dirty_variables.empty() || !dirty_addresses.empty(); }
 
 	bool CallTransform(const String& name, const VariantList& arguments, Variant& out_result) const;
 
@@ -90,6 +114,9 @@ private:
 
 	UnorderedMap<String, DataVariable> variables;
 	DirtyVariables dirty_variables;
+	DirtyAddresses dirty_addresses;
+	// The addresses in 'dirty_addresses' as strings, used to skip duplicates.
+	SmallUnorderedSet<String> dirty_address_keys;
 
 	UnorderedMap<String, UniquePtr<FuncDefinition>> function_variable_definitions;
 	UnorderedMap<String, DataEventFunc> event_callbacks;
@@ -97,6 +124,15 @@ private:
 	using ScopedAliases = UnorderedMap<Element*, SmallUnorderedMap<String, DataAddress>>;
 	ScopedAliases aliases;
 
+	Vector<int> row_slot_indices;
+	Vector<int> free_row_slots;
+	UnorderedMap<Element*, int> row_slot_elements;
+	// Reverse lookup of 'row_slot_indices' for slots in use, from index to the slot numbers.
+	UnorderedMap<int, Vector<int>> row_slots_by_index;
+
+	void AssignRowSlotIndex(int slot, int index);
+	void RemoveRowSlotIndex(int slot);
+
 	DataTypeRegister* data_type_register;
 
 	SmallUnorderedSet<Element*> attached_elements;
@@ -39,8 +39,16 @@ bool DataModelHandle::IsVariableDirty(const String& variable_name) {
 	return model->IsVariableDirty(variable_name);
 }
 
-void DataModelHandle::DirtyVariable(const String& variable_name) {
-	model->DirtyVariable(variable_name);
+void DataModelHandle::DirtyVariable(const String& variable_path) {
+	model->DirtyVariable(variable_path);
+}
+
+void DataModelHandle::DirtyArrayElement(const String& array_path, int index, const String& member_path) {
+	RMLUI_ASSERTMSG(index >= 0, "In DirtyArrayElement: Array index must be non-negative.");
+	String path = array_path + '[' + ToString(index) + ']';
+	if (!member_path.empty())
+		path += '.' + member_path;
+	model->DirtyVariable(path);
 }
 
 void DataModelHandle::DirtyAllVariables() {
@@ -50,6 +50,10 @@ DataVariableType DataVariable::Type() {
     return definition->Type();
 }
 
+bool DataVariable::HasStableChildren() {
+    return definition->HasStableChildren();
+}
+
 
 bool VariableDefinition::Get(void* /*ptr*/, Variant& /*variant*/) {
     Log::Message(Log::LT_WARNING, "Values can only be retrieved from scalar data types.");
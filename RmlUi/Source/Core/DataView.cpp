@@ -27,6 +27,7 @@
  */
 
 #include "DataView.h"
+#include "DataModel.h"
 #include "../../Include/RmlUi/Core/Element.h"
 #include <algorithm>
 
@@ -62,12 +63,145 @@ DataView::DataView(Element* element, int bias) : attached_element(element->GetOb
 }
 
 
-DataViews::DataViews()
+struct DataViewDependencyNode {
+	// The last entry of the address leading to this node.
+	DataAddressEntry entry = DataAddressEntry(-1);
+	DataViewDependencyNode* parent = nullptr;
+	// Views depending on the address leading to this node.
+	Vector<DataView*> views;
+
+	SmallUnorderedMap<String, UniquePtr<DataViewDependencyNode>> members;
+	SmallUnorderedMap<int, UniquePtr<DataViewDependencyNode>> elements;
+	// Elements addressed through a row slot, keyed by the slot number. Their index is looked up when matching dirty addresses.
+	SmallUnorderedMap<int, UniquePtr<DataViewDependencyNode>> row_slots;
+};
+
+static DataViewDependencyNode& GetDependencyChild(DataViewDependencyNode& node, const DataAddressEntry& entry)
+{
+	UniquePtr<DataViewDependencyNode>* child = nullptr;
+	if (DataModel::IsRowSlotEntry(entry))
+		child = &node.row_slots[entry.index];
+	else if (entry.index >= 0)
+		child = &node.elements[entry.index];
+	else
+		child = &node.members[entry.name];
+
+	if (!*child)
+	{
+		*child = MakeUnique<DataViewDependencyNode>();
+		(*child)->entry = entry;
+		(*child)->parent = &node;
+	}
+	return **child;
+}
+
+// Removes the node and its ancestors from the trie as long as they have neither views nor children.
+static void PruneDependencyNode(DataViewDependencyNode* node)
+{
+	while (node->parent && node->views.empty() && node->members.empty() && node->elements.empty() && node->row_slots.empty())
+	{
+		DataViewDependencyNode* parent = node->parent;
+		const DataAddressEntry& entry = node->entry;
+		if (DataModel::IsRowSlotEntry(entry))
+			parent->row_slots.erase(entry.index);
+		else if (entry.index >= 0)
+			parent->elements.erase(entry.index);
+		else
+			parent->members.erase(entry.name);
+
+		node = parent;
+	}
+}
+
+static void CollectAllViews(const DataViewDependencyNode& node, Vector<DataView*>& out_views)
+{
+	out_views.insert(out_views.end(), node.views.begin(), node.views.end());
+	for (auto& child : node.members)
+		CollectAllViews(*child.second, out_views);
+	for (auto& child : node.elements)
+		CollectAllViews(*child.second, out_views);
+	for (auto& child : node.row_slots)
+		CollectAllViews(*child.second, out_views);
+}
+
+// Collects the views whose dependencies intersect the dirty address. That is, all views along the address, which depend on a
+// variable containing the dirty part, and all views below its end, which depend on a part of the dirty variable.
+static void CollectDirtyViews(const DataViewDependencyNode& node, const DataModel& model, const DataAddress& address, size_t i,
+	Vector<DataView*>& out_views)
+{
+	if (i == address.size())
+	{
+		CollectAllViews(node, out_views);
+		return;
+	}
+
+	out_views.insert(out_views.end(), node.views.begin(), node.views.end());
+
+	const DataAddressEntry& entry = address[i];
+	if (entry.index >= 0)
+	{
+		auto it = node.elements.find(entry.index);
+		if (it != node.elements.end())
+			CollectDirtyViews(*it->second, model, address, i + 1, out_views);
+
+		if (!node.row_slots.empty())
+		{
+			for (int slot : model.GetRowSlotsWithIndex(entry.index))
+			{
+				auto it_slot = node.row_slots.find(slot);
+				if (it_slot != node.row_slots.end())
+					CollectDirtyViews(*it_slot->second, model, address, i + 1, out_views);
+			}
+		}
+	}
+	else
+	{
+		auto it = node.members.find(entry.name);
+		if (it != node.members.end())
+			CollectDirtyViews(*it->second, model, address, i + 1, out_views);
+	}
+}
+
+DataViews::DataViews() : dependencies(MakeUnique<DataViewDependencyNode>())
 {}
 
 DataViews::~DataViews()
 {}
 
+void DataViews::AddDependencies(DataView* view)
+{
+	Vector<DataViewDependencyNode*>& nodes = view_dependencies[view];
+	for (const DataAddress& address : view->GetVariableAddressList())
+	{
+		DataViewDependencyNode* node = dependencies.get();
+		for (const DataAddressEntry& entry : address)
+			node = &GetDependencyChild(*node, entry);
+
+		if (node != dependencies.get())
+		{
+			node->views.push_back(view);
+			nodes.push_back(node);
+		}
+	}
+}
+
+void DataViews::RemoveDependencies(DataView* view)
+{
+	auto it = view_dependencies.find(view);
+	if (it == view_dependencies.end())
+		return;
+
+	for (DataViewDependencyNode* node : it->second)
+	{
+		auto it_view = std::find(node->views.begin(), node->views.end(), view);
+		if (it_view != node->views.end())
+			node->views.erase(it_view);
+
+		PruneDependencyNode(node);
+	}
+	view_dependencies.erase(it);
+}
+
 void DataViews::Add(DataViewPtr view) {
 	views_to_add.push_back(std::move(view));
 }
@@ -87,17 +221,20 @@ void DataViews::OnElementRemove(Element* element)
 	}
 }
 
-bool DataViews::Update(DataModel& model, const DirtyVariables& dirty_variables)
+bool DataViews::Update(DataModel& model, const DirtyVariables& dirty_variables, const DirtyAddresses& dirty_addresses)
 {
 	bool result = false;
 	size_t num_dirty_variables_prev = 0;
+	size_t num_dirty_addresses_prev = 0;
 
 	// View updates may result in newly added views, or even new dirty variables. Thus, we do the
 	// update recursively but with an upper limit. Without the loop, newly added views won't be
 	// updated until the next Update() call.
-	for(int i = 0; (i == 0 || !views_to_add.empty() || num_dirty_variables_prev != dirty_variables.size()) && i < 10; i++)
+	for (int i = 0; (i == 0 || !views_to_add.empty() || num_dirty_variables_prev != dirty_variables.size() ||
+						num_dirty_addresses_prev != dirty_addresses.size()) && i < 10; i++)
 	{
 		num_dirty_variables_prev = dirty_variables.size();
+		num_dirty_addresses_prev = dirty_addresses.size();
 
 		Vector<DataView*> dirty_views;
 
@@ -107,8 +244,7 @@ bool DataViews::Update(DataModel& model, const DirtyVariables& dirty_variables)
 			for (auto&& view : views_to_add)
 			{
 				dirty_views.push_back(view.get());
-				for (const String& variable_name : view->GetVariableNameList())
-					name_view_map.emplace(variable_name, view.get());
+				AddDependencies(view.get());
 
 				views.push_back(std::move(view));
 			}
@@ -117,9 +253,16 @@ bool DataViews::Update(DataModel& model, const DirtyVariables& dirty_variables)
 
 		for (const String& variable_name : dirty_variables)
 		{
-			auto pair = name_view_map.equal_range(variable_name);
-			for (auto it = pair.first; it != pair.second; ++it)
-				dirty_views.push_back(it->second);
+			auto it = dependencies->members.find(variable_name);
+			if (it != dependencies->members.end())
+				CollectAllViews(*it->second, dirty_views);
+		}
+
+		for (const DataAddress& address : dirty_addresses)
+		{
+			// Addresses within variables which are dirty as a whole have already been collected above.
+			if (!address.empty() && dirty_variables.count(address.front().name) == 0)
+				CollectDirtyViews(*dependencies, model, address, 0, dirty_views);
 		}
 
 		// Remove duplicate entries
@@ -142,19 +285,10 @@ bool DataViews::Update(DataModel& model, const DirtyVariables& dirty_variables)
 		}
 
 		// Destroy views marked for destruction
-		// @performance: Horrible...
 		if (!views_to_remove.empty())
 		{
 			for (const auto& view : views_to_remove)
-			{
-				for (auto it = name_view_map.begin(); it != name_view_map.end(); )
-				{
-					if (it->second == view.get())
-						it = name_view_map.erase(it);
-					else
-						++it;
-				}
-			}
+				RemoveDependencies(view.get());
 
 			views_to_remove.clear();
 		}
@@ -38,6 +38,7 @@ namespace Rml {
 
 class Element;
 class DataModel;
+struct DataViewDependencyNode;
 
 
 class DataViewInstancer : public NonCopyMoveable {
@@ -82,8 +83,9 @@ public:
 	// Returns true if the update resulted in a document change.
 	virtual bool Update(DataModel& model) = 0;
 
-	// Returns the list of data variable name(s) which can modify this view.
-	virtual StringList GetVariableNameList() const = 0;
+	// Returns the addresses of the data variables which can modify this view. Changes to any part of an address, or to anything
+	// contained in the variable at the address, will update the view.
+	virtual Vector<DataAddress> GetVariableAddressList() const = 0;
 
 	// Returns the attached element if it still exists.
 	Element* GetElement() const;
@@ -117,18 +119,22 @@ public:
 
 	void OnElementRemove(Element* element);
 
-	bool Update(DataModel& model, const DirtyVariables& dirty_variables);
+	bool Update(DataModel& model, const DirtyVariables& dirty_variables, const DirtyAddresses& dirty_addresses);
 
 private:
 	using DataViewList = Vector<DataViewPtr>;
 
+	void AddDependencies(DataView* view);
+	void RemoveDependencies(DataView* view);
+
 	DataViewList views;
 	
 	DataViewList views_to_add;
 	DataViewList views_to_remove;
 
-	using NameViewMap = UnorderedMultimap<String, DataView*>;
-	NameViewMap name_view_map;
+	// A trie of the views keyed by the addresses they depend on, rooted at the top-level variable names.
+	UniquePtr<DataViewDependencyNode> dependencies;
+	UnorderedMap<DataView*, Vector<DataViewDependencyNode*>> view_dependencies;
 };
 
 } // namespace Rml
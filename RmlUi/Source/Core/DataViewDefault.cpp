@@ -29,6 +29,8 @@
 #include "DataViewDefault.h"
 #include "DataExpression.h"
 #include "DataModel.h"
+#include "ElementTemplate.h"
+#include "Elements/ElementVirtualSpacer.h"
 #include "XMLParseTools.h"
 #include "../../Include/RmlUi/Core/Core.h"
 #include "../../Include/RmlUi/Core/DataVariable.h"
@@ -37,6 +39,7 @@
 #include "../../Include/RmlUi/Core/Factory.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
 #include "../../Include/RmlUi/Core/Variant.h"
+#include <algorithm>
 
 namespace Rml {
 
@@ -63,9 +66,9 @@ bool DataViewCommon::Initialize(DataModel& model, Element* element, const String
 	return result;
 }
 
-StringList DataViewCommon::GetVariableNameList() const {
+Vector<DataAddress> DataViewCommon::GetVariableAddressList() const {
 	RMLUI_ASSERT(expression);
-	return expression->GetVariableNameList();
+	return expression->GetVariableAddressList();
 }
 
 const String& DataViewCommon::GetModifier() const {
@@ -429,20 +432,17 @@ bool DataViewText::Update(DataModel& model)
 	return entries_modified;
 }
 
-StringList DataViewText::GetVariableNameList() const
+Vector<DataAddress> DataViewText::GetVariableAddressList() const
 {
-	StringList full_list;
+	Vector<DataAddress> full_list;
 	full_list.reserve(data_entries.size());
 
 	for (const DataEntry& entry : data_entries)
 	{
 		RMLUI_ASSERT(entry.data_expression);
 
-		StringList entry_list = entry.data_expression->GetVariableNameList();
-		full_list.insert(full_list.end(),
-			MakeMoveIterator(entry_list.begin()),
-			MakeMoveIterator(entry_list.end())
-		);
+		const Vector<DataAddress>& entry_list = entry.data_expression->GetVariableAddressList();
+		full_list.insert(full_list.end(), entry_list.begin(), entry_list.end());
 	}
 
 	return full_list;
@@ -484,8 +484,6 @@ DataViewFor::DataViewFor(Element* element) : DataView(element, 0)
 
 bool DataViewFor::Initialize(DataModel& model, Element* element, const String& in_expression, const String& in_rml_content)
 {
-	rml_contents = in_rml_content;
-
 	StringList iterator_container_pair;
 	StringUtilities::ExpandString(iterator_container_pair, in_expression, ':');
 
@@ -530,20 +528,90 @@ bool DataViewFor::Initialize(DataModel& model, Element* element, const String& i
 
 	element->SetProperty(PropertyId::Display, Property(Style::Display::None));
 
+	// Compile the row contents once, rows are then instanced from the template without parsing.
+	row_template = ElementTemplate::Compile(in_rml_content);
+
 	// Copy over the attributes, but remove the 'data-for' which would otherwise recreate the data-for loop on all constructed children recursively.
 	attributes = element->GetAttributes();
-	for (auto it = attributes.begin(); it != attributes.end(); ++it)
+	attributes.erase("data-for");
+	attributes.erase("data-for-key");
+	attributes.erase("data-for-virtual");
+
+	if (const Variant* virtual_attribute = element->GetAttribute("data-for-virtual"))
+	{
+		virtualized = true;
+		virtual_row_height = Math::Max(virtual_attribute->Get<float>(), 0.f);
+	}
+
+	const String key_expression_str = element->GetAttribute<String>("data-for-key", String());
+	if (!key_expression_str.empty() && virtualized)
+	{
+		Log::Message(Log::LT_WARNING, "The data-for-key expression '%s' is ignored in virtualized data-for views.", key_expression_str.c_str());
+	}
+	else if (!key_expression_str.empty())
 	{
-		if (it->first == "data-for")
+		// Parse the key expression with the iterator aliases bound to the key slot, they are only needed during parsing.
+		key_slot = model.InsertRowSlot(element, 0);
+
+		DataAddress iterator_address = container_address;
+		iterator_address.push_back(key_slot);
+		DataAddress iterator_index_address = {
+			{"literal"}, {"int"}, key_slot
+		};
+
+		model.InsertAlias(element, iterator_name, std::move(iterator_address));
+		model.InsertAlias(element, iterator_index_name, std::move(iterator_index_address));
+
+		key_expression = MakeUnique<DataExpression>(key_expression_str);
+		const bool key_result = key_expression->Parse(DataExpressionInterface(&model, element), false);
+
+		model.EraseAliases(element);
+
+		if (!key_result)
 		{
-			attributes.erase(it);
-			break;
+			Log::Message(Log::LT_WARNING, "Invalid key expression in data-for-key '%s'", key_expression_str.c_str());
+			return false;
 		}
 	}
 
 	return true;
 }
 
+// Returns the items which form the longest increasing subsequence of their previous row positions. These rows can stay in place, while
+// all other rows need to be moved. Items without a previous row, indicated by a negative position, are not part of the subsequence.
+static Vector<bool> FindStableRows(const Vector<int>& previous_positions)
+{
+	const int num_items = (int)previous_positions.size();
+
+	// The item ending the increasing subsequence with the smallest position, for each subsequence length.
+	Vector<int> tails;
+	Vector<int> predecessors(num_items, -1);
+
+	for (int i = 0; i < num_items; i++)
+	{
+		const int position = previous_positions[i];
+		if (position < 0)
+			continue;
+
+		auto it = std::lower_bound(tails.begin(), tails.end(), position,
+			[&previous_positions](int item, int value) { return previous_positions[item] < value; });
+
+		if (it != tails.begin())
+			predecessors[i] = *(it - 1);
+
+		if (it == tails.end())
+			tails.push_back(i);
+		else
+			*it = i;
+	}
+
+	Vector<bool> stable(num_items, false);
+	for (int i = (tails.empty() ? -1 : tails.back()); i >= 0; i = predecessors[i])
+		stable[i] = true;
+
+	return stable;
+}
+
 
 bool DataViewFor::Update(DataModel& model)
 {
@@ -553,6 +621,19 @@ bool DataViewFor::Update(DataModel& model)
 
 	bool result = false;
 	const int size = variable.Size();
+
+	if (virtualized)
+	{
+		UpdateVirtualRows(model, size);
+		return result;
+	}
+
+	if (key_expression)
+	{
+		UpdateKeyedRows(model, size);
+		return result;
+	}
+
 	const int num_elements = (int)elements.size();
 	Element* element = GetElement();
 
@@ -561,23 +642,7 @@ bool DataViewFor::Update(DataModel& model)
 		if (i >= num_elements)
 		{
 			ElementPtr new_element_ptr = Factory::InstanceElement(nullptr, element->GetTagName(), element->GetTagName(), attributes);
-
-			DataAddress iterator_address;
-			iterator_address.reserve(container_address.size() + 1);
-			iterator_address = container_address;
-			iterator_address.push_back(DataAddressEntry(i));
-
-			DataAddress iterator_index_address = {
-				{"literal"}, {"int"}, {i}
-			};
-
-			model.InsertAlias(new_element_ptr.get(), iterator_name, std::move(iterator_address));
-			model.InsertAlias(new_element_ptr.get(), iterator_index_name, std::move(iterator_index_address));
-
-			Element* new_element = element->GetParentNode()->InsertBefore(std::move(new_element_ptr), element);
-			elements.push_back(new_element);
-
-			elements[i]->SetInnerRML(rml_contents);
+			elements.push_back(InsertRow(model, std::move(new_element_ptr), DataAddressEntry(i), element));
 
 			RMLUI_ASSERT(i < (int)elements.size());
 		}
@@ -595,21 +660,336 @@ bool DataViewFor::Update(DataModel& model)
 	return result;
 }
 
-StringList DataViewFor::GetVariableNameList() const {
+Element* DataViewFor::InsertRow(DataModel& model, ElementPtr row, const DataAddressEntry& index_entry, Element* adjacent_element)
+{
+	DataAddress iterator_address;
+	iterator_address.reserve(container_address.size() + 1);
+	iterator_address = container_address;
+	iterator_address.push_back(index_entry);
+
+	DataAddress iterator_index_address = {
+		{"literal"}, {"int"}, index_entry
+	};
+
+	model.InsertAlias(row.get(), iterator_name, std::move(iterator_address));
+	model.InsertAlias(row.get(), iterator_index_name, std::move(iterator_index_address));
+
+	Element* new_element = GetElement()->GetParentNode()->InsertBefore(std::move(row), adjacent_element);
+	row_template->Instance(new_element);
+
+	return new_element;
+}
+
+void DataViewFor::UpdateKeyedRows(DataModel& model, const int size)
+{
+	Element* element = GetElement();
+	Element* parent = element->GetParentNode();
+	DataExpressionInterface expression_interface(&model, element);
+
+	StringList keys(size);
+	Vector<bool> keyed(size, false);
+	int num_unkeyed = 0;
+	for (int i = 0; i < size; i++)
+	{
+		model.SetRowSlotIndex(key_slot, i);
+		Variant key;
+		if (key_expression->Run(expression_interface, key))
+		{
+			keys[i] = key.Get<String>();
+			keyed[i] = true;
+		}
+		else
+			num_unkeyed += 1;
+	}
+
+	if (num_unkeyed > 0)
+		Log::Message(Log::LT_WARNING, "Could not evaluate the data-for-key expression for %d items, their rows are not keyed.", num_unkeyed);
+
+	// Match the items to the existing rows by key. Duplicate keys are matched only once, the remaining items get new rows. Unkeyed items
+	// and rows are never matched.
+	const int num_rows = (int)elements.size();
+	UnorderedMap<String, int> row_positions;
+	row_positions.reserve(num_rows);
+	for (int i = 0; i < num_rows; i++)
+	{
+		if (rows_keyed[i])
+			row_positions.emplace(row_keys[i], i);
+	}
+
+	Vector<int> previous_positions(size, -1);
+	Vector<bool> row_matched(num_rows, false);
+	for (int i = 0; i < size; i++)
+	{
+		if (!keyed[i])
+			continue;
+
+		auto it = row_positions.find(keys[i]);
+		if (it != row_positions.end())
+		{
+			previous_positions[i] = it->second;
+			row_matched[it->second] = true;
+			row_positions.erase(it);
+		}
+	}
+
+	for (int i = 0; i < num_rows; i++)
+	{
+		if (!row_matched[i])
+		{
+			model.EraseAliases(elements[i]);
+			parent->RemoveChild(elements[i]).reset();
+		}
+	}
+
+	const Vector<bool> stable = FindStableRows(previous_positions);
+
+	// Place the rows from the back, so that every row can be put right before its successor. The slots of matched rows are
+	// updated in place, thereby keeping all bindings within the row intact.
+	ElementList new_elements(size);
+	Vector<DataAddressEntry> new_slots;
+	new_slots.reserve(size);
+	Element* next_row = element;
+
+	for (int i = size - 1; i >= 0; i--)
+	{
+		const int previous_position = previous_positions[i];
+		Element* row = nullptr;
+
+		if (previous_position < 0)
+		{
+			ElementPtr row_ptr = Factory::InstanceElement(nullptr, element->GetTagName(), element->GetTagName(), attributes);
+			const DataAddressEntry slot = model.InsertRowSlot(row_ptr.get(), i);
+			row = InsertRow(model, std::move(row_ptr), slot, next_row);
+			new_slots.push_back(slot);
+		}
+		else
+		{
+			row = elements[previous_position];
+			const DataAddressEntry& slot = row_slots[previous_position];
+
+			if (!stable[i])
+				parent->MoveChildBefore(row, next_row);
+
+			if (model.GetRowSlotIndex(slot) != i)
+			{
+				model.SetRowSlotIndex(slot, i);
+				DirtyRowSlot(model, slot);
+			}
+			new_slots.push_back(slot);
+		}
+
+		new_elements[i] = row;
+		next_row = row;
+	}
+
+	std::reverse(new_slots.begin(), new_slots.end());
+
+	elements = std::move(new_elements);
+	row_slots = std::move(new_slots);
+	row_keys = std::move(keys);
+	rows_keyed = std::move(keyed);
+}
+
+void DataViewFor::DirtyRowSlot(DataModel& model, const DataAddressEntry& slot)
+{
+	// Rows now bound to other items need their views updated, even if the reordering was caused by a variable of the key expression.
+	DataAddress item_address = container_address;
+	item_address.push_back(slot);
+	model.DirtyAddress(std::move(item_address));
+	model.DirtyRowSlotIndex(slot);
+}
+
+void DataViewFor::UpdateVirtualRows(DataModel& model, const int size)
+{
+	Element* element = GetElement();
+	Element* parent = element->GetParentNode();
+
+	if (!bottom_spacer)
+	{
+		ElementPtr spacer = Factory::InstanceElement(nullptr, "#rmlctl_virtualspacer", "virtualspacer", XMLAttributes());
+		if (!spacer)
+			return;
+
+		bottom_spacer = parent->InsertBefore(std::move(spacer), element)->GetObserverPtr();
+	}
+	if (!top_spacer)
+	{
+		ElementPtr spacer = Factory::InstanceElement(nullptr, "#rmlctl_virtualspacer", "virtualspacer", XMLAttributes());
+		ElementVirtualSpacer* top_spacer_ptr = rmlui_dynamic_cast<ElementVirtualSpacer*>(spacer.get());
+		if (!top_spacer_ptr)
+			return;
+
+		top_spacer_ptr->SetRangeCallback([this]() { OnViewportChange(); });
+		Element* first_row = (elements.empty() ? bottom_spacer.get() : elements.front());
+		top_spacer = parent->InsertBefore(std::move(spacer), first_row)->GetObserverPtr();
+	}
+
+	ElementVirtualSpacer* top_spacer_ptr = rmlui_dynamic_cast<ElementVirtualSpacer*>(top_spacer.get());
+	ElementVirtualSpacer* bottom_spacer_ptr = rmlui_dynamic_cast<ElementVirtualSpacer*>(bottom_spacer.get());
+	if (!top_spacer_ptr || !bottom_spacer_ptr)
+	{
+		Log::Message(Log::LT_WARNING, "Virtualized data-for view expected its spacers to be derivatives of ElementVirtualSpacer.");
+		return;
+	}
+
+	const float row_height = GetVirtualRowHeight();
+	int first = 0, last = 0;
+	top_spacer_ptr->SetRows(size, row_height);
+	top_spacer_ptr->GetRowRange(first, last);
+	const int num_rows = last - first;
+
+	// Rows whose item is still in range are kept as they are, the remaining rows are recycled for the newly exposed items.
+	ElementList new_elements(num_rows, nullptr);
+	Vector<DataAddressEntry> new_slots(num_rows, DataAddressEntry(-1));
+	ElementList free_rows;
+	Vector<DataAddressEntry> free_slots;
+
+	for (int i = 0; i < (int)elements.size(); i++)
+	{
+		const int index = virtual_first + i;
+		if (index >= first && index < last)
+		{
+			new_elements[index - first] = elements[i];
+			new_slots[index - first] = row_slots[i];
+		}
+		else
+		{
+			free_rows.push_back(elements[i]);
+			free_slots.push_back(row_slots[i]);
+		}
+	}
+
+	// Place the rows from the back, the kept rows are already in order so only recycled rows need to be moved.
+	Element* next_row = bottom_spacer.get();
+
+	for (int i = num_rows - 1; i >= 0; i--)
+	{
+		Element* row = new_elements[i];
+		if (!row)
+		{
+			const int index = first + i;
+			if (!free_rows.empty())
+			{
+				row = free_rows.back();
+				new_slots[i] = free_slots.back();
+				free_rows.pop_back();
+				free_slots.pop_back();
+
+				model.SetRowSlotIndex(new_slots[i], index);
+				parent->MoveChildBefore(row, next_row);
+				DirtyRowSlot(model, new_slots[i]);
+			}
+			else
+			{
+				ElementPtr row_ptr = Factory::InstanceElement(nullptr, element->GetTagName(), element->GetTagName(), attributes);
+				new_slots[i] = model.InsertRowSlot(row_ptr.get(), index);
+				row = InsertRow(model, std::move(row_ptr), new_slots[i], next_row);
+			}
+
+			new_elements[i] = row;
+		}
+
+		next_row = row;
+	}
+
+	for (Element* row : free_rows)
+	{
+		model.EraseAliases(row);
+		parent->RemoveChild(row).reset();
+	}
+
+	top_spacer_ptr->SetSpacerHeight(float(first) * row_height);
+	bottom_spacer_ptr->SetSpacerHeight(float(size - last) * row_height);
+
+	// While the row height is estimated, update again after the rows have been laid out so that they can be measured.
+	if (virtual_row_height <= 0.f && measured_row_height <= 0.f && num_rows > 0)
+		top_spacer_ptr->DirtyRowRange();
+
+	elements = std::move(new_elements);
+	row_slots = std::move(new_slots);
+	virtual_first = first;
+}
+
+float DataViewFor::GetVirtualRowHeight()
+{
+	if (virtual_row_height > 0.f)
+		return virtual_row_height;
+
+	// Measure the rows once they have been laid out. The measurement is kept afterwards, otherwise the spacers could oscillate between
+	// sets of rows with different heights.
+	if (measured_row_height <= 0.f)
+	{
+		float total_height = 0.f;
+		int num_measured = 0;
+		for (Element* row : elements)
+		{
+			const float height = row->GetBox().GetSize(Box::MARGIN).y;
+			if (height > 0.f)
+			{
+				total_height += height;
+				num_measured++;
+			}
+		}
+
+		if (num_measured > 0)
+			measured_row_height = total_height / float(num_measured);
+	}
+
+	if (measured_row_height > 0.f)
+		return measured_row_height;
+
+	// Until then, estimate the row height by the line height.
+	const float line_height = GetElement()->GetParentNode()->GetLineHeight();
+	return line_height > 0.f ? line_height : 16.f;
+}
+
+void DataViewFor::OnViewportChange()
+{
+	// The range of rows in the viewport has changed from scrolling or resizing, or the rows were laid out for the first time. Update
+	// the view to instance the rows in view.
+	Element* element = GetElement();
+	if (DataModel* model = (element ? element->GetDataModel() : nullptr))
+	{
+		DataAddress size_address = container_address;
+		size_address.emplace_back("size");
+		model->DirtyAddress(std::move(size_address));
+	}
+}
+
+Vector<DataAddress> DataViewFor::GetVariableAddressList() const {
 	RMLUI_ASSERT(!container_address.empty());
-	return StringList{ container_address.front().name };
+
+	// Keyed rows are matched against the contents of the container, otherwise only its size affects the rows.
+	if (key_expression)
+	{
+		Vector<DataAddress> list = { container_address };
+		const Vector<DataAddress>& key_list = key_expression->GetVariableAddressList();
+		list.insert(list.end(), key_list.begin(), key_list.end());
+		return list;
+	}
+
+	DataAddress size_address = container_address;
+	size_address.emplace_back("size");
+	return { std::move(size_address) };
 }
 
 void DataViewFor::Release()
 {
+	if (ElementVirtualSpacer* spacer = rmlui_dynamic_cast<ElementVirtualSpacer*>(top_spacer.get()))
+		spacer->SetRangeCallback(nullptr);
+
 	delete this;
 }
 
 DataViewAlias::DataViewAlias(Element* element) : DataView(element, 0) {}
 
-StringList DataViewAlias::GetVariableNameList() const
+Vector<DataAddress> DataViewAlias::GetVariableAddressList() const
 {
-	return variables;
+	Vector<DataAddress> list;
+	list.reserve(variables.size());
+	for (const String& name : variables)
+		list.push_back(DataAddress{DataAddressEntry(name)});
+	return list;
 }
 
 bool DataViewAlias::Update(DataModel&)
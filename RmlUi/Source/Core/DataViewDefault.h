@@ -31,6 +31,7 @@
 
 #include "../../Include/RmlUi/Core/Header.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include "../../Include/RmlUi/Core/ObserverPtr.h"
 #include "../../Include/RmlUi/Core/Variant.h"
 #include "DataView.h"
 
@@ -38,6 +39,7 @@ namespace Rml {
 
 class Element;
 class DataExpression;
+class ElementTemplate;
 using DataExpressionPtr = UniquePtr<DataExpression>;
 
 
@@ -47,7 +49,7 @@ public:
 
 	bool Initialize(DataModel& model, Element* element, const String& expression, const String& modifier) override;
 
-	StringList GetVariableNameList() const override;
+	Vector<DataAddress> GetVariableAddressList() const override;
 
 protected:
 	const String& GetModifier() const;
@@ -139,7 +141,7 @@ public:
 	bool Initialize(DataModel& model, Element* element, const String& expression, const String& modifier) override;
 
 	bool Update(DataModel& model) override;
-	StringList GetVariableNameList() const override;
+	Vector<DataAddress> GetVariableAddressList() const override;
 
 protected:
 	void Release() override;
@@ -166,25 +168,54 @@ public:
 
 	bool Update(DataModel& model) override;
 
-	StringList GetVariableNameList() const override;
+	Vector<DataAddress> GetVariableAddressList() const override;
 
 protected:
 	void Release() override;
 
 private:
+	// Inserts the row with its iterator bound to the given index entry, and instances its contents.
+	Element* InsertRow(DataModel& model, ElementPtr row, const DataAddressEntry& index_entry, Element* adjacent_element);
+	// Reconciles the rows with the items by key, only creating and removing rows of inserted and deleted keys.
+	void UpdateKeyedRows(DataModel& model, int size);
+	// Dirties the views of a row whose slot now points at another item.
+	void DirtyRowSlot(DataModel& model, const DataAddressEntry& slot);
+	// Instances only the rows of the items in the viewport of the parent, rebinding the existing rows as it scrolls.
+	void UpdateVirtualRows(DataModel& model, int size);
+	float GetVirtualRowHeight();
+	void OnViewportChange();
+
 	DataAddress container_address;
 	String iterator_name;
 	String iterator_index_name;
-	String rml_contents;
+	SharedPtr<const ElementTemplate> row_template;
 	ElementAttributes attributes;
 
+	// Set by 'data-for-key', the key expression is evaluated for each item by pointing the key slot at the item.
+	DataExpressionPtr key_expression;
+	DataAddressEntry key_slot = DataAddressEntry(-1);
+	StringList row_keys;
+	// False for rows whose key could not be evaluated, such rows are never matched by key.
+	Vector<bool> rows_keyed;
+	Vector<DataAddressEntry> row_slots;
+
+	// Set by 'data-for-virtual', with a fixed row height in pixels, or zero to measure the rows. The rows before and after the instanced
+	// range are replaced by spacers, and the instanced rows are bound through row slots so that they can be recycled while scrolling.
+	bool virtualized = false;
+	float virtual_row_height = 0.f;
+	float measured_row_height = 0.f;
+	int virtual_first = 0;
+	// The top spacer measures the rows from its own position, and calls back whenever the range of rows in the viewport changes.
+	ObserverPtr<Element> top_spacer;
+	ObserverPtr<Element> bottom_spacer;
+
 	ElementList elements;
 };
 
 class DataViewAlias final : public DataView {
 public:
 	DataViewAlias(Element* element);
-	virtual StringList GetVariableNameList() const override;
+	Vector<DataAddress> GetVariableAddressList() const override;
 	bool Update(DataModel& model) override;
 	bool Initialize(DataModel& model, Element* element, const String& expression, const String& modifier) override;
 
@@ -53,6 +53,7 @@
 #include "EventDispatcher.h"
 #include "EventSpecification.h"
 #include "ElementDecoration.h"
+#include "LayoutCache.h"
 #include "LayoutEngine.h"
 #include "PluginRegistry.h"
 #include "PropertiesIterator.h"
@@ -70,6 +71,9 @@ namespace Rml {
 // Determines how many levels up in the hierarchy the OnChildAdd and OnChildRemove are called (starting at the child itself)
 static constexpr int ChildNotifyLevels = 2;
 
+// The index of the child currently being updated by its parent, used to find the preceding sibling to share style with.
+static size_t updating_child_index = 0;
+
 // Helper function to select scroll offset delta
 static float GetScrollOffsetDelta(ScrollAlignment alignment, float begin_offset, float end_offset)
 {
@@ -163,6 +167,9 @@ void Element::Update(float dp_ratio, Vector2f vp_dimensions)
 	RMLUI_ZoneText(name.c_str(), name.size());
 #endif
 
+	// Any nested updates below will overwrite the child index, so restore it before updating our properties.
+	const size_t child_index = updating_child_index;
+
 	OnUpdate();
 
 	HandleTransitionProperty();
@@ -171,6 +178,7 @@ void Element::Update(float dp_ratio, Vector2f vp_dimensions)
 
 	meta->scroll.Update();
 
+	updating_child_index = child_index;
 	UpdateProperties(dp_ratio, vp_dimensions);
 
 	// Do en extra pass over the animations and properties if the 'animation' property was just changed.
@@ -178,13 +186,17 @@ void Element::Update(float dp_ratio, Vector2f vp_dimensions)
 	{
 		HandleAnimationProperty();
 		AdvanceAnimations();
+		updating_child_index = child_index;
 		UpdateProperties(dp_ratio, vp_dimensions);
 	}
 
 	meta->decoration.InstanceDecorators();
 
 	for (size_t i = 0; i < children.size(); i++)
+	{
+		updating_child_index = i;
 		children[i]->Update(dp_ratio, vp_dimensions);
+	}
 
 	if(!animations.empty() && IsVisible(true)) {
 		if(Context* ctx = GetContext())
@@ -194,15 +206,30 @@ void Element::Update(float dp_ratio, Vector2f vp_dimensions)
 
 void Element::UpdateProperties(const float dp_ratio, const Vector2f vp_dimensions)
 {
-	UpdateDefinition();
+	// Siblings repeated from the same template usually resolve to the same style, in that case we reuse the preceding sibling's results.
+	// The child index is consumed here so that it only ever applies to the update it was set for.
+	Element* sibling = GetStyleSharingSibling(updating_child_index);
+	updating_child_index = 0;
+
+	UpdateDefinition(sibling);
 
 	if (meta->style.AnyPropertiesDirty())
 	{
-		const ComputedValues* parent_values = parent ? &parent->GetComputedValues() : nullptr;
-		const ComputedValues* document_values = owner_document ? &owner_document->GetComputedValues() : nullptr;
+		PropertyIdSet dirty_properties;
 
-		// Compute values and clear dirty properties
-		PropertyIdSet dirty_properties = meta->style.ComputeValues(meta->computed_values, parent_values, document_values, computed_values_are_default_initialized, dp_ratio, vp_dimensions);
+		if (sibling && meta->style.CanShareComputedValues(sibling->meta->style))
+		{
+			// Copy the sibling's values and clear dirty properties
+			dirty_properties = meta->style.ShareComputedValues(meta->computed_values, sibling->meta->computed_values);
+		}
+		else
+		{
+			const ComputedValues* parent_values = parent ? &parent->GetComputedValues() : nullptr;
+			const ComputedValues* document_values = owner_document ? &owner_document->GetComputedValues() : nullptr;
+
+			// Compute values and clear dirty properties
+			dirty_properties = meta->style.ComputeValues(meta->computed_values, parent_values, document_values, computed_values_are_default_initialized, dp_ratio, vp_dimensions);
+		}
 
 		computed_values_are_default_initialized = false;
 
@@ -356,7 +383,7 @@ String Element::GetAddress(bool include_pseudo_classes, bool include_parents) co
 		for (auto& pseudo_class : pseudo_classes)
 		{
 			address += ":";
-			address += pseudo_class.first;
+			address += AtomTable::GetName(pseudo_class.first);
 		}
 	}
 
@@ -478,6 +505,7 @@ void Element::SetBox(const Box& box)
 		additional_boxes.clear();
 
 		OnResize();
+		DirtyHitTestIndex();
 
 		meta->background_border.DirtyBackground();
 		meta->background_border.DirtyBorder();
@@ -491,6 +519,7 @@ void Element::AddBox(const Box& box, Vector2f offset)
 	additional_boxes.emplace_back(PositionedBox{ box, offset });
 
 	OnResize();
+	DirtyHitTestIndex();
 
 	meta->background_border.DirtyBackground();
 	meta->background_border.DirtyBorder();
@@ -813,7 +842,7 @@ StringList Element::GetActivePseudoClasses() const
 	names.reserve(pseudo_classes.size());
 	for (auto& pseudo_class : pseudo_classes)
 	{
-		names.push_back(pseudo_class.first);
+		names.push_back(AtomTable::GetName(pseudo_class.first));
 	}
 
 	return names;
@@ -1539,10 +1568,9 @@ Element* Element::GetElementById(const String& id)
 		return this->parent;
 	else
 	{
-		Element* search_root = GetOwnerDocument();
-		if (search_root == nullptr)
-			search_root = this;
-		return ElementUtilities::GetElementById(search_root, id);
+		if (ElementDocument* document = GetOwnerDocument())
+			return document->FindElementById(id);
+		return ElementUtilities::GetElementById(this, id);
 	}
 }
 
@@ -1716,6 +1744,10 @@ void Element::OnStyleSheetChange()
 {
 }
 
+void Element::OnTextureReload(const String& /*source*/)
+{
+}
+
 // Called when attributes on the element are changed.
 void Element::OnAttributeChange(const ElementAttributes& changed_attributes)
 {
@@ -1725,7 +1757,12 @@ void Element::OnAttributeChange(const ElementAttributes& changed_attributes)
 		const auto& value = element_attribute.second;
 		if (attribute == "id")
 		{
+			if (owner_document)
+				owner_document->RemoveFromIdIndex(this);
 			id = value.Get<String>();
+			meta->style.SetId(id);
+			if (owner_document)
+				owner_document->AddToIdIndex(this);
 		}
 		else if (attribute == "class")
 		{
@@ -1797,33 +1834,30 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 		changed_properties.Contains(PropertyId::Left)
 	);
 
-	// See if the document layout needs to be updated.
-	if (!IsLayoutDirty())
-	{
-		// Force a relayout if any of the changed properties require it.
-		const PropertyIdSet changed_properties_forcing_layout =
-			(changed_properties & StyleSheetSpecification::GetRegisteredPropertiesForcingLayout());
+	// Force a relayout if any of the changed properties require it. This is also done when the document layout is already dirty, the layout
+	// caches of this element and its ancestors must be cleared all the same.
+	const PropertyIdSet changed_properties_forcing_layout =
+		(changed_properties & StyleSheetSpecification::GetRegisteredPropertiesForcingLayout());
 
-		if (!changed_properties_forcing_layout.Empty())
-		{
+	if (!changed_properties_forcing_layout.Empty())
+	{
+		DirtyLayout();
+	}
+	else if (top_right_bottom_left_changed)
+	{
+		// Normally, the position properties only affect the position of the element and not the layout. Thus, these properties are not registered
+		// as affecting layout. However, when absolutely positioned elements with both left & right, or top & bottom are set to definite values,
+		// they affect the size of the element and thereby also the layout. This layout-dirtying condition needs to be registered manually.
+		using namespace Style;
+		const ComputedValues& computed = GetComputedValues();
+		const bool absolutely_positioned = (computed.position() == Position::Absolute || computed.position() == Position::Fixed);
+		const bool sized_width =
+			(computed.width().type == Width::Auto && computed.left().type != Left::Auto && computed.right().type != Right::Auto);
+		const bool sized_height =
+			(computed.height().type == Height::Auto && computed.top().type != Top::Auto && computed.bottom().type != Bottom::Auto);
+
+		if (absolutely_positioned && (sized_width || sized_height))
 			DirtyLayout();
-		}
-		else if (top_right_bottom_left_changed)
-		{
-			// Normally, the position properties only affect the position of the element and not the layout. Thus, these properties are not registered
-			// as affecting layout. However, when absolutely positioned elements with both left & right, or top & bottom are set to definite values,
-			// they affect the size of the element and thereby also the layout. This layout-dirtying condition needs to be registered manually.
-			using namespace Style;
-			const ComputedValues& computed = GetComputedValues();
-			const bool absolutely_positioned = (computed.position() == Position::Absolute || computed.position() == Position::Fixed);
-			const bool sized_width =
-				(computed.width().type == Width::Auto && computed.left().type != Left::Auto && computed.right().type != Right::Auto);
-			const bool sized_height =
-				(computed.height().type == Height::Auto && computed.top().type != Top::Auto && computed.bottom().type != Bottom::Auto);
-
-			if (absolutely_positioned && (sized_width || sized_height))
-				DirtyLayout();
-		}
 	}
 
 	// Update the position.
@@ -1855,6 +1889,8 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 	// Update the z-index.
 	if (changed_properties.Contains(PropertyId::ZIndex))
 	{
+		DirtyHitTestIndex();
+
 		Style::ZIndex z_index_property = meta->computed_values.z_index();
 
 		if (z_index_property.type == Style::ZIndex::Auto)
@@ -1986,8 +2022,28 @@ void Element::OnChildRemove(Element* /*child*/)
 
 void Element::DirtyLayout()
 {
-	if (Element* document = GetOwnerDocument())
-		document->DirtyLayout();
+	// Cached layout results of this element and its ancestors may all depend on the change.
+	for (Element* element = this; element; element = element->parent)
+	{
+		if (element->layout_cache)
+			element->layout_cache->Clear();
+	}
+
+	ElementDocument* document = GetOwnerDocument();
+	if (!document || document->IsLayoutDirty())
+		return;
+
+	// Changes to this element can only affect the layout up to the closest layout boundary strictly above it.
+	for (Element* ancestor = parent; ancestor && ancestor != document; ancestor = ancestor->parent)
+	{
+		if (LayoutEngine::IsLayoutBoundary(ancestor))
+		{
+			document->DirtyLayoutBoundary(ancestor);
+			return;
+		}
+	}
+
+	document->DirtyLayout();
 }
 
 bool Element::IsLayoutDirty()
@@ -2104,7 +2160,13 @@ void Element::SetOwnerDocument(ElementDocument* document)
 	// If this element is a document, then never change owner_document.
 	if (owner_document != this && owner_document != document)
 	{
+		// A document being destroyed no longer owns itself, its id index is gone by then.
+		if (owner_document && owner_document->owner_document == owner_document && !id.empty())
+			owner_document->RemoveFromIdIndex(this);
+
 		owner_document = document;
+		if (document && !id.empty())
+			document->AddToIdIndex(this);
 		for (ElementPtr& child : children)
 			child->SetOwnerDocument(document);
 	}
@@ -2129,6 +2191,34 @@ void Element::SetDataModel(DataModel* new_data_model)
 		child->SetDataModel(new_data_model);
 }
 
+bool Element::MoveChildBefore(Element* child, Element* adjacent_element)
+{
+	const auto dom_begin = children.begin();
+	const auto dom_end = children.begin() + GetNumChildren();
+	const auto find_child = [&](Element* element) {
+		return std::find_if(dom_begin, dom_end, [element](const ElementPtr& candidate) { return candidate.get() == element; });
+	};
+
+	const auto it_child = find_child(child);
+	const auto it_adjacent = (adjacent_element ? find_child(adjacent_element) : dom_end);
+	if (it_child == dom_end || (adjacent_element && it_adjacent == dom_end))
+		return false;
+
+	if (it_child == it_adjacent || it_child + 1 == it_adjacent)
+		return true;
+
+	if (it_child < it_adjacent)
+		std::rotate(it_child, it_child + 1, it_adjacent);
+	else
+		std::rotate(it_adjacent, it_child, it_child + 1);
+
+	DirtyLayout();
+	DirtyStackingContext();
+	DirtyDefinition(DirtyNodes::Self);
+
+	return true;
+}
+
 void Element::Release()
 {
 	if (instancer)
@@ -2144,6 +2234,9 @@ void Element::SetParent(Element* _parent)
 
 	parent = _parent;
 
+	// Adopt the new owner document first, dirtying the definition below looks up the context through it.
+	SetOwnerDocument(parent ? parent->GetOwnerDocument() : nullptr);
+
 	if (parent)
 	{
 		// We need to update our definition and make sure we inherit the properties of our new parent.
@@ -2155,8 +2248,6 @@ void Element::SetParent(Element* _parent)
 	if (transform_state || (parent && parent->transform_state))
 		DirtyTransformState(true, true);
 
-	SetOwnerDocument(parent ? parent->GetOwnerDocument() : nullptr);
-
 	if (!parent)
 	{
 		if (data_model)
@@ -2191,7 +2282,12 @@ void Element::SetParent(Element* _parent)
 void Element::DirtyAbsoluteOffset()
 {
 	if (!absolute_offset_dirty)
+	{
 		DirtyAbsoluteOffsetRecursive();
+		DirtyHitTestIndex();
+		if (Context* context = GetContext())
+			context->DirtyRender();
+	}
 }
 
 void Element::DirtyAbsoluteOffsetRecursive()
@@ -2289,6 +2385,13 @@ void Element::SetBaseline(float in_baseline)
 	baseline = in_baseline;
 }
 
+LayoutCache& Element::GetLayoutCache()
+{
+	if (!layout_cache)
+		layout_cache = MakeUnique<LayoutCache>();
+	return *layout_cache;
+}
+
 void Element::BuildLocalStackingContext()
 {
 	stacking_context_dirty = false;
@@ -2425,6 +2528,14 @@ void Element::DirtyStackingContext()
 
 	if (stacking_context_parent)
 		stacking_context_parent->stacking_context_dirty = true;
+
+	DirtyHitTestIndex();
+}
+
+void Element::DirtyHitTestIndex()
+{
+	if (owner_document)
+		owner_document->DirtyHitTestIndex();
 }
 
 void Element::DirtyDefinition(DirtyNodes dirty_nodes)
@@ -2433,16 +2544,26 @@ void Element::DirtyDefinition(DirtyNodes dirty_nodes)
 	{
 	case DirtyNodes::Self:
 		dirty_definition = true;
+		meta->style.DirtyPreparedDefinitions();
 		break;
 	case DirtyNodes::SelfAndSiblings:
 		dirty_definition = true;
 		if (parent)
+		{
 			parent->dirty_child_definitions = true;
+			for (const ElementPtr& child : parent->children)
+				child->meta->style.DirtyPreparedDefinitions();
+		}
+		else
+			meta->style.DirtyPreparedDefinitions();
 		break;
 	}
+
+	if (Context* context = GetContext())
+		context->DirtyRender();
 }
 
-void Element::UpdateDefinition()
+void Element::UpdateDefinition(Element* sibling)
 {
 	if (dirty_definition)
 	{
@@ -2453,7 +2574,7 @@ void Element::UpdateDefinition()
 		// combinators, but those are handled during the DirtyDefinition call.
 		dirty_child_definitions = true;
 
-		GetStyle()->UpdateDefinition();
+		GetStyle()->UpdateDefinition(sibling ? sibling->GetStyle() : nullptr);
 	}
 
 	if (dirty_child_definitions)
@@ -2465,6 +2586,20 @@ void Element::UpdateDefinition()
 }
 
 
+Element* Element::GetStyleSharingSibling(size_t index) const
+{
+	// The index may refer to another element if we were not updated from our parent's update loop.
+	if (!parent || index == 0 || index >= parent->children.size() || parent->children[index].get() != this)
+		return nullptr;
+
+	// The preceding sibling has been updated just before us, unless it was dirtied again in the meantime.
+	Element* sibling = parent->children[index - 1].get();
+	if (sibling->dirty_definition || sibling->computed_values_are_default_initialized)
+		return nullptr;
+
+	return sibling;
+}
+
 bool Element::Animate(const String & property_name, const Property & target_value, float duration, Tween tween, int num_iterations, bool alternate_direction, float delay, const Property* start_value)
 {
 	bool result = false;
@@ -2779,6 +2914,9 @@ void Element::DirtyTransformState(bool perspective_dirty, bool transform_dirty)
 {
 	dirty_perspective |= perspective_dirty;
 	dirty_transform |= transform_dirty;
+
+	if (Context* context = GetContext())
+		context->DirtyRender();
 }
 
 
@@ -2920,6 +3058,10 @@ void Element::UpdateTransformState()
 			transform_state->SetTransform(nullptr);
 
 		perspective_or_transform_changed |= (had_transform != have_transform);
+
+		// Transformed elements are tested separately from the spatial index.
+		if (had_transform != have_transform)
+			DirtyHitTestIndex();
 	}
 
 	// A change in perspective or transform will require an update to children transforms as well.
@@ -2961,6 +3103,12 @@ void Element::OnDpRatioChangeRecursive()
 		GetChild(i)->OnDpRatioChangeRecursive();
 }
 
+void Element::DirtyTexture(const String& source)
+{
+	meta->decoration.DirtyTexture(source);
+	OnTextureReload(source);
+}
+
 void Element::DirtyFontFaceRecursive()
 {
 	// Dirty the font size to force the element to update the face handle during the next Update(), and update any existing text geometry.
@@ -34,6 +34,8 @@
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/DecoratorInstancer.h"
 #include "../../Include/RmlUi/Core/StyleSheet.h"
+#include "../../Include/RmlUi/Core/Texture.h"
+#include "TextureDatabase.h"
 
 namespace Rml {
 
@@ -98,6 +100,12 @@ bool ElementDecoration::ReloadDecorators()
 			decorator_handle.decorator_data = 0;
 			decorator_handle.decorator = decorator;
 
+			for (int i = 0; i < decorator->GetNumTextures(); i++)
+			{
+				if (const Texture* texture = decorator->GetTexture(i))
+					TextureDatabase::AddTextureUser(texture->GetSource(), element);
+			}
+
 			decorators.push_back(std::move(decorator_handle));
 		}
 	}
@@ -129,6 +137,12 @@ void ElementDecoration::ReleaseDecorators()
 	{
 		if (decorator.decorator_data)
 			decorator.decorator->ReleaseElementData(decorator.decorator_data);
+
+		for (int i = 0; i < decorator.decorator->GetNumTextures(); i++)
+		{
+			if (const Texture* texture = decorator.decorator->GetTexture(i))
+				TextureDatabase::RemoveTextureUser(texture->GetSource(), element);
+		}
 	}
 
 	decorators.clear();
@@ -159,4 +173,20 @@ void ElementDecoration::DirtyDecoratorsData()
 	decorators_data_dirty = true;
 }
 
+void ElementDecoration::DirtyTexture(const String& source)
+{
+	for (const DecoratorHandle& decorator : decorators)
+	{
+		for (int i = 0; i < decorator.decorator->GetNumTextures(); i++)
+		{
+			const Texture* texture = decorator.decorator->GetTexture(i);
+			if (texture && texture->GetSource() == source)
+			{
+				DirtyDecoratorsData();
+				return;
+			}
+		}
+	}
+}
+
 } // namespace Rml
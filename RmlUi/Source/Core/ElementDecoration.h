@@ -60,6 +60,8 @@ public:
 	void DirtyDecorators();
 	/// Mark the element data of decorators as dirty.
 	void DirtyDecoratorsData();
+	/// Mark the element data of decorators as dirty if any of them uses the texture with the given source.
+	void DirtyTexture(const String& source);
 
 private:
 	// Releases existing decorators and loads all decorators required by the element's definition.
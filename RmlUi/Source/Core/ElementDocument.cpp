@@ -37,12 +37,15 @@
 #include "DocumentHeader.h"
 #include "ElementStyle.h"
 #include "EventDispatcher.h"
+#include "HitTestIndex.h"
+#include "LayoutCache.h"
 #include "LayoutEngine.h"
 #include "StreamFile.h"
 #include "StyleSheetFactory.h"
 #include "Template.h"
 #include "TemplateCache.h"
 #include "XMLParseTools.h"
+#include <algorithm>
 
 namespace Rml {
 
@@ -55,6 +58,8 @@ ElementDocument::ElementDocument(const String& tag) : Element(tag)
 
 	position_dirty = false;
 
+	hit_test_index = MakeUnique<HitTestIndex>();
+
 	ForceLocalStackingContext();
 	SetOwnerDocument(this);
 
@@ -63,6 +68,86 @@ ElementDocument::ElementDocument(const String& tag) : Element(tag)
 
 ElementDocument::~ElementDocument()
 {
+	// Our elements are detached after our members are destroyed, this tells them not to unregister from the id index then.
+	owner_document = nullptr;
+}
+
+void ElementDocument::AddToIdIndex(Element* element)
+{
+	const String& id = element->GetId();
+	if (id.empty())
+		return;
+
+	Vector<Element*>& elements = id_index[id];
+	if (std::find(elements.begin(), elements.end(), element) == elements.end())
+		elements.push_back(element);
+}
+
+void ElementDocument::RemoveFromIdIndex(Element* element)
+{
+	auto it = id_index.find(element->GetId());
+	if (it == id_index.end())
+		return;
+
+	Vector<Element*>& elements = it->second;
+	elements.erase(std::remove(elements.begin(), elements.end(), element), elements.end());
+	if (elements.empty())
+		id_index.erase(it);
+}
+
+// Returns true if the first element is visited before the second one in a breadth-first search of their document.
+static bool IsBeforeInBreadthFirstOrder(Element* element, Element* other)
+{
+	const auto get_depth = [](Element* e) {
+		int depth = 0;
+		for (; e; e = e->GetParentNode())
+			depth++;
+		return depth;
+	};
+
+	const int depth = get_depth(element);
+	const int other_depth = get_depth(other);
+	if (depth != other_depth)
+		return depth < other_depth;
+
+	// On the same level, the order is decided by the children of the closest common ancestor they descend from.
+	while (element->GetParentNode() != other->GetParentNode())
+	{
+		element = element->GetParentNode();
+		other = other->GetParentNode();
+	}
+
+	Element* parent = element->GetParentNode();
+	if (!parent)
+		return false;
+
+	for (int i = 0; i < parent->GetNumChildren(true); i++)
+	{
+		Element* child = parent->GetChild(i);
+		if (child == element)
+			return true;
+		if (child == other)
+			return false;
+	}
+
+	return false;
+}
+
+Element* ElementDocument::FindElementById(const String& id)
+{
+	auto it = id_index.find(id);
+	if (it == id_index.end())
+		return nullptr;
+
+	const Vector<Element*>& elements = it->second;
+	Element* result = elements[0];
+	for (size_t i = 1; i < elements.size(); i++)
+	{
+		if (IsBeforeInBreadthFirstOrder(elements[i], result))
+			result = elements[i];
+	}
+
+	return result;
 }
 
 void ElementDocument::ProcessHeader(const DocumentHeader* document_header)
@@ -416,10 +501,19 @@ void ElementDocument::UpdateDocument()
 }
 
 // Updates the layout if necessary.
-void ElementDocument::UpdateLayout()
+void ElementDocument::UpdateLayout(LayoutStats* stats)
 {
 	// Note: Carefully consider when to call this function for performance reasons.
 	// Ideally, only called once per update loop.
+	if (!layout_dirty && !dirty_layout_boundaries.empty())
+	{
+		RMLUI_ZoneScoped;
+		RMLUI_ZoneText(source_url.c_str(), source_url.size());
+
+		if (!FormatDirtyLayoutBoundaries(stats))
+			layout_dirty = true;
+	}
+
 	if(layout_dirty)
 	{
 		RMLUI_ZoneScoped;
@@ -431,10 +525,58 @@ void ElementDocument::UpdateLayout()
 
 		LayoutEngine::FormatElement(this, containing_block);
 
-		// Ignore dirtied layout during document formatting. Layouting must not require re-iteration.
-		// In particular, scrollbars being enabled may set the dirty flag, but this case is already handled within the layout engine.
-		layout_dirty = false;
+		if (stats)
+			stats->full_layouts += 1;
+	}
+
+	// Ignore dirtied layout during document formatting. Layouting must not require re-iteration.
+	// In particular, scrollbars being enabled may set the dirty flag, but this case is already handled within the layout engine.
+	layout_dirty = false;
+	dirty_layout_boundaries.clear();
+}
+
+bool ElementDocument::FormatDirtyLayoutBoundaries(LayoutStats* stats)
+{
+	Vector<ObserverPtr<Element>> boundaries;
+	boundaries.swap(dirty_layout_boundaries);
+
+	UnorderedSet<Element*> boundary_set;
+	for (const ObserverPtr<Element>& boundary : boundaries)
+	{
+		if (boundary)
+			boundary_set.insert(boundary.get());
+	}
+
+	UnorderedSet<Element*> formatted_set;
+	for (const ObserverPtr<Element>& boundary_ptr : boundaries)
+	{
+		Element* boundary = boundary_ptr.get();
+		if (!boundary || !formatted_set.insert(boundary).second)
+			continue;
+
+		// Boundaries nested inside another dirty boundary are formatted along with it. Meanwhile, the boundary may have been moved out of the
+		// document.
+		bool nested = false;
+		Element* ancestor = boundary->GetParentNode();
+		for (; ancestor && ancestor != this; ancestor = ancestor->GetParentNode())
+		{
+			if (boundary_set.count(ancestor) != 0)
+				nested = true;
+		}
+		if (!ancestor)
+			return false;
+		if (nested)
+			continue;
+
+		// The element may no longer be a boundary after its properties changed.
+		if (!LayoutEngine::IsLayoutBoundary(boundary) || !LayoutEngine::FormatLayoutBoundary(boundary))
+			return false;
+
+		if (stats)
+			stats->boundary_layouts += 1;
 	}
+
+	return true;
 }
 
 // Updates the position of the document based on the style properties.
@@ -476,14 +618,40 @@ void ElementDocument::UpdatePosition()
 	}
 }
 
+void ElementDocument::DirtyHitTestIndex()
+{
+	hit_test_index->MarkDirty();
+}
+
+Element* ElementDocument::FindElementAtPoint(Vector2f point, const Element* ignore_element)
+{
+	return hit_test_index->FindElementAtPoint(this, point, ignore_element);
+}
+
 void ElementDocument::DirtyPosition()
 {
 	position_dirty = true;
+	if (context)
+		context->DirtyRender();
+}
+
+void ElementDocument::DirtyLayoutBoundary(Element* boundary)
+{
+	if (dirty_layout_boundaries.empty() || dirty_layout_boundaries.back().get() != boundary)
+		dirty_layout_boundaries.push_back(boundary->GetObserverPtr());
+	if (context)
+		context->DirtyRender();
 }
 
 void ElementDocument::DirtyLayout()
 {
+	// The document is formatted from scratch, its own properties may have changed.
+	if (layout_cache)
+		layout_cache->Clear();
+
 	layout_dirty = true;
+	if (context)
+		context->DirtyRender();
 }
 
 bool ElementDocument::IsLayoutDirty()
@@ -65,6 +65,8 @@ inline PseudoClassState operator&(PseudoClassState lhs, PseudoClassState rhs)
 ElementStyle::ElementStyle(Element* _element)
 {
 	element = _element;
+	tag_atom = AtomTable::GetOrCreate(element->GetTagName());
+	id_atom = Atom::Invalid;
 }
 
 // Returns one of this element's properties.
@@ -169,17 +171,36 @@ void ElementStyle::TransitionPropertyChanges(Element* element, PropertyIdSet& pr
 	}
 }
 
-void ElementStyle::UpdateDefinition()
+void ElementStyle::UpdateDefinition(const ElementStyle* sibling)
 {
 	RMLUI_ZoneScoped;
 
 	SharedPtr<const ElementDefinition> new_definition;
+	bool new_sibling_shareable = false;
 
 	if (const StyleSheet* style_sheet = element->GetStyleSheet())
 	{
-		new_definition = style_sheet->GetElementDefinition(element);
+		if (prepared_style_sheet == style_sheet)
+		{
+			new_definition = std::move(prepared_definition);
+			new_sibling_shareable = prepared_sibling_shareable;
+		}
+		else if (sibling && sibling->definition_sibling_shareable && MatchesSameSelectors(*sibling))
+		{
+			new_definition = sibling->definition;
+			new_sibling_shareable = true;
+		}
+		else
+		{
+			new_definition = style_sheet->GetElementDefinition(element, &new_sibling_shareable);
+		}
 	}
 
+	definition_sibling_shareable = new_sibling_shareable;
+
+	prepared_definition.reset();
+	prepared_style_sheet = nullptr;
+
 	// Switch the property definitions if the definition has changed.
 	if (new_definition != definition)
 	{
@@ -214,6 +235,66 @@ void ElementStyle::UpdateDefinition()
 	}
 }
 
+void ElementStyle::PrepareDefinition(const StyleSheet* style_sheet)
+{
+	prepared_definition = style_sheet->GetElementDefinition(element, &prepared_sibling_shareable);
+	prepared_style_sheet = style_sheet;
+}
+
+void ElementStyle::DirtyPreparedDefinitions()
+{
+	prepared_definition.reset();
+	prepared_style_sheet = nullptr;
+
+	// Definitions are only prepared for elements with a valid ancestor filter, so an invalid filter means the whole subtree is already clear.
+	if (!ancestor_filter_valid)
+		return;
+
+	ancestor_filter_valid = false;
+
+	for (int i = 0; i < element->GetNumChildren(true); i++)
+		element->GetChild(i)->GetStyle()->DirtyPreparedDefinitions();
+}
+
+const AncestorFilter& ElementStyle::GetAncestorFilter()
+{
+	if (!ancestor_filter_valid)
+	{
+		ancestor_filter.Clear();
+
+		if (Element* parent = element->GetParentNode())
+		{
+			ElementStyle* parent_style = parent->GetStyle();
+			ancestor_filter = parent_style->GetAncestorFilter();
+
+			if (parent_style->tag_atom != Atom::Invalid)
+				ancestor_filter.Add(parent_style->tag_atom);
+			if (parent_style->id_atom != Atom::Invalid)
+				ancestor_filter.Add(parent_style->id_atom);
+			for (Atom class_name : parent_style->classes)
+				ancestor_filter.Add(class_name);
+		}
+
+		ancestor_filter_valid = true;
+	}
+
+	return ancestor_filter;
+}
+
+bool ElementStyle::MatchesSameSelectors(const ElementStyle& other) const
+{
+	if (tag_atom != other.tag_atom || id_atom != other.id_atom || classes != other.classes || pseudo_classes.size() != other.pseudo_classes.size())
+		return false;
+
+	for (const auto& pseudo_class : pseudo_classes)
+	{
+		if (other.pseudo_classes.find(pseudo_class.first) == other.pseudo_classes.end())
+			return false;
+	}
+
+	return true;
+}
+
 // Sets or removes a pseudo-class on the element.
 bool ElementStyle::SetPseudoClass(const String& pseudo_class, bool activate, bool override_class)
 {
@@ -221,13 +302,13 @@ bool ElementStyle::SetPseudoClass(const String& pseudo_class, bool activate, boo
 
 	if (activate)
 	{
-		PseudoClassState& state = pseudo_classes[pseudo_class];
+		PseudoClassState& state = pseudo_classes[AtomTable::GetOrCreate(pseudo_class)];
 		changed = (state == PseudoClassState::Clear);
 		state = (state | (override_class ? PseudoClassState::Override : PseudoClassState::Set));
 	}
 	else
 	{
-		auto it = pseudo_classes.find(pseudo_class);
+		auto it = pseudo_classes.find(AtomTable::Find(pseudo_class));
 		if (it != pseudo_classes.end())
 		{
 			PseudoClassState& state = it->second;
@@ -245,6 +326,11 @@ bool ElementStyle::SetPseudoClass(const String& pseudo_class, bool activate, boo
 
 // Checks if a specific pseudo-class has been set on the element.
 bool ElementStyle::IsPseudoClassSet(const String& pseudo_class) const
+{
+	return IsPseudoClassSet(AtomTable::Find(pseudo_class));
+}
+
+bool ElementStyle::IsPseudoClassSet(Atom pseudo_class) const
 {
 	return (pseudo_classes.count(pseudo_class) == 1);
 }
@@ -256,14 +342,18 @@ const PseudoClassMap& ElementStyle::GetActivePseudoClasses() const
 
 bool ElementStyle::SetClass(const String& class_name, bool activate)
 {
-	const auto class_location = std::find(classes.begin(), classes.end(), class_name);
+	const Atom class_atom = (activate ? AtomTable::GetOrCreate(class_name) : AtomTable::Find(class_name));
+	if (class_atom == Atom::Invalid)
+		return false;
+
+	const auto class_location = std::find(classes.begin(), classes.end(), class_atom);
 
 	bool changed = false;
 	if (activate)
 	{
 		if (class_location == classes.end())
 		{
-			classes.push_back(class_name);
+			classes.push_back(class_atom);
 			changed = true;
 		}
 	}
@@ -282,14 +372,24 @@ bool ElementStyle::SetClass(const String& class_name, bool activate)
 // Checks if a class is set on the element.
 bool ElementStyle::IsClassSet(const String& class_name) const
 {
-	return std::find(classes.begin(), classes.end(), class_name) != classes.end();
+	return IsClassSet(AtomTable::Find(class_name));
+}
+
+bool ElementStyle::IsClassSet(Atom class_name) const
+{
+	return class_name != Atom::Invalid && std::find(classes.begin(), classes.end(), class_name) != classes.end();
 }
 
 // Specifies the entire list of classes for this element. This will replace any others specified.
 void ElementStyle::SetClassNames(const String& class_names)
 {
+	StringList names;
+	StringUtilities::ExpandString(names, class_names, ' ');
+
 	classes.clear();
-	StringUtilities::ExpandString(classes, class_names, ' ');
+	classes.reserve(names.size());
+	for (const String& name : names)
+		classes.push_back(AtomTable::GetOrCreate(name));
 }
 
 // Returns the list of classes specified for this element.
@@ -302,17 +402,32 @@ String ElementStyle::GetClassNames() const
 		{
 			class_names += " ";
 		}
-		class_names += classes[i];
+		class_names += AtomTable::GetName(classes[i]);
 	}
 
 	return class_names;
 }
 
-const StringList& ElementStyle::GetClassNameList() const
+const AtomList& ElementStyle::GetClassAtomList() const
 {
 	return classes;
 }
 
+Atom ElementStyle::GetTagAtom() const
+{
+	return tag_atom;
+}
+
+void ElementStyle::SetId(const String& id)
+{
+	id_atom = AtomTable::GetOrCreate(id);
+}
+
+Atom ElementStyle::GetIdAtom() const
+{
+	return id_atom;
+}
+
 // Sets a local property override on the element to a pre-parsed value.
 bool ElementStyle::SetProperty(PropertyId id, const Property& property)
 {
@@ -455,6 +570,7 @@ float ElementStyle::ResolveLength(const Property* property, RelativeTarget relat
 void ElementStyle::DirtyInheritedProperties()
 {
 	dirty_properties |= StyleSheetSpecification::GetRegisteredInheritedProperties();
+	DirtyRender();
 }
 
 void ElementStyle::DirtyPropertiesWithUnits(Property::Unit units)
@@ -512,12 +628,21 @@ PropertiesIterator ElementStyle::Iterate() const {
 void ElementStyle::DirtyProperty(PropertyId id)
 {
 	dirty_properties.Insert(id);
+	DirtyRender();
 }
 
 // Sets a list of properties as dirty.
 void ElementStyle::DirtyProperties(const PropertyIdSet& properties)
 {
 	dirty_properties |= properties;
+	DirtyRender();
+}
+
+// Notifies the context that the element needs to be updated and rendered again.
+void ElementStyle::DirtyRender()
+{
+	if (Context* context = element->GetContext())
+		context->DirtyRender();
 }
 
 PropertyIdSet ElementStyle::ComputeValues(Style::ComputedValues& values, const Style::ComputedValues* parent_values, const Style::ComputedValues* document_values, bool values_are_default_initialized, float dp_ratio, Vector2f vp_dimensions)
@@ -823,6 +948,9 @@ PropertyIdSet ElementStyle::ComputeValues(Style::ComputedValues& values, const S
 		case PropertyId::OverscrollBehavior:
 			values.overscroll_behavior((OverscrollBehavior)p->Get<int>());
 			break;
+		case PropertyId::Contain:
+			values.contain((Contain)p->Get<int>());
+			break;
 		case PropertyId::PointerEvents:
 			values.pointer_events((PointerEvents)p->Get<int>());
 			break;
@@ -891,7 +1019,51 @@ PropertyIdSet ElementStyle::ComputeValues(Style::ComputedValues& values, const S
 			GetFontEngineInterface()->GetFontFaceHandle(values.font_family(), values.font_style(), values.font_weight(), (int)values.font_size()));
 	}
 
-	// Next, pass inheritable dirty properties onto our children
+	return TakeDirtyProperties();
+}
+
+bool ElementStyle::CanShareComputedValues(const ElementStyle& sibling) const
+{
+	return definition == sibling.definition && sibling.dirty_properties.Empty() &&
+		inline_properties.GetProperties() == sibling.inline_properties.GetProperties();
+}
+
+PropertyIdSet ElementStyle::ShareComputedValues(Style::ComputedValues& values, const Style::ComputedValues& sibling_values)
+{
+	if (dirty_properties.Empty())
+		return PropertyIdSet();
+
+	RMLUI_ZoneScopedC(0xFF7F50);
+
+	const float font_size_before = values.font_size();
+	const Style::LineHeight line_height_before = values.line_height();
+
+	values.CopyNonInherited(sibling_values);
+	values.CopyInherited(sibling_values);
+
+	// Extend the dirty properties the same way as ComputeValues() would.
+	if (font_size_before != values.font_size())
+	{
+		dirty_properties.Insert(PropertyId::LineHeight);
+
+		for (auto it = Iterate(); !it.AtEnd(); ++it)
+		{
+			auto name_property_pair = *it;
+			if (name_property_pair.second.unit == Property::EM)
+				dirty_properties.Insert(name_property_pair.first);
+		}
+	}
+
+	if (dirty_properties.Contains(PropertyId::LineHeight) &&
+		(line_height_before.value != values.line_height().value || line_height_before.inherit_value != values.line_height().inherit_value))
+		dirty_properties.Insert(PropertyId::VerticalAlign);
+
+	return TakeDirtyProperties();
+}
+
+PropertyIdSet ElementStyle::TakeDirtyProperties()
+{
+	// Pass inheritable dirty properties onto our children
 	PropertyIdSet dirty_inherited_properties = (dirty_properties & StyleSheetSpecification::GetRegisteredInheritedProperties());
 
 	if (!dirty_inherited_properties.Empty())
@@ -33,15 +33,18 @@
 #include "../../Include/RmlUi/Core/Types.h"
 #include "../../Include/RmlUi/Core/PropertyIdSet.h"
 #include "../../Include/RmlUi/Core/PropertyDictionary.h"
+#include "AncestorFilter.h"
+#include "Atom.h"
 
 namespace Rml {
 
 class ElementDefinition;
+class StyleSheet;
 class PropertiesIterator;
 enum class RelativeTarget;
 
 enum class PseudoClassState : std::uint8_t { Clear = 0, Set = 1, Override = 2 };
-using PseudoClassMap = SmallUnorderedMap< String, PseudoClassState >;
+using PseudoClassMap = SmallUnorderedMap< Atom, PseudoClassState >;
 
 
 /**
@@ -57,7 +60,21 @@ public:
 	ElementStyle(Element* element);
 
 	/// Update this definition if required
-	void UpdateDefinition();
+	/// @param[in] sibling The style of a preceding sibling with an up-to-date definition, if any. Its definition is reused instead of matching the
+	///		style sheet when it matches the same selectors as this element.
+	void UpdateDefinition(const ElementStyle* sibling = nullptr);
+
+	/// Matches the element's definition ahead of the next call to UpdateDefinition(), which then uses the result unless the definition was
+	/// dirtied in the meantime. This only reads the element hierarchy, so it may be called concurrently for different elements.
+	void PrepareDefinition(const StyleSheet* style_sheet);
+	/// Invalidates the definitions matched by PrepareDefinition() and the ancestor filters of this element and all its descendants, called
+	/// whenever a definition that may affect them is dirtied.
+	void DirtyPreparedDefinitions();
+
+	/// Returns a filter of the interned tag, id and class names of all the element's ancestors. The filter is rebuilt lazily from the parent's
+	/// filter after the definition of the element or an ancestor has been dirtied, since any change to these names or to the hierarchy dirties
+	/// a definition.
+	const AncestorFilter& GetAncestorFilter();
 
 	/// Sets or removes a pseudo-class on the element.
 	/// @param[in] pseudo_class The pseudo class to activate or deactivate.
@@ -70,6 +87,8 @@ public:
 	/// @param[in] pseudo_class The name of the pseudo-class to check for.
 	/// @return True if the pseudo-class is set on the element, false if not.
 	bool IsPseudoClassSet(const String& pseudo_class) const;
+	/// Checks if a specific pseudo-class has been set on the element, given its interned name.
+	bool IsPseudoClassSet(Atom pseudo_class) const;
 	/// Gets a list of the current active pseudo classes
 	const PseudoClassMap& GetActivePseudoClasses() const;
 
@@ -82,14 +101,23 @@ public:
 	/// @param[in] class_name The name of the class to check for.
 	/// @return True if the class is set on the element, false otherwise.
 	bool IsClassSet(const String& class_name) const;
+	/// Checks if a class is set on the element, given its interned name.
+	bool IsClassSet(Atom class_name) const;
 	/// Specifies the entire list of classes for this element. This will replace any others specified.
 	/// @param[in] class_names The list of class names to set on the style, separated by spaces.
 	void SetClassNames(const String& class_names);
 	/// Return the active class list.
 	/// @return A string containing all the classes on the element, separated by spaces.
 	String GetClassNames() const;
-	/// Return the active class list.
-	const StringList& GetClassNameList() const;
+	/// Return the interned names of the active class list.
+	const AtomList& GetClassAtomList() const;
+
+	/// Returns the interned tag name of the element.
+	Atom GetTagAtom() const;
+	/// Updates the interned id of the element, called whenever the element's id attribute changes.
+	void SetId(const String& id);
+	/// Returns the interned id of the element, or the invalid atom if it has no id.
+	Atom GetIdAtom() const;
 
 	/// Sets a local property override on the element to a pre-parsed value.
 	/// @param[in] name The name of the new property.
@@ -136,6 +164,13 @@ public:
 	/// Returns true if any properties are dirty such that computed values need to be recomputed
 	bool AnyPropertiesDirty() const;
 
+	/// Returns true if the computed values of the given sibling equal the values this element would compute, that is, both elements have the same
+	/// definition and inline properties, and the sibling's values are up to date.
+	bool CanShareComputedValues(const ElementStyle& sibling) const;
+	/// Copies the computed values of a sibling for which CanShareComputedValues() holds, in place of ComputeValues().
+	/// @return The dirty properties, as returned by ComputeValues().
+	PropertyIdSet ShareComputedValues(Style::ComputedValues& values, const Style::ComputedValues& sibling_values);
+
 	/// Turns the local and inherited properties into computed values for this element. These values can in turn be used during the layout procedure.
 	/// Must be called in correct order, always parent before its children.
 	PropertyIdSet ComputeValues(Style::ComputedValues& values, const Style::ComputedValues* parent_values, const Style::ComputedValues* document_values, bool values_are_default_initialized, float dp_ratio, Vector2f vp_dimensions);
@@ -147,16 +182,26 @@ public:
 private:
 	// Sets a list of properties as dirty.
 	void DirtyProperties(const PropertyIdSet& properties);
+	// Notifies the element's context that it needs to be rendered again.
+	void DirtyRender();
+	// Passes the inherited dirty properties on to the children, then returns and clears the dirty properties.
+	PropertyIdSet TakeDirtyProperties();
 
 	static const Property* GetLocalProperty(PropertyId id, const PropertyDictionary & inline_properties, const ElementDefinition * definition);
 	static const Property* GetProperty(PropertyId id, const Element * element, const PropertyDictionary & inline_properties, const ElementDefinition * definition);
+	// Returns true if both elements have the same tag, id, classes and pseudo-classes.
+	bool MatchesSameSelectors(const ElementStyle& other) const;
+
 	static void TransitionPropertyChanges(Element * element, PropertyIdSet & properties, const PropertyDictionary & inline_properties, const ElementDefinition * old_definition, const ElementDefinition * new_definition);
 
 	// Element these properties belong to
 	Element* element;
 
+	// The interned tag name and id of the element.
+	Atom tag_atom;
+	Atom id_atom;
 	// The list of classes applicable to this object.
-	StringList classes;
+	AtomList classes;
 	// This element's current pseudo-classes.
 	PseudoClassMap pseudo_classes;
 
@@ -164,6 +209,17 @@ private:
 	PropertyDictionary inline_properties;
 	// The definition of this element, provides applicable properties from the stylesheet.
 	SharedPtr<const ElementDefinition> definition;
+	// True if the definition applies to any sibling matching the same selectors.
+	bool definition_sibling_shareable = false;
+
+	// Names of all our ancestors. Our filter is only ever valid while our parent's filter is, thus all our descendants are invalid while we are.
+	AncestorFilter ancestor_filter;
+	bool ancestor_filter_valid = false;
+
+	// Definition matched ahead of time by PrepareDefinition(), along with the style sheet it was matched with.
+	SharedPtr<const ElementDefinition> prepared_definition;
+	const StyleSheet* prepared_style_sheet = nullptr;
+	bool prepared_sibling_shareable = false;
 
 	PropertyIdSet dirty_properties;
 };
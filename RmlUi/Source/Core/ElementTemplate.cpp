@@ -0,0 +1,312 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "ElementTemplate.h"
+#include "XMLParseTools.h"
+#include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/ElementText.h"
+#include "../../Include/RmlUi/Core/ElementUtilities.h"
+#include "../../Include/RmlUi/Core/Factory.h"
+#include "../../Include/RmlUi/Core/Log.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "../../Include/RmlUi/Core/StreamMemory.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
+#include "../../Include/RmlUi/Core/SystemInterface.h"
+#include "../../Include/RmlUi/Core/XMLParser.h"
+#include <algorithm>
+
+namespace Rml {
+
+using ElementTemplateCache = UnorderedMap<String, WeakPtr<const ElementTemplate>>;
+static ElementTemplateCache template_cache;
+
+// Scans the text the same way as Factory::InstanceElementText. Returns false if the text contains invalid data brackets.
+static bool ScanText(const String& text, bool& parse_as_rml, bool& has_data_expression)
+{
+	parse_as_rml = false;
+	has_data_expression = false;
+
+	bool inside_brackets = false;
+	bool inside_string = false;
+	char previous = 0;
+	for (const char c : text)
+	{
+		if (XMLParseTools::ParseDataBrackets(inside_brackets, inside_string, c, previous))
+			return false;
+
+		if (inside_brackets)
+			has_data_expression = true;
+		else if (c == '<')
+			parse_as_rml = true;
+
+		previous = c;
+	}
+
+	return true;
+}
+
+// Returns true if the system interface translates the text to something else.
+static bool IsTranslated(const String& text)
+{
+	SystemInterface* system_interface = GetSystemInterface();
+	if (!system_interface)
+		return false;
+
+	String translated;
+	system_interface->TranslateString(translated, text);
+	return translated != text;
+}
+
+/**
+	Records the nodes of the parsed RML, mirroring the choices made by the XML parser and the default node handler.
+ */
+class ElementTemplateParser : public BaseXMLParser {
+public:
+	ElementTemplateParser(ElementTemplate& element_template) : element_template(element_template)
+	{
+		RegisterCDATATag("script");
+		RegisterCDATATag("style");
+
+		for (const String& name : Factory::GetStructuralDataViewAttributeNames())
+			RegisterInnerXMLAttribute(name);
+
+		stack.push_back(&element_template.nodes);
+	}
+
+	void HandleElementStart(const String& name, const XMLAttributes& attributes) override
+	{
+		using Node = ElementTemplate::Node;
+
+		String tag = StringUtilities::ToLower(name);
+
+		// The root tag is the body wrapping the contents, its handler only passes on the children to the default handler.
+		if (depth++ == 0)
+			return;
+
+		// Elements with custom node handlers can only be constructed by the XML parser.
+		if (XMLParser::GetNodeHandler(tag))
+			element_template.use_parser = true;
+
+		Vector<Node>& siblings = *stack.back();
+		siblings.emplace_back();
+		Node& node = siblings.back();
+		node.type = ElementTemplate::NodeType::Element;
+		node.value = std::move(tag);
+		node.attributes = attributes;
+
+		stack.push_back(&node.children);
+	}
+
+	void HandleElementEnd(const String& /*name*/) override
+	{
+		if (--depth > 0)
+			stack.pop_back();
+	}
+
+	void HandleData(const String& data, XMLDataType type) override
+	{
+		using Node = ElementTemplate::Node;
+
+		Vector<Node>& siblings = *stack.back();
+
+		if (type == XMLDataType::InnerXML && depth > 1)
+		{
+			Node node;
+			node.type = ElementTemplate::NodeType::InnerRml;
+			node.value = data;
+			siblings.push_back(std::move(node));
+			return;
+		}
+
+		bool parse_as_rml = false, has_data_expression = false;
+		if (!ScanText(data, parse_as_rml, has_data_expression) || parse_as_rml)
+		{
+			// Let the factory deal with the text during instancing, including logging any errors.
+			Node node;
+			node.type = ElementTemplate::NodeType::Rml;
+			node.value = data;
+			siblings.push_back(std::move(node));
+			return;
+		}
+
+		if (std::all_of(data.begin(), data.end(), &StringUtilities::IsWhitespace))
+			return;
+
+		Node node;
+		node.type = ElementTemplate::NodeType::Text;
+		node.value = data;
+		node.decoded_text = StringUtilities::DecodeRml(data);
+		node.has_data_expression = has_data_expression;
+		node.translated = IsTranslated(data);
+		siblings.push_back(std::move(node));
+	}
+
+private:
+	ElementTemplate& element_template;
+	Vector<Vector<ElementTemplate::Node>*> stack;
+	int depth = 0;
+};
+
+SharedPtr<const ElementTemplate> ElementTemplate::Compile(const String& rml)
+{
+	auto it = template_cache.find(rml);
+	if (it != template_cache.end())
+	{
+		if (SharedPtr<const ElementTemplate> result = it->second.lock())
+			return result;
+	}
+
+	// Remove the templates which are no longer in use.
+	for (auto it_expired = template_cache.begin(); it_expired != template_cache.end();)
+	{
+		if (it_expired->second.expired())
+			it_expired = template_cache.erase(it_expired);
+		else
+			++it_expired;
+	}
+
+	SharedPtr<const ElementTemplate> result = MakeShared<const ElementTemplate>(rml);
+	template_cache[rml] = result;
+	return result;
+}
+
+ElementTemplate::ElementTemplate(const String& in_rml) : rml(in_rml)
+{
+	RMLUI_ZoneScoped;
+
+	// The factory translates the contents as a whole before parsing them.
+	bool parse_as_rml = false, has_data_expression = false;
+	if (!ScanText(rml, parse_as_rml, has_data_expression) || IsTranslated(rml))
+	{
+		use_parser = true;
+		return;
+	}
+
+	if (!parse_as_rml)
+	{
+		if (!std::all_of(rml.begin(), rml.end(), &StringUtilities::IsWhitespace))
+		{
+			Node node;
+			node.type = NodeType::Text;
+			node.value = rml;
+			node.decoded_text = StringUtilities::DecodeRml(rml);
+			node.has_data_expression = has_data_expression;
+			nodes.push_back(std::move(node));
+		}
+		return;
+	}
+
+	// Parse the contents wrapped in a body tag, as done by Factory::InstanceElementText.
+	auto stream = MakeUnique<StreamMemory>(rml.size() + 32);
+	const String open_tag = "<body>";
+	const String close_tag = "</body>";
+	stream->Write(open_tag.c_str(), open_tag.size());
+	stream->Write(rml);
+	stream->Write(close_tag.c_str(), close_tag.size());
+	stream->Seek(0, SEEK_SET);
+
+	ElementTemplateParser parser(*this);
+	parser.Parse(stream.get());
+
+	if (use_parser)
+		nodes.clear();
+}
+
+void ElementTemplate::Instance(Element* parent) const
+{
+	RMLUI_ZoneScoped;
+	RMLUI_ASSERT(parent);
+
+	if (use_parser)
+	{
+		if (!rml.empty())
+			Factory::InstanceElementText(parent, rml);
+		return;
+	}
+
+	InstanceNodes(parent, nodes);
+}
+
+void ElementTemplate::InstanceNodes(Element* parent, const Vector<Node>& nodes)
+{
+	for (const Node& node : nodes)
+	{
+		switch (node.type)
+		{
+		case NodeType::Element:
+		{
+			ElementPtr element = Factory::InstanceElement(parent, node.value, node.value, node.attributes);
+			if (!element)
+			{
+				Log::Message(Log::LT_ERROR, "Failed to create element for tag %s, instancer returned nullptr.", node.value.c_str());
+				InstanceNodes(parent, node.children);
+				break;
+			}
+
+			Element* child = parent->AppendChild(std::move(element));
+			InstanceNodes(child, node.children);
+		}
+		break;
+		case NodeType::Text:
+		{
+			if (node.translated)
+			{
+				Factory::InstanceElementText(parent, node.value);
+				break;
+			}
+
+			XMLAttributes attributes;
+			if (node.has_data_expression)
+				attributes.emplace("data-text", Variant());
+
+			ElementPtr element = Factory::InstanceElement(parent, "#text", "#text", attributes);
+			ElementText* text_element = rmlui_dynamic_cast<ElementText*>(element.get());
+			if (!text_element)
+			{
+				Log::Message(Log::LT_ERROR, "Failed to instance text element '%s', was expecting a derivative of ElementText.", node.value.c_str());
+				break;
+			}
+
+			text_element->SetText(node.decoded_text);
+			parent->AppendChild(std::move(element));
+		}
+		break;
+		case NodeType::Rml:
+			Factory::InstanceElementText(parent, node.value);
+			break;
+		case NodeType::InnerRml:
+			// Structural data views use the raw inner contents of the node, as in the default node handler.
+			if (!ElementUtilities::ApplyStructuralDataViews(parent, node.value))
+				Factory::InstanceElementText(parent, node.value);
+			break;
+		}
+	}
+}
+
+} // namespace Rml
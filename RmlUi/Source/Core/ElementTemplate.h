@@ -0,0 +1,85 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_ELEMENTTEMPLATE_H
+#define RMLUI_CORE_ELEMENTTEMPLATE_H
+
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class Element;
+
+/**
+	A compiled, immutable tree of RML contents, used by data-for views to instance their rows.
+
+	The contents are parsed once into element, text and structural data view nodes. The text is decoded and scanned for data expressions
+	up-front, so that instancing only constructs elements and attaches their data views. Translations are looked up when compiling,
+	contents which are changed by the translation are instanced by the factory instead. Contents with elements which are
+	handled by custom node handlers, such as 'select' or 'tabset', cannot be replayed outside the XML parser and are parsed on every
+	instancing instead.
+ */
+
+class ElementTemplate : NonCopyMoveable {
+public:
+	/// Returns the compiled template of the given RML contents. Templates are shared between all users of identical contents.
+	static SharedPtr<const ElementTemplate> Compile(const String& rml);
+
+	/// Instances the contents of the template as children of the given element.
+	void Instance(Element* parent) const;
+
+	ElementTemplate(const String& rml);
+
+private:
+	enum class NodeType { Element, Text, Rml, InnerRml };
+
+	struct Node {
+		NodeType type = NodeType::Element;
+		// The tag name of elements, or the untranslated contents of all other node types.
+		String value;
+		// The decoded contents of text nodes.
+		String decoded_text;
+		XMLAttributes attributes;
+		bool has_data_expression = false;
+		// Set for text nodes changed by the translation, these are instanced by the factory.
+		bool translated = false;
+		Vector<Node> children;
+	};
+
+	static void InstanceNodes(Element* parent, const Vector<Node>& nodes);
+
+	String rml;
+	bool use_parser = false;
+	Vector<Node> nodes;
+
+	friend class ElementTemplateParser;
+};
+
+} // namespace Rml
+#endif
@@ -418,6 +418,10 @@ static bool ApplyDataViewsControllersInternal(Element* element, const bool const
 				// Structural data views are applied in a separate step from the normal views and controllers.
 				if (construct_structural_view)
 				{
+					// Attributes with a modifier, such as 'data-for-key', are read by the structural view itself.
+					if (type_end != String::npos)
+						continue;
+
 					if (DataViewPtr view = Factory::InstanceDataView(type_name, element, true))
 					{
 						initializer.modifier_or_inner_rml = structural_view_inner_rml;
@@ -48,6 +48,7 @@ ElementImage::ElementImage(const String& tag) : Element(tag), dimensions(-1, -1)
 
 ElementImage::~ElementImage()
 {
+	TextureDatabase::RemoveTextureUser(texture.GetSource(), this);
 }
 
 // Sizes the box to the element's inherent size.
@@ -166,6 +167,15 @@ void ElementImage::OnDpRatioChange()
 	DirtyLayout();
 }
 
+void ElementImage::OnTextureReload(const String& source)
+{
+	if (texture.GetSource() == source)
+	{
+		texture_dirty = true;
+		DirtyLayout();
+	}
+}
+
 void ElementImage::OnStyleSheetChange()
 {
 	if (HasAttribute("sprite"))
@@ -223,6 +233,9 @@ void ElementImage::GenerateGeometry()
 
 bool ElementImage::LoadTexture()
 {
+	// Registered again below with the new texture, unless loading fails.
+	TextureDatabase::RemoveTextureUser(texture.GetSource(), this);
+
 	texture_dirty = false;
 	geometry_dirty = true;
 	dimensions_scale = 1.0f;
@@ -283,6 +296,7 @@ bool ElementImage::LoadTexture()
 
 	// Set the texture onto our geometry object.
 	geometry.SetTexture(&texture);
+	TextureDatabase::AddTextureUser(texture.GetSource(), this);
 
 	return true;
 }
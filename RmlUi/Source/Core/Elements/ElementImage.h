@@ -85,6 +85,9 @@ protected:
 	/// Our intrinsic dimensions may change with the dp-ratio.
 	void OnDpRatioChange() override;
 
+	/// Reloads the image if it displays the given texture.
+	void OnTextureReload(const String& source) override;
+
 	/// The sprite may have changed when the style sheet is recompiled.
 	void OnStyleSheetChange() override;
 
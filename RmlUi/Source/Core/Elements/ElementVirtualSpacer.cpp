@@ -0,0 +1,143 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "ElementVirtualSpacer.h"
+#include "../../../Include/RmlUi/Core/Event.h"
+#include "../../../Include/RmlUi/Core/Math.h"
+#include "../../../Include/RmlUi/Core/Property.h"
+
+namespace Rml {
+
+ElementVirtualSpacer::ElementVirtualSpacer(const String& tag) : Element(tag)
+{
+	SetProperty(PropertyId::Display, Property(Style::Display::Block));
+	SetProperty(PropertyId::Height, Property(0.f, Property::PX));
+}
+
+ElementVirtualSpacer::~ElementVirtualSpacer()
+{
+}
+
+void ElementVirtualSpacer::SetRangeCallback(Function<void()> callback)
+{
+	range_callback = std::move(callback);
+}
+
+void ElementVirtualSpacer::SetRows(int _num_rows, float _row_height)
+{
+	num_rows = _num_rows;
+	row_height = _row_height;
+}
+
+void ElementVirtualSpacer::GetRowRange(int& out_first, int& out_last)
+{
+	CalculateRowRange(range_first, range_last);
+	out_first = range_first;
+	out_last = range_last;
+}
+
+void ElementVirtualSpacer::DirtyRowRange()
+{
+	range_first = -1;
+	range_last = -1;
+}
+
+void ElementVirtualSpacer::SetSpacerHeight(float height)
+{
+	if (height != spacer_height)
+	{
+		spacer_height = height;
+		SetProperty(PropertyId::Height, Property(height, Property::PX));
+	}
+}
+
+void ElementVirtualSpacer::OnUpdate()
+{
+	// The parent is sized only after its children have been laid out, so a change to its viewport is first seen here.
+	CheckRowRange();
+}
+
+void ElementVirtualSpacer::OnLayout()
+{
+	CheckRowRange();
+}
+
+void ElementVirtualSpacer::OnChildAdd(Element* child)
+{
+	// Listen for scrolling of the parent, for which we are notified of being added and removed from.
+	if (child == this)
+		GetParentNode()->AddEventListener(EventId::Scroll, this);
+}
+
+void ElementVirtualSpacer::OnChildRemove(Element* child)
+{
+	if (child == this)
+		GetParentNode()->RemoveEventListener(EventId::Scroll, this);
+}
+
+void ElementVirtualSpacer::ProcessEvent(Event& event)
+{
+	if (event == EventId::Scroll && event.GetTargetElement() == GetParentNode())
+		CheckRowRange();
+}
+
+void ElementVirtualSpacer::CalculateRowRange(int& out_first, int& out_last)
+{
+	// The number of rows instanced beyond each edge of the viewport.
+	constexpr int overscan = 2;
+
+	out_first = 0;
+	out_last = 0;
+
+	Element* parent = GetParentNode();
+	if (!parent || num_rows <= 0 || row_height <= 0.f)
+		return;
+
+	// The absolute offsets include the scroll offset of the parent, thus this is the negative scroll position within the list.
+	const float list_offset = GetAbsoluteOffset(Box::BORDER).y - parent->GetAbsoluteOffset(Box::PADDING).y;
+	const float viewport_height = parent->GetClientHeight();
+
+	const int first_visible = Math::Clamp(Math::RoundDownToInteger(-list_offset / row_height), 0, num_rows);
+	const int num_visible = Math::RoundUpToInteger(viewport_height / row_height) + 1;
+
+	out_first = Math::Max(first_visible - overscan, 0);
+	out_last = Math::Min(first_visible + num_visible + overscan, num_rows);
+}
+
+void ElementVirtualSpacer::CheckRowRange()
+{
+	if (!range_callback)
+		return;
+
+	int first = 0, last = 0;
+	CalculateRowRange(first, last);
+	if (first != range_first || last != range_last)
+		range_callback();
+}
+
+} // namespace Rml
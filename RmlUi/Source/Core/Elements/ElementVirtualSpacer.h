@@ -0,0 +1,90 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_ELEMENTS_ELEMENTVIRTUALSPACER_H
+#define RMLUI_CORE_ELEMENTS_ELEMENTVIRTUALSPACER_H
+
+#include "../../../Include/RmlUi/Core/Header.h"
+#include "../../../Include/RmlUi/Core/Element.h"
+#include "../../../Include/RmlUi/Core/EventListener.h"
+
+
+namespace Rml {
+
+/**
+	An empty block standing in for the rows of a virtualized data-for view which are not instanced, keeping the scroll geometry of the
+	parent intact. The spacer placed before the rows also tracks the range of rows in the viewport of the parent, and notifies its owner
+	when the range changes after layout or when scrolled.
+ */
+
+class ElementVirtualSpacer : public Element, public EventListener
+{
+public:
+	RMLUI_RTTI_DefineWithParent(ElementVirtualSpacer, Element)
+
+	ElementVirtualSpacer(const String& tag);
+	virtual ~ElementVirtualSpacer();
+
+	/// Sets the function to call when the range of rows in the viewport changes, or clears it when empty.
+	void SetRangeCallback(Function<void()> callback);
+
+	/// Sets the number of rows and their height, starting at the top of this spacer.
+	void SetRows(int num_rows, float row_height);
+	/// Returns the range of rows to instance for the current viewport of the parent. The range is remembered, later changes to it are
+	/// reported through the range callback.
+	void GetRowRange(int& out_first, int& out_last);
+	/// Forgets the range last returned, so that the range callback is called after the next layout.
+	void DirtyRowRange();
+
+	/// Sets the height of the space taken by the spacer.
+	void SetSpacerHeight(float height);
+
+protected:
+	void OnUpdate() override;
+	void OnLayout() override;
+	void OnChildAdd(Element* child) override;
+	void OnChildRemove(Element* child) override;
+
+	void ProcessEvent(Event& event) override;
+
+private:
+	void CalculateRowRange(int& out_first, int& out_last);
+	// Calls back if the range of rows differs from the one last returned.
+	void CheckRowRange();
+
+	Function<void()> range_callback;
+	float spacer_height = 0.f;
+
+	int num_rows = 0;
+	float row_height = 0.f;
+	int range_first = 0;
+	int range_last = 0;
+};
+
+} // namespace Rml
+#endif
@@ -81,6 +81,7 @@
 #include "Elements/ElementImage.h"
 #include "Elements/ElementLabel.h"
 #include "Elements/ElementTextSelection.h"
+#include "Elements/ElementVirtualSpacer.h"
 #include "Elements/XMLNodeHandlerDataGrid.h"
 #include "Elements/XMLNodeHandlerSelect.h"
 #include "Elements/XMLNodeHandlerTabSet.h"
@@ -157,6 +158,8 @@ struct DefaultInstancers {
 	ElementInstancerGeneric<ElementDataGridCell> datagrid_cell;
 	ElementInstancerGeneric<ElementDataGridRow> datagrid_row;
 
+	ElementInstancerGeneric<ElementVirtualSpacer> virtual_spacer;
+
 	// Decorators
 	DecoratorTiledHorizontalInstancer decorator_tiled_horizontal;
 	DecoratorTiledVerticalInstancer decorator_tiled_vertical;
@@ -251,6 +254,8 @@ bool Factory::Initialise()
 	RegisterElementInstancer("#rmlctl_datagridcell", &default_instancers->datagrid_cell);
 	RegisterElementInstancer("#rmlctl_datagridrow", &default_instancers->datagrid_row);
 
+	RegisterElementInstancer("#rmlctl_virtualspacer", &default_instancers->virtual_spacer);
+
 	// Decorator instancers
 	RegisterDecoratorInstancer("tiled-horizontal", &default_instancers->decorator_tiled_horizontal);
 	RegisterDecoratorInstancer("tiled-vertical", &default_instancers->decorator_tiled_vertical);
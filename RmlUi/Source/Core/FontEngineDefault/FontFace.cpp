@@ -33,11 +33,12 @@
 
 namespace Rml {
 
-FontFace::FontFace(FontFaceHandleFreetype _face, Style::FontStyle _style, Style::FontWeight _weight)
+FontFace::FontFace(FontFaceHandleFreetype _face, Style::FontStyle _style, Style::FontWeight _weight, uint64_t _face_hash)
 {
 	style = _style;
 	weight = _weight;
 	face = _face;
+	face_hash = _face_hash;
 }
 
 FontFace::~FontFace()
@@ -73,7 +74,7 @@ FontFaceHandleDefault* FontFace::GetHandle(int size, bool load_default_glyphs)
 
 	// Construct and initialise the new handle.
 	auto handle = MakeUnique<FontFaceHandleDefault>();
-	if (!handle->Initialize(face, size, load_default_glyphs))
+	if (!handle->Initialize(face, face_hash, size, load_default_glyphs))
 	{
 		handles[size] = nullptr;
 		return nullptr;
@@ -92,4 +93,13 @@ void FontFace::ReleaseFontResources()
 	HandleMap().swap(handles);
 }
 
+void FontFace::GetHandles(Vector<const FontFaceHandleDefault*>& out_handles) const
+{
+	for (auto& pair : handles)
+	{
+		if (pair.second)
+			out_handles.push_back(pair.second.get());
+	}
+}
+
 } // namespace Rml
@@ -43,7 +43,7 @@ class FontFaceHandleDefault;
 class FontFace
 {
 public:
-	FontFace(FontFaceHandleFreetype face, Style::FontStyle style, Style::FontWeight weight);
+	FontFace(FontFaceHandleFreetype face, Style::FontStyle style, Style::FontWeight weight, uint64_t face_hash);
 	~FontFace();
 
 	Style::FontStyle GetStyle() const;
@@ -58,9 +58,13 @@ public:
 	/// Releases resources owned by sized font faces, including their textures and rendered glyphs.
 	void ReleaseFontResources();
 
+	/// Appends the handles generated for this face.
+	void GetHandles(Vector<const FontFaceHandleDefault*>& out_handles) const;
+
 private:
 	Style::FontStyle style;
 	Style::FontWeight weight;
+	uint64_t face_hash;
 
 	// Key is font size
 	using HandleMap = UnorderedMap< int, UniquePtr<FontFaceHandleDefault> >;
@@ -28,9 +28,9 @@
 
 #include "FontFaceHandleDefault.h"
 #include "../../../Include/RmlUi/Core/StringUtilities.h"
-#include "../TextureLayout.h"
 #include "FontProvider.h"
 #include "FontFaceLayer.h"
+#include "FontGlyphCache.h"
 #include "FreeTypeInterface.h"
 #include <algorithm>
 
@@ -52,13 +52,17 @@ FontFaceHandleDefault::~FontFaceHandleDefault()
 	layers.clear();
 }
 
-bool FontFaceHandleDefault::Initialize(FontFaceHandleFreetype face, int font_size, bool load_default_glyphs)
+bool FontFaceHandleDefault::Initialize(FontFaceHandleFreetype face, uint64_t _face_hash, int font_size, bool load_default_glyphs)
 {
 	ft_face = face;
+	face_hash = _face_hash;
+	has_default_glyphs = load_default_glyphs;
 
 	RMLUI_ASSERTMSG(layer_configurations.empty(), "Initialize must only be called once.");
 
-	if (!FreeType::InitialiseFaceHandle(ft_face, font_size, glyphs, metrics, load_default_glyphs))
+	// Glyphs cached by an earlier run are used as they are, only glyphs missing from the cache are rasterised.
+	if (!FontGlyphCache::InitialiseFaceHandle(face_hash, font_size, load_default_glyphs, glyphs, metrics) &&
+		!FreeType::InitialiseFaceHandle(ft_face, font_size, glyphs, metrics, load_default_glyphs))
 		return false;
 
 	has_kerning = FreeType::HasKerning(ft_face);
@@ -101,6 +105,21 @@ const FontGlyphMap& FontFaceHandleDefault::GetGlyphs() const
 	return glyphs;
 }
 
+const FontMetrics& FontFaceHandleDefault::GetMetrics() const
+{
+	return metrics;
+}
+
+uint64_t FontFaceHandleDefault::GetFaceHash() const
+{
+	return face_hash;
+}
+
+bool FontFaceHandleDefault::HasDefaultGlyphs() const
+{
+	return has_default_glyphs;
+}
+
 float FontFaceHandleDefault::GetUnderline(float& thickness) const
 {
 	thickness = metrics.underline_thickness;
@@ -195,26 +214,6 @@ int FontFaceHandleDefault::GenerateLayerConfiguration(const FontEffectList& font
 	return (int) (layer_configurations.size() - 1);
 }
 
-// Generates the texture data for a layer (for the texture database).
-bool FontFaceHandleDefault::GenerateLayerTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, const FontEffect* font_effect, int texture_id, int handle_version) const
-{
-	if (handle_version != version)
-	{
-		RMLUI_ERRORMSG("While generating font layer texture: Handle version mismatch in texture vs font-face.");
-		return false;
-	}
-
-	auto it = std::find_if(layers.begin(), layers.end(), [font_effect](const EffectLayerPair& pair) { return pair.font_effect == font_effect; });
-
-	if (it == layers.end())
-	{
-		RMLUI_ERRORMSG("While generating font layer texture: Layer id not found.");
-		return false;
-	}
-
-	return it->layer->GenerateTexture(texture_data, texture_dimensions, texture_id, glyphs);
-}
-
 // Generates the geometry required to render a single line of text.
 int FontFaceHandleDefault::GenerateString(GeometryList& geometry, const String& string, const Vector2f position, const Colourb colour,
 	const float opacity, const int layer_configuration_index)
@@ -297,6 +296,11 @@ int FontFaceHandleDefault::GenerateString(GeometryList& geometry, const String&
 	// Cull any excess geometry from a previous generation.
 	geometry.resize(geometry_index);
 
+	// Glyphs appended while generating the string are missing from its geometry. This is rare as strings are usually
+	// measured first, so just have all geometry regenerated once the layers are updated.
+	if (is_layers_dirty)
+		++version;
+
 	return line_width;
 }
 
@@ -304,20 +308,24 @@ bool FontFaceHandleDefault::UpdateLayersOnDirty()
 {
 	bool result = false;
 
-	// If we are dirty, regenerate all the layers and increment the version
+	// If we are dirty, add the new glyphs to all the layers. Existing geometry stays valid unless a layer had to
+	// rearrange its textures, only then increment the version.
 	if(is_layers_dirty && base_layer)
 	{
 		is_layers_dirty = false;
-		++version;
+		bool geometry_invalidated = false;
 
-		// Regenerate all the layers.
-		// Note: The layer regeneration needs to happen in the order in which the layers were created,
-		// otherwise we may end up cloning a layer which has not yet been regenerated. This means trouble!
+		// Update all the layers.
+		// Note: The layer update needs to happen in the order in which the layers were created,
+		// otherwise we may end up cloning a layer which has not yet been updated. This means trouble!
 		for (auto& pair : layers)
 		{
-			GenerateLayer(pair.layer.get());
+			GenerateLayer(pair.layer.get(), geometry_invalidated);
 		}
 
+		if (geometry_invalidated)
+			++version;
+
 		result = true;
 	}
 
@@ -462,12 +470,13 @@ FontFaceLayer* FontFaceHandleDefault::GetOrCreateLayer(const SharedPtr<const Fon
 	auto& layer = layers.back().layer;
 	
 	layer = MakeUnique<FontFaceLayer>(font_effect);
-	GenerateLayer(layer.get());
+	bool geometry_invalidated = false;
+	GenerateLayer(layer.get(), geometry_invalidated);
 
 	return layer.get();
 }
 
-bool FontFaceHandleDefault::GenerateLayer(FontFaceLayer* layer)
+bool FontFaceHandleDefault::GenerateLayer(FontFaceLayer* layer, bool& geometry_invalidated)
 {
 	RMLUI_ASSERT(layer);
 	const FontEffect* font_effect = layer->GetFontEffect();
@@ -475,7 +484,7 @@ bool FontFaceHandleDefault::GenerateLayer(FontFaceLayer* layer)
 
 	if (!font_effect)
 	{
-		result = layer->Generate(this);
+		result = layer->Generate(glyphs, geometry_invalidated);
 	}
 	else
 	{
@@ -498,7 +507,7 @@ bool FontFaceHandleDefault::GenerateLayer(FontFaceLayer* layer)
 		}
 
 		// Create a new layer.
-		result = layer->Generate(this, clone, clone_glyph_origins);
+		result = layer->Generate(glyphs, geometry_invalidated, clone, clone_glyph_origins);
 
 		// Cache the layer in the layer cache if it generated its own textures (ie, didn't clone).
 		if (!clone)
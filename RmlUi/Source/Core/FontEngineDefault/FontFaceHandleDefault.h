@@ -51,7 +51,7 @@ public:
 	FontFaceHandleDefault();
 	~FontFaceHandleDefault();
 
-	bool Initialize(FontFaceHandleFreetype face, int font_size, bool load_default_glyphs);
+	bool Initialize(FontFaceHandleFreetype face, uint64_t face_hash, int font_size, bool load_default_glyphs);
 
 	/// Returns the point size of this font face.
 	int GetSize() const;
@@ -69,6 +69,14 @@ public:
 	/// Returns the font's glyphs.
 	const FontGlyphMap& GetGlyphs() const;
 
+	/// Returns the font's metrics.
+	const FontMetrics& GetMetrics() const;
+
+	/// Returns the hash identifying the face of this handle in the glyph cache.
+	uint64_t GetFaceHash() const;
+	/// Returns true if the handle was initialised with the default set of glyphs (ASCII range).
+	bool HasDefaultGlyphs() const;
+
 	/// Returns the width a string will take up if rendered with this handle.
 	/// @param[in] string The string to measure.
 	/// @param[in] prior_character The optionally-specified character that immediately precedes the string. This may have an impact on the string width due to kerning.
@@ -79,13 +87,6 @@ public:
 	/// @param[in] font_effects The list of font effects to generate the configuration for.
 	/// @return The index to use when generating geometry using this configuration.
 	int GenerateLayerConfiguration(const FontEffectList& font_effects);
-	/// Generates the texture data for a layer (for the texture database).
-	/// @param[out] texture_data The pointer to be set to the generated texture data.
-	/// @param[out] texture_dimensions The dimensions of the texture.
-	/// @param[in] font_effect The font effect used for the layer.
-	/// @param[in] texture_id The index of the texture within the layer to generate.
-	/// @param[in] handle_version The version of the handle data. Function returns false if out of date.
-	bool GenerateLayerTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, const FontEffect* font_effect, int texture_id, int handle_version) const;
 
 	/// Generates the geometry required to render a single line of text.
 	/// @param[out] geometry An array of geometries to generate the geometry into.
@@ -97,7 +98,7 @@ public:
 	/// @return The width, in pixels, of the string geometry.
 	int GenerateString(GeometryList& geometry, const String& string, Vector2f position, Colourb colour, float opacity, int layer_configuration = 0);
 
-	/// Version is changed whenever the layers are dirtied, requiring regeneration of string geometry.
+	/// Version is changed whenever the layers rearrange their textures, requiring regeneration of string geometry.
 	int GetVersion() const;
 
 private:
@@ -116,14 +117,14 @@ private:
 	/// @return The font glyph for the returned code point.
 	const FontGlyph* GetOrAppendGlyph(Character& character, bool look_in_fallback_fonts = true);
 
-	// Regenerate layers if dirty, such as after adding new glyphs.
+	// Add new glyphs to the layers if dirty.
 	bool UpdateLayersOnDirty();
 
 	// Create a new layer from the given font effect if it does not already exist.
 	FontFaceLayer* GetOrCreateLayer(const SharedPtr<const FontEffect>& font_effect);
 
-	// (Re-)generate a layer in this font face handle.
-	bool GenerateLayer(FontFaceLayer* layer);
+	// Generate a layer in this font face handle, or add the glyphs it is missing.
+	bool GenerateLayer(FontFaceLayer* layer, bool& geometry_invalidated);
 
 	FontGlyphMap glyphs;
 
@@ -158,6 +159,8 @@ private:
 	FontMetrics metrics;
 
 	FontFaceHandleFreetype ft_face;
+	uint64_t face_hash = 0;
+	bool has_default_glyphs = false;
 };
 
 } // namespace Rml
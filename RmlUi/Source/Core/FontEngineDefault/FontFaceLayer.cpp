@@ -27,11 +27,26 @@
  */
 
 #include "FontFaceLayer.h"
-#include "FontFaceHandleDefault.h"
+#include "../../../Include/RmlUi/Core/FontEffect.h"
+#include "../../../Include/RmlUi/Core/Log.h"
+#include "../../../Include/RmlUi/Core/Math.h"
+#include <algorithm>
 #include <string.h>
 
 namespace Rml {
 
+static constexpr int min_texture_dimensions = 64;
+static constexpr int max_texture_dimensions = 1024;
+
+// Allocates texture data set to transparent white.
+static UniquePtr<byte[]> AllocateTextureData(Vector2i dimensions)
+{
+	UniquePtr<byte[]> texture_data(new byte[dimensions.x * dimensions.y * 4]);
+	for (int i = 0; i < dimensions.x * dimensions.y; i++)
+		((unsigned int*)(texture_data.get()))[i] = 0x00ffffff;
+	return texture_data;
+}
+
 FontFaceLayer::FontFaceLayer(const SharedPtr<const FontEffect>& _effect) : colour(255, 255, 255)
 {
 	effect = _effect;
@@ -42,28 +57,23 @@ FontFaceLayer::FontFaceLayer(const SharedPtr<const FontEffect>& _effect) : colou
 FontFaceLayer::~FontFaceLayer()
 {}
 
-bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFaceLayer* clone, bool clone_glyph_origins)
+bool FontFaceLayer::Generate(const FontGlyphMap& glyphs, bool& geometry_invalidated, const FontFaceLayer* clone, bool clone_glyph_origins)
 {
-	// Clear the old layout if it exists.
-	{
-		// @performance: We could be much smarter about this, e.g. such as adding new glyphs to the existing texture layout and textures.
-		// Right now we re-generate the whole thing, including textures.
-		texture_layout = TextureLayout{};
-		character_boxes.clear();
-		textures.clear();
-	}
-
-	const FontGlyphMap& glyphs = handle->GetGlyphs();
-
-	// Generate the new layout.
 	if (clone)
 	{
-		// Clone the geometry and textures from the clone layer.
+		// Clone the geometry and textures from the clone layer. The textures are shared, they only need to be copied
+		// again when the clone layer added new ones.
 		character_boxes = clone->character_boxes;
 
-		// Copy the cloned layer's textures.
-		for (size_t i = 0; i < clone->textures.size(); ++i)
-			textures.push_back(clone->textures[i]);
+		bool same_textures = (textures.size() == clone->textures.size());
+		for (size_t i = 0; same_textures && i < textures.size(); ++i)
+			same_textures = (textures[i] == clone->textures[i]);
+
+		if (!same_textures)
+		{
+			textures = clone->textures;
+			geometry_invalidated = true;
+		}
 
 		// Request the effect (if we have one) and adjust the origins as appropriate.
 		if (effect && !clone_glyph_origins)
@@ -92,77 +102,177 @@ bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFace
 					box.texture_index = -1;
 			}
 		}
+
+		return true;
 	}
-	else
+
+	// Find the glyphs which have not been added to the layer yet. Every glyph gets a box, also those without any
+	// pixels in this layer, so that they are only considered once.
+	using NewCharacter = Pair<Character, Vector2i>;
+	Vector<NewCharacter> new_characters;
+	int new_pixels = 0;
+
+	for (auto& pair : glyphs)
 	{
-		// Initialise the texture layout for the glyphs.
-		character_boxes.reserve(glyphs.size());
-		for (auto& pair : glyphs)
+		Character character = pair.first;
+		const FontGlyph& glyph = pair.second;
+
+		if (character_boxes.find(character) != character_boxes.end())
+			continue;
+
+		TextureBox& box = character_boxes[character];
+
+		Vector2i glyph_origin(0, 0);
+		Vector2i glyph_dimensions = glyph.bitmap_dimensions;
+
+		// Adjust glyph origin / dimensions for the font effect.
+		if (effect)
 		{
-			Character character = pair.first;
-			const FontGlyph& glyph = pair.second;
+			if (!effect->GetGlyphMetrics(glyph_origin, glyph_dimensions, glyph))
+				continue;
+		}
 
-			Vector2i glyph_origin(0, 0);
-			Vector2i glyph_dimensions = glyph.bitmap_dimensions;
+		box.origin = Vector2f(float(glyph_origin.x + glyph.bearing.x), float(glyph_origin.y - glyph.bearing.y));
+		box.dimensions = Vector2f(glyph_dimensions);
 
-			// Adjust glyph origin / dimensions for the font effect.
-			if (effect)
-			{
-				if (!effect->GetGlyphMetrics(glyph_origin, glyph_dimensions, glyph))
-					continue;
-			}
+		RMLUI_ASSERT(box.dimensions.x >= 0 && box.dimensions.y >= 0);
 
-			TextureBox box;
-			box.origin = Vector2f(float(glyph_origin.x + glyph.bearing.x), float(glyph_origin.y - glyph.bearing.y));
-			box.dimensions = Vector2f(glyph_dimensions);
-			
-			RMLUI_ASSERT(box.dimensions.x >= 0 && box.dimensions.y >= 0);
+		if (glyph_dimensions.x > 0 && glyph_dimensions.y > 0)
+		{
+			new_characters.push_back(NewCharacter(character, glyph_dimensions));
+			new_pixels += (glyph_dimensions.x + 1) * (glyph_dimensions.y + 1);
+		}
+	}
+
+	if (new_characters.empty())
+		return true;
+
+	// Place the tallest characters first, this packs the shelves more tightly.
+	std::sort(new_characters.begin(), new_characters.end(), [](const NewCharacter& a, const NewCharacter& b) {
+		return a.second.y > b.second.y || (a.second.y == b.second.y && a.second.x > b.second.x);
+	});
 
-			character_boxes[character] = box;
+	// Size the first texture to roughly fit the initial glyphs.
+	const int initial_page_size =
+		Math::Clamp(Math::ToPowerOfTwo(Math::RealToInteger(Math::SquareRoot(float(new_pixels)))), min_texture_dimensions, max_texture_dimensions);
+
+	bool result = true;
+
+	for (const NewCharacter& new_character : new_characters)
+	{
+		TextureBox& box = character_boxes[new_character.first];
 
-			// Add the character's dimensions into the texture layout engine.
-			texture_layout.AddRectangle((int)character, glyph_dimensions);
+		if (!PlaceBox(new_character.second, initial_page_size, box.texture_index, box.position, geometry_invalidated))
+		{
+			result = false;
+			continue;
 		}
 
-		constexpr int max_texture_dimensions = 1024;
+		SetTextureCoordinates(box);
+
+		auto it_glyph = glyphs.find(new_character.first);
+		RMLUI_ASSERT(it_glyph != glyphs.end());
+		RasteriseBox(box, it_glyph->second);
+	}
 
-		// Generate the texture layout; this will position the glyph rectangles efficiently and
-		// allocate the texture data ready for writing.
-		if (!texture_layout.GenerateLayout(max_texture_dimensions))
-			return false;
+	// Upload the regions of the new characters.
+	for (int i = 0; i < (int)pages.size(); ++i)
+	{
+		TexturePage& page = *pages[i];
+		if (page.dirty_min.x >= page.dirty_max.x || page.dirty_min.y >= page.dirty_max.y)
+			continue;
 
+		textures[i].UpdateRegion(page.data.get(), page.dimensions, page.dirty_min, page.dirty_max - page.dirty_min);
 
-		// Iterate over each rectangle in the layout, copying the glyph data into the rectangle as
-		// appropriate and generating geometry.
-		for (int i = 0; i < texture_layout.GetNumRectangles(); ++i)
+		page.dirty_min = page.dimensions;
+		page.dirty_max = Vector2i(0, 0);
+	}
+
+	return result;
+}
+
+// Generates the texture data of a page (for the texture database).
+bool FontFaceLayer::GenerateTexture(const TexturePage& page, UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions)
+{
+	const size_t num_bytes = size_t(page.dimensions.x * page.dimensions.y * 4);
+
+	byte* data = new byte[num_bytes];
+	memcpy(data, page.data.get(), num_bytes);
+
+	texture_data.reset(data);
+	texture_dimensions = page.dimensions;
+
+	return true;
+}
+
+bool FontFaceLayer::PlaceBox(Vector2i dimensions, int initial_page_size, int& page_index, Vector2i& position, bool& geometry_invalidated)
+{
+	// An extra pixel is added on so the characters aren't pushed up against each other. This will avoid filtering
+	// artifacts. The first row and column of each texture are kept empty for the same reason.
+	const Vector2i padded_dimensions = dimensions + Vector2i(1, 1);
+	if (padded_dimensions.x + 1 > max_texture_dimensions || padded_dimensions.y + 1 > max_texture_dimensions)
+	{
+		Log::Message(Log::LT_WARNING, "Font glyph of size %dx%d does not fit in a font texture.", dimensions.x, dimensions.y);
+		return false;
+	}
+
+	for (;;)
+	{
+		for (int i = 0; i < (int)pages.size(); ++i)
 		{
-			TextureLayoutRectangle& rectangle = texture_layout.GetRectangle(i);
-			const TextureLayoutTexture& texture = texture_layout.GetTexture(rectangle.GetTextureIndex());
-			Character character = (Character)rectangle.GetId();
-			RMLUI_ASSERT(character_boxes.find(character) != character_boxes.end());
-			TextureBox& box = character_boxes[character];
-
-			// Set the character's texture index.
-			box.texture_index = rectangle.GetTextureIndex();
-
-			// Generate the character's texture coordinates.
-			box.texcoords[0].x = float(rectangle.GetPosition().x) / float(texture.GetDimensions().x);
-			box.texcoords[0].y = float(rectangle.GetPosition().y) / float(texture.GetDimensions().y);
-			box.texcoords[1].x = float(rectangle.GetPosition().x + rectangle.GetDimensions().x) / float(texture.GetDimensions().x);
-			box.texcoords[1].y = float(rectangle.GetPosition().y + rectangle.GetDimensions().y) / float(texture.GetDimensions().y);
+			TexturePage& page = *pages[i];
+
+			// Use the shelf with room for the character wasting the least height, or start a new shelf.
+			TexturePage::Shelf* best_shelf = nullptr;
+			for (TexturePage::Shelf& shelf : page.shelves)
+			{
+				if (shelf.height >= padded_dimensions.y && shelf.x + padded_dimensions.x <= page.dimensions.x &&
+					(!best_shelf || shelf.height < best_shelf->height))
+					best_shelf = &shelf;
+			}
+
+			if (!best_shelf && page.shelves_bottom + padded_dimensions.y <= page.dimensions.y && 1 + padded_dimensions.x <= page.dimensions.x)
+			{
+				page.shelves.push_back(TexturePage::Shelf{page.shelves_bottom, padded_dimensions.y, 1});
+				page.shelves_bottom += padded_dimensions.y;
+				best_shelf = &page.shelves.back();
+			}
+
+			if (best_shelf)
+			{
+				page_index = i;
+				position = Vector2i(best_shelf->x, best_shelf->y);
+				best_shelf->x += padded_dimensions.x;
+				return true;
+			}
 		}
 
-		const FontEffect* effect_ptr = effect.get();
-		const int handle_version = handle->GetVersion();
+		// No room left, grow the last texture or add a new one. Either way, existing geometry refers to outdated texture coordinates or textures.
+		geometry_invalidated = true;
+
+		if (!pages.empty() && (pages.back()->dimensions.x < max_texture_dimensions || pages.back()->dimensions.y < max_texture_dimensions))
+		{
+			Vector2i new_dimensions = pages.back()->dimensions;
+			if (new_dimensions.x <= new_dimensions.y)
+				new_dimensions.x *= 2;
+			else
+				new_dimensions.y *= 2;
 
-		// Generate the textures.
-		for (int i = 0; i < texture_layout.GetNumTextures(); ++i)
+			GrowPage((int)pages.size() - 1, new_dimensions);
+		}
+		else
 		{
-			int texture_id = i;
+			const int page_size = (pages.empty() ? initial_page_size : max_texture_dimensions);
+
+			SharedPtr<TexturePage> page = MakeShared<TexturePage>();
+			page->dimensions = Vector2i(page_size, page_size);
+			page->data = AllocateTextureData(page->dimensions);
+			page->dirty_min = page->dimensions;
+			pages.push_back(page);
 
-			TextureCallback texture_callback = [handle, effect_ptr, texture_id, handle_version](const String& /*name*/, UniquePtr<const byte[]>& data, Vector2i& dimensions) -> bool {
-				bool result = handle->GenerateLayerTexture(data, dimensions, effect_ptr, texture_id, handle_version);
-				return result;
+			// The callback holds on to the page itself rather than the layer, as the texture may be regenerated after the layer is destroyed.
+			TextureCallback texture_callback = [page](const String& /*name*/, UniquePtr<const byte[]>& data, Vector2i& dimensions) -> bool {
+				return GenerateTexture(*page, data, dimensions);
 			};
 
 			Texture texture;
@@ -170,76 +280,84 @@ bool FontFaceLayer::Generate(const FontFaceHandleDefault* handle, const FontFace
 			textures.push_back(texture);
 		}
 	}
-
-	return true;
 }
 
-// Generates the texture data for a layer (for the texture database).
-bool FontFaceLayer::GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontGlyphMap& glyphs)
+void FontFaceLayer::GrowPage(int page_index, Vector2i new_dimensions)
 {
-	if (texture_id < 0 ||
-		texture_id > texture_layout.GetNumTextures())
-		return false;
+	TexturePage& page = *pages[page_index];
 
-	// Generate the texture data.
-	texture_data = texture_layout.GetTexture(texture_id).AllocateTexture();
-	texture_dimensions = texture_layout.GetTexture(texture_id).GetDimensions();
+	UniquePtr<byte[]> new_data = AllocateTextureData(new_dimensions);
+	for (int y = 0; y < page.dimensions.y; ++y)
+		memcpy(new_data.get() + y * new_dimensions.x * 4, page.data.get() + y * page.dimensions.x * 4, page.dimensions.x * 4);
 
-	for (int i = 0; i < texture_layout.GetNumRectangles(); ++i)
-	{
-		TextureLayoutRectangle& rectangle = texture_layout.GetRectangle(i);
-		Character character = (Character)rectangle.GetId();
-		RMLUI_ASSERT(character_boxes.find(character) != character_boxes.end());
-
-		TextureBox& box = character_boxes[character];
+	page.data = std::move(new_data);
+	page.dimensions = new_dimensions;
 
-		if (box.texture_index != texture_id)
-			continue;
+	// The texture changed size, so it has to be uploaded as a whole.
+	page.dirty_min = Vector2i(0, 0);
+	page.dirty_max = new_dimensions;
 
-		auto it = glyphs.find((Character)rectangle.GetId());
-		if (it == glyphs.end())
-			continue;
+	for (auto& pair : character_boxes)
+	{
+		if (pair.second.texture_index == page_index)
+			SetTextureCoordinates(pair.second);
+	}
+}
 
-		const FontGlyph& glyph = it->second;
+void FontFaceLayer::RasteriseBox(const TextureBox& box, const FontGlyph& glyph)
+{
+	TexturePage& page = *pages[box.texture_index];
+	const int stride = page.dimensions.x * 4;
+	byte* destination = page.data.get() + box.position.y * stride + box.position.x * 4;
 
-		if (effect == nullptr)
+	if (effect == nullptr)
+	{
+		// Copy the glyph's bitmap data into its allocated texture.
+		if (glyph.bitmap_data)
 		{
-			// Copy the glyph's bitmap data into its allocated texture.
-			if (glyph.bitmap_data)
-			{
-				byte* destination = rectangle.GetTextureData();
-				const byte* source = glyph.bitmap_data;
-				const int num_bytes_per_line = glyph.bitmap_dimensions.x * (glyph.color_format == ColorFormat::RGBA8 ? 4 : 1);
+			const byte* source = glyph.bitmap_data;
+			const int num_bytes_per_line = glyph.bitmap_dimensions.x * (glyph.color_format == ColorFormat::RGBA8 ? 4 : 1);
 
-				for (int j = 0; j < glyph.bitmap_dimensions.y; ++j)
+			for (int j = 0; j < glyph.bitmap_dimensions.y; ++j)
+			{
+				switch (glyph.color_format)
+				{
+				case ColorFormat::A8:
 				{
-					switch (glyph.color_format)
-					{
-					case ColorFormat::A8:
-					{
-						for (int k = 0; k < num_bytes_per_line; ++k)
-							destination[k * 4 + 3] = source[k];
-					}
-					break;
-					case ColorFormat::RGBA8:
-					{
-						memcpy(destination, source, num_bytes_per_line);
-					}
-					break;
-					}
-
-					destination += rectangle.GetTextureStride();
-					source += num_bytes_per_line;
+					for (int k = 0; k < num_bytes_per_line; ++k)
+						destination[k * 4 + 3] = source[k];
+				}
+				break;
+				case ColorFormat::RGBA8:
+				{
+					memcpy(destination, source, num_bytes_per_line);
+				}
+				break;
 				}
+
+				destination += stride;
+				source += num_bytes_per_line;
 			}
 		}
-		else
-		{
-			effect->GenerateGlyphTexture(rectangle.GetTextureData(), Vector2i(box.dimensions), rectangle.GetTextureStride(), glyph);
-		}
+	}
+	else
+	{
+		effect->GenerateGlyphTexture(destination, Vector2i(box.dimensions), stride, glyph);
 	}
 
-	return true;
+	const Vector2i box_end = box.position + Vector2i(box.dimensions);
+	page.dirty_min = Vector2i(Math::Min(page.dirty_min.x, box.position.x), Math::Min(page.dirty_min.y, box.position.y));
+	page.dirty_max = Vector2i(Math::Max(page.dirty_max.x, box_end.x), Math::Max(page.dirty_max.y, box_end.y));
+}
+
+void FontFaceLayer::SetTextureCoordinates(TextureBox& box) const
+{
+	const Vector2i dimensions = pages[box.texture_index]->dimensions;
+
+	box.texcoords[0].x = float(box.position.x) / float(dimensions.x);
+	box.texcoords[0].y = float(box.position.y) / float(dimensions.y);
+	box.texcoords[1].x = float(box.position.x + int(box.dimensions.x)) / float(dimensions.x);
+	box.texcoords[1].y = float(box.position.y + int(box.dimensions.y)) / float(dimensions.y);
 }
 
 // Returns the effect used to generate the layer.
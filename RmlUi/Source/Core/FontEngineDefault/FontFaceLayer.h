@@ -33,12 +33,10 @@
 #include "../../../Include/RmlUi/Core/Geometry.h"
 #include "../../../Include/RmlUi/Core/GeometryUtilities.h"
 #include "../../../Include/RmlUi/Core/Texture.h"
-#include "../TextureLayout.h"
 
 namespace Rml {
 
 class FontEffect;
-class FontFaceHandleDefault;
 
 /**
 	A textured layer stored as part of a font face handle. Each handle will have at least a base
@@ -53,19 +51,14 @@ public:
 	FontFaceLayer(const SharedPtr<const FontEffect>& _effect);
 	~FontFaceLayer();
 
-	/// Generates or re-generates the character and texture data for the layer.
-	/// @param[in] handle The handle generating this layer.
-	/// @param[in] effect The effect to initialise the layer with.
+	/// Generates the character and texture data for glyphs not yet in the layer. Characters already in the layer keep
+	/// their place in the textures, only the regions of the new characters are uploaded.
+	/// @param[in] glyphs The glyphs of the handle generating this layer.
+	/// @param[out] geometry_invalidated Set to true if existing characters moved, so that geometry generated earlier must be regenerated.
 	/// @param[in] clone The layer to optionally clone geometry and texture data from.
+	/// @param[in] clone_glyph_origins True to keep the glyph origins of the cloned layer.
 	/// @return True if the layer was generated successfully, false if not.
-	bool Generate(const FontFaceHandleDefault* handle, const FontFaceLayer* clone = nullptr, bool clone_glyph_origins = false);
-
-	/// Generates the texture data for a layer (for the texture database).
-	/// @param[out] texture_data The pointer to be set to the generated texture data.
-	/// @param[out] texture_dimensions The dimensions of the texture.
-	/// @param[in] texture_id The index of the texture within the layer to generate.
-	/// @param[in] glyphs The glyphs required by the font face handle.
-	bool GenerateTexture(UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions, int texture_id, const FontGlyphMap& glyphs);
+	bool Generate(const FontGlyphMap& glyphs, bool& geometry_invalidated, const FontFaceLayer* clone = nullptr, bool clone_glyph_origins = false);
 
 	/// Generates the geometry required to render a single character.
 	/// @param[out] geometry An array of geometries this layer will write to. It must be at least as big as the number of textures in this layer.
@@ -125,20 +118,52 @@ private:
 		Vector2f dimensions;
 		// The texture coordinates for the character's geometry.
 		Vector2f texcoords[2];
+		// The position, in pixels, of the character within its texture.
+		Vector2i position;
 
 		// The texture this character renders from.
 		int texture_index;
 	};
 
+	// The pixel data of a texture, kept so that new characters can be added to it. Characters are placed on shelves: rows
+	// as high as the first character placed on them. The texture grows by doubling when full, up to the maximum size.
+	// Pages are shared with the callbacks of their textures, which may outlive the layer.
+	struct TexturePage
+	{
+		struct Shelf
+		{
+			int y, height, x;
+		};
+
+		UniquePtr<byte[]> data;
+		Vector2i dimensions;
+		Vector<Shelf> shelves;
+		int shelves_bottom = 1;
+
+		// The region written since the texture was last uploaded, empty if dirty_min > dirty_max.
+		Vector2i dirty_min, dirty_max;
+	};
+
+	// Generates the texture data of a page (for the texture database).
+	static bool GenerateTexture(const TexturePage& page, UniquePtr<const byte[]>& texture_data, Vector2i& texture_dimensions);
+
+	// Places a character box of the given dimensions in one of the textures, adding or growing a texture if necessary.
+	bool PlaceBox(Vector2i dimensions, int initial_page_size, int& page_index, Vector2i& position, bool& geometry_invalidated);
+	// Resizes a texture, keeping its contents, and recomputes the texture coordinates of the characters on it.
+	void GrowPage(int page_index, Vector2i new_dimensions);
+	// Writes the glyph of a character box into its texture.
+	void RasteriseBox(const TextureBox& box, const FontGlyph& glyph);
+	void SetTextureCoordinates(TextureBox& box) const;
+
 	using CharacterMap = UnorderedMap<Character, TextureBox>;
 	using TextureList = Vector<Texture>;
+	using PageList = Vector<SharedPtr<TexturePage>>;
 
 	SharedPtr<const FontEffect> effect;
 
-	TextureLayout texture_layout;
-
 	CharacterMap character_boxes;
 	TextureList textures;
+	PageList pages;
 	Colourb colour;
 };
 
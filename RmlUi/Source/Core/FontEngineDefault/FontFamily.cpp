@@ -79,9 +79,9 @@ FontFaceHandleDefault* FontFamily::GetFaceHandle(Style::FontStyle style, Style::
 }
 
 // Adds a new face to the family.
-FontFace* FontFamily::AddFace(FontFaceHandleFreetype ft_face, Style::FontStyle style, Style::FontWeight weight, UniquePtr<byte[]> face_memory)
+FontFace* FontFamily::AddFace(FontFaceHandleFreetype ft_face, Style::FontStyle style, Style::FontWeight weight, UniquePtr<byte[]> face_memory, uint64_t face_hash)
 {
-	auto face = MakeUnique<FontFace>(ft_face, style, weight);
+	auto face = MakeUnique<FontFace>(ft_face, style, weight, face_hash);
 	FontFace* result = face.get();
 
 	font_faces.push_back(FontFaceEntry{std::move(face), std::move(face_memory)});
@@ -95,4 +95,10 @@ void FontFamily::ReleaseFontResources()
 		entry.face->ReleaseFontResources();
 }
 
+void FontFamily::GetFaceHandles(Vector<const FontFaceHandleDefault*>& handles) const
+{
+	for (auto& entry : font_faces)
+		entry.face->GetHandles(handles);
+}
+
 } // namespace Rml
@@ -58,12 +58,16 @@ public:
 	/// @param[in] style The style of the new face.
 	/// @param[in] weight The weight of the new face.
 	/// @param[in] face_memory Optionally pass ownership of the face's memory to the face itself, automatically releasing it on destruction.
+	/// @param[in] face_hash The hash of the face's data, identifying it in the glyph cache.
 	/// @return True if the face was loaded successfully, false otherwise.
-	FontFace* AddFace(FontFaceHandleFreetype ft_face, Style::FontStyle style, Style::FontWeight weight, UniquePtr<byte[]> face_memory);
+	FontFace* AddFace(FontFaceHandleFreetype ft_face, Style::FontStyle style, Style::FontWeight weight, UniquePtr<byte[]> face_memory, uint64_t face_hash);
 	
 	/// Releases resources owned by sized font faces, including their textures and rendered glyphs.
 	void ReleaseFontResources();
 
+	/// Appends the sized handles of all faces in the family.
+	void GetFaceHandles(Vector<const FontFaceHandleDefault*>& handles) const;
+
 protected:
 	String name;
 
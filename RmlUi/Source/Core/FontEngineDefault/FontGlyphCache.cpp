@@ -0,0 +1,308 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "FontGlyphCache.h"
+#include "FontFaceHandleDefault.h"
+#include "FontProvider.h"
+#include "../../../Include/RmlUi/Core/Log.h"
+#include <algorithm>
+#include <string.h>
+
+namespace Rml {
+
+namespace {
+
+constexpr uint32_t cache_magic = 0x474c4d52; // "RMLG"
+constexpr uint32_t cache_version = 1;
+
+struct CacheEntry {
+	uint64_t face_hash = 0;
+	int font_size = 0;
+	bool default_glyphs = false;
+	FontMetrics metrics = {};
+	FontGlyphMap glyphs;
+};
+
+// Cache entries by face hash, then by font size.
+using CacheMap = UnorderedMap<uint64_t, UnorderedMap<int, CacheEntry>>;
+
+CacheMap cache_entries;
+
+template <typename T>
+void Write(Vector<byte>& data, const T& value)
+{
+	const size_t offset = data.size();
+	data.resize(offset + sizeof(T));
+	memcpy(data.data() + offset, &value, sizeof(T));
+}
+
+struct Reader {
+	const byte* data;
+	size_t size;
+	size_t offset;
+
+	template <typename T>
+	bool Read(T& value)
+	{
+		if (size - offset < sizeof(T))
+			return false;
+		memcpy(&value, data + offset, sizeof(T));
+		offset += sizeof(T);
+		return true;
+	}
+
+	const byte* ReadBytes(size_t num_bytes)
+	{
+		if (size - offset < num_bytes)
+			return nullptr;
+		const byte* result = data + offset;
+		offset += num_bytes;
+		return result;
+	}
+};
+
+int BitmapSize(const FontGlyph& glyph)
+{
+	return glyph.bitmap_dimensions.x * glyph.bitmap_dimensions.y * (glyph.color_format == ColorFormat::RGBA8 ? 4 : 1);
+}
+
+void CopyGlyph(FontGlyph& destination, const FontGlyph& source)
+{
+	destination = source.WeakCopy();
+	destination.bitmap_data = nullptr;
+
+	const int bitmap_size = BitmapSize(source);
+	if (source.bitmap_data && bitmap_size > 0)
+	{
+		destination.bitmap_owned_data.reset(new byte[bitmap_size]);
+		memcpy(destination.bitmap_owned_data.get(), source.bitmap_data, bitmap_size);
+		destination.bitmap_data = destination.bitmap_owned_data.get();
+	}
+}
+
+void WriteEntry(Vector<byte>& data, uint64_t face_hash, int font_size, bool default_glyphs, const FontMetrics& metrics, const FontGlyphMap& glyphs)
+{
+	Write(data, face_hash);
+	Write(data, int32_t(font_size));
+	Write(data, uint8_t(default_glyphs));
+	Write(data, int32_t(metrics.x_height));
+	Write(data, int32_t(metrics.line_height));
+	Write(data, int32_t(metrics.baseline));
+	Write(data, metrics.underline_position);
+	Write(data, metrics.underline_thickness);
+
+	// Glyphs borrowed from fallback faces are stored with the fallback face instead.
+	uint32_t num_glyphs = 0;
+	for (auto& pair : glyphs)
+	{
+		if (!pair.second.bitmap_data || pair.second.bitmap_owned_data)
+			num_glyphs++;
+	}
+	Write(data, num_glyphs);
+
+	for (auto& pair : glyphs)
+	{
+		const FontGlyph& glyph = pair.second;
+		if (glyph.bitmap_data && !glyph.bitmap_owned_data)
+			continue;
+
+		Write(data, uint32_t(pair.first));
+		Write(data, int32_t(glyph.dimensions.x));
+		Write(data, int32_t(glyph.dimensions.y));
+		Write(data, int32_t(glyph.bearing.x));
+		Write(data, int32_t(glyph.bearing.y));
+		Write(data, int32_t(glyph.advance));
+		Write(data, int32_t(glyph.bitmap_data ? glyph.bitmap_dimensions.x : 0));
+		Write(data, int32_t(glyph.bitmap_data ? glyph.bitmap_dimensions.y : 0));
+		Write(data, uint8_t(glyph.color_format));
+
+		if (glyph.bitmap_data)
+		{
+			const size_t offset = data.size();
+			data.resize(offset + BitmapSize(glyph));
+			memcpy(data.data() + offset, glyph.bitmap_data, BitmapSize(glyph));
+		}
+	}
+}
+
+bool ReadEntry(Reader& reader, CacheEntry& entry)
+{
+	int32_t font_size, x_height, line_height, baseline;
+	uint8_t default_glyphs;
+	uint32_t num_glyphs;
+
+	if (!reader.Read(entry.face_hash) || !reader.Read(font_size) || !reader.Read(default_glyphs) || !reader.Read(x_height) ||
+		!reader.Read(line_height) || !reader.Read(baseline) || !reader.Read(entry.metrics.underline_position) ||
+		!reader.Read(entry.metrics.underline_thickness) || !reader.Read(num_glyphs))
+		return false;
+
+	entry.font_size = font_size;
+	entry.default_glyphs = (default_glyphs != 0);
+	entry.metrics.size = font_size;
+	entry.metrics.x_height = x_height;
+	entry.metrics.line_height = line_height;
+	entry.metrics.baseline = baseline;
+
+	entry.glyphs.reserve(num_glyphs);
+
+	for (uint32_t i = 0; i < num_glyphs; i++)
+	{
+		uint32_t character;
+		int32_t values[7];
+		uint8_t color_format;
+
+		if (!reader.Read(character) || !reader.Read(values) || !reader.Read(color_format) || color_format > uint8_t(ColorFormat::RGBA8))
+			return false;
+
+		FontGlyph glyph;
+		glyph.dimensions = Vector2i(values[0], values[1]);
+		glyph.bearing = Vector2i(values[2], values[3]);
+		glyph.advance = values[4];
+		glyph.bitmap_dimensions = Vector2i(values[5], values[6]);
+		glyph.color_format = ColorFormat(color_format);
+
+		if (glyph.bitmap_dimensions.x < 0 || glyph.bitmap_dimensions.y < 0 || glyph.bitmap_dimensions.x > 4096 || glyph.bitmap_dimensions.y > 4096)
+			return false;
+
+		const int bitmap_size = BitmapSize(glyph);
+		if (bitmap_size > 0)
+		{
+			const byte* bitmap = reader.ReadBytes(bitmap_size);
+			if (!bitmap)
+				return false;
+
+			glyph.bitmap_owned_data.reset(new byte[bitmap_size]);
+			memcpy(glyph.bitmap_owned_data.get(), bitmap, bitmap_size);
+			glyph.bitmap_data = glyph.bitmap_owned_data.get();
+		}
+
+		entry.glyphs[Character(character)] = std::move(glyph);
+	}
+
+	return true;
+}
+
+} // namespace
+
+bool FontGlyphCache::Load(const byte* data, size_t data_size)
+{
+	Clear();
+
+	Reader reader{data, data_size, 0};
+	uint32_t magic = 0, version = 0, num_entries = 0;
+
+	if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(num_entries) || magic != cache_magic)
+	{
+		Log::Message(Log::LT_WARNING, "Invalid font glyph cache data, ignoring the cache.");
+		return false;
+	}
+
+	if (version != cache_version)
+	{
+		Log::Message(Log::LT_INFO, "Font glyph cache is from another version, ignoring the cache.");
+		return false;
+	}
+
+	for (uint32_t i = 0; i < num_entries; i++)
+	{
+		CacheEntry entry;
+		if (!ReadEntry(reader, entry))
+		{
+			Log::Message(Log::LT_WARNING, "Font glyph cache data is truncated or corrupt, ignoring the cache.");
+			Clear();
+			return false;
+		}
+
+		const uint64_t face_hash = entry.face_hash;
+		const int font_size = entry.font_size;
+		cache_entries[face_hash][font_size] = std::move(entry);
+	}
+
+	return true;
+}
+
+void FontGlyphCache::Save(Vector<byte>& out_data)
+{
+	Vector<const FontFaceHandleDefault*> handles;
+	FontProvider::GetFontFaceHandles(handles);
+
+	// Handles in use supersede loaded entries of the same face and size.
+	Vector<const CacheEntry*> unused_entries;
+	for (auto& face_pair : cache_entries)
+	{
+		for (auto& size_pair : face_pair.second)
+		{
+			auto it = std::find_if(handles.begin(), handles.end(), [&](const FontFaceHandleDefault* handle) {
+				return handle->GetFaceHash() == face_pair.first && handle->GetSize() == size_pair.first;
+			});
+			if (it == handles.end())
+				unused_entries.push_back(&size_pair.second);
+		}
+	}
+
+	out_data.clear();
+	Write(out_data, cache_magic);
+	Write(out_data, cache_version);
+	Write(out_data, uint32_t(handles.size() + unused_entries.size()));
+
+	for (const FontFaceHandleDefault* handle : handles)
+		WriteEntry(out_data, handle->GetFaceHash(), handle->GetSize(), handle->HasDefaultGlyphs(), handle->GetMetrics(), handle->GetGlyphs());
+
+	for (const CacheEntry* entry : unused_entries)
+		WriteEntry(out_data, entry->face_hash, entry->font_size, entry->default_glyphs, entry->metrics, entry->glyphs);
+}
+
+bool FontGlyphCache::InitialiseFaceHandle(uint64_t face_hash, int font_size, bool load_default_glyphs, FontGlyphMap& glyphs, FontMetrics& metrics)
+{
+	auto it_face = cache_entries.find(face_hash);
+	if (it_face == cache_entries.end())
+		return false;
+
+	auto it = it_face->second.find(font_size);
+	if (it == it_face->second.end())
+		return false;
+
+	const CacheEntry& entry = it->second;
+	if (load_default_glyphs && !entry.default_glyphs)
+		return false;
+
+	metrics = entry.metrics;
+
+	glyphs.reserve(entry.glyphs.size());
+	for (auto& pair : entry.glyphs)
+		CopyGlyph(glyphs[pair.first], pair.second);
+
+	return true;
+}
+
+void FontGlyphCache::Clear()
+{
+	CacheMap().swap(cache_entries);
+}
+
+} // namespace Rml
@@ -0,0 +1,57 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_FONTENGINEDEFAULT_FONTGLYPHCACHE_H
+#define RMLUI_CORE_FONTENGINEDEFAULT_FONTGLYPHCACHE_H
+
+#include "FontTypes.h"
+
+namespace Rml {
+
+/*
+	Persists rasterised glyphs and font metrics between runs, so that font face handles can be initialised without
+	rasterising their glyphs again. Entries are keyed by the hash of the font face data and the font size.
+*/
+
+namespace FontGlyphCache {
+
+// Replaces the cached entries with those serialised in 'data'. Returns false if the data is invalid or from another version.
+bool Load(const byte* data, size_t data_size);
+
+// Serialises the glyphs of all font face handles in use, and the loaded entries of faces and sizes not currently in use.
+void Save(Vector<byte>& out_data);
+
+// Fills the glyphs and metrics of a new font face handle from the cache. Returns false if the face is not cached at this size.
+bool InitialiseFaceHandle(uint64_t face_hash, int font_size, bool load_default_glyphs, FontGlyphMap& glyphs, FontMetrics& metrics);
+
+// Releases all cached entries.
+void Clear();
+
+} // namespace FontGlyphCache
+} // namespace Rml
+#endif
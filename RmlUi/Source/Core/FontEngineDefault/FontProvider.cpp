@@ -29,6 +29,7 @@
 #include "FontProvider.h"
 #include "FontFace.h"
 #include "FontFamily.h"
+#include "FontGlyphCache.h"
 #include "FreeTypeInterface.h"
 #include "../LayoutInlineBoxText.h"
 #include "../../../Include/RmlUi/Core/Core.h"
@@ -42,6 +43,18 @@ namespace Rml {
 
 static FontProvider* g_font_provider = nullptr;
 
+// FNV-1a hash of the font face data.
+static uint64_t HashFaceData(const byte* data, int data_size)
+{
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for (int i = 0; i < data_size; i++)
+	{
+		hash ^= data[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
 FontProvider::FontProvider()
 {
 	RMLUI_ASSERT(!g_font_provider);
@@ -66,6 +79,7 @@ void FontProvider::Shutdown()
 	RMLUI_ASSERT(g_font_provider);
 	delete g_font_provider;
 	g_font_provider = nullptr;
+	FontGlyphCache::Clear();
 	FreeType::Shutdown();
 }
 
@@ -110,6 +124,13 @@ void FontProvider::ReleaseFontResources()
 		name_family.second->ReleaseFontResources();
 }
 
+void FontProvider::GetFontFaceHandles(Vector<const FontFaceHandleDefault*>& handles)
+{
+	RMLUI_ASSERT(g_font_provider);
+	for (auto& name_family : g_font_provider->font_families)
+		name_family.second->GetFaceHandles(handles);
+}
+
 bool FontProvider::LoadFontFace(const String& file_name, bool fallback_face, Style::FontWeight weight)
 {
 	FileInterface* file_interface = GetFileInterface();
@@ -205,6 +226,8 @@ bool FontProvider::LoadFontFace(const byte* data, int data_size, bool fallback_f
 		return false;
 	}
 
+	const uint64_t data_hash = HashFaceData(data, data_size);
+
 	for (const FaceVariation& variation : load_variations)
 	{
 		FontFaceHandleFreetype ft_face = FreeType::LoadFace(data, data_size, source, variation.named_instance_index);
@@ -219,7 +242,10 @@ bool FontProvider::LoadFontFace(const byte* data, int data_size, bool fallback_f
 		const FontWeight variation_weight = (variation.weight == FontWeight::Auto ? weight : variation.weight);
 		const String font_face_description = FontFaceDescription(font_family, style, variation_weight);
 
-		if (!AddFace(ft_face, font_family, style, variation_weight, fallback_face, std::move(face_memory)))
+		// Identify the face in the glyph cache by its contents, so that the cache stays valid when font files are replaced.
+		const uint64_t face_hash = data_hash ^ (uint64_t(variation.named_instance_index) * 0x9e3779b97f4a7c15ull);
+
+		if (!AddFace(ft_face, font_family, style, variation_weight, fallback_face, std::move(face_memory), face_hash))
 		{
 			Log::Message(Log::LT_ERROR, "Failed to load font face %s from '%s'.", font_face_description.c_str(), source.c_str());
 			return false;
@@ -232,7 +258,7 @@ bool FontProvider::LoadFontFace(const byte* data, int data_size, bool fallback_f
 }
 
 bool FontProvider::AddFace(FontFaceHandleFreetype face, const String& family, Style::FontStyle style, Style::FontWeight weight, bool fallback_face,
-	UniquePtr<byte[]> face_memory)
+	UniquePtr<byte[]> face_memory, uint64_t face_hash)
 {
 	if (family.empty() || weight == Style::FontWeight::Auto)
 		return false;
@@ -251,7 +277,7 @@ bool FontProvider::AddFace(FontFaceHandleFreetype face, const String& family, St
 		font_families[family_lower] = std::move(font_family_ptr);
 	}
 
-	FontFace* font_face_result = font_family->AddFace(face, style, weight, std::move(face_memory));
+	FontFace* font_face_result = font_family->AddFace(face, style, weight, std::move(face_memory), face_hash);
 
 	if (font_face_result && fallback_face)
 	{
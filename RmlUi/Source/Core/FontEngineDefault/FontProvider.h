@@ -75,6 +75,9 @@ public:
 	/// Releases resources owned by sized font faces, including their textures and rendered glyphs.
 	static void ReleaseFontResources();
 
+	/// Returns all sized font face handles currently in use.
+	static void GetFontFaceHandles(Vector<const FontFaceHandleDefault*>& handles);
+
 private:
 	FontProvider();
 	~FontProvider();
@@ -85,7 +88,7 @@ private:
 		String font_family, Style::FontStyle style, Style::FontWeight weight);
 
 	bool AddFace(FontFaceHandleFreetype face, const String& family, Style::FontStyle style, Style::FontWeight weight, bool fallback_face,
-		UniquePtr<byte[]> face_memory);
+		UniquePtr<byte[]> face_memory, uint64_t face_hash);
 
 	using FontFaceList = Vector<FontFace*>;
 	using FontFamilyMap = UnorderedMap< String, UniquePtr<FontFamily>>;
@@ -0,0 +1,241 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "HitTestIndex.h"
+#include "../../Include/RmlUi/Core/ComputedValues.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/ElementUtilities.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "TransformState.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace Rml {
+
+// Upper limit on the number of grid cells, the cell size is increased until the grid fits.
+static constexpr int MaxNumCells = 4096;
+static constexpr float MinCellSize = 64.f;
+// Elements overlapping more cells than this are tested for every query instead.
+static constexpr int MaxCellsPerElement = 64;
+
+void HitTestIndex::MarkDirty()
+{
+	dirty = true;
+}
+
+Element* HitTestIndex::FindElementAtPoint(Element* root, Vector2f point, const Element* ignore_element)
+{
+	if (dirty)
+		Rebuild(root);
+
+	static const Vector<uint32_t> empty_cell;
+	const Vector<uint32_t>* cell = &empty_cell;
+
+	if (num_columns > 0 && num_rows > 0)
+	{
+		const int column = (int)std::floor((point.x - grid_origin.x) / cell_size);
+		const int row = (int)std::floor((point.y - grid_origin.y) / cell_size);
+		if (column >= 0 && column < num_columns && row >= 0 && row < num_rows)
+			cell = &cells[row * num_columns + column];
+	}
+
+	// Merge the candidates from the cell with the unbounded elements, so that they are tested in their original order.
+	auto it_cell = cell->begin();
+	auto it_unbounded = unbounded_indices.begin();
+
+	while (it_cell != cell->end() || it_unbounded != unbounded_indices.end())
+	{
+		uint32_t index;
+		if (it_unbounded == unbounded_indices.end() || (it_cell != cell->end() && *it_cell < *it_unbounded))
+			index = *it_cell++;
+		else
+			index = *it_unbounded++;
+
+		Element* element = elements[index];
+
+		if (ignore_element)
+		{
+			const Element* ancestor = element;
+			while (ancestor && ancestor != ignore_element)
+				ancestor = ancestor->GetParentNode();
+
+			if (ancestor)
+				continue;
+		}
+
+		if (HitTest(element, point))
+			return element;
+	}
+
+	return nullptr;
+}
+
+bool HitTestIndex::HitTest(Element* element, Vector2f point)
+{
+	// Ignore elements whose pointer events are disabled.
+	if (element->GetComputedValues().pointer_events() == Style::PointerEvents::None)
+		return false;
+
+	// Projection may fail if we have a singular transformation matrix.
+	if (!element->Project(point) || !element->IsPointWithinElement(point))
+		return false;
+
+	Vector2i clip_origin, clip_dimensions;
+	if (ElementUtilities::GetClippingRegion(clip_origin, clip_dimensions, element))
+	{
+		return point.x >= clip_origin.x && point.y >= clip_origin.y && point.x <= (clip_origin.x + clip_dimensions.x) &&
+			point.y <= (clip_origin.y + clip_dimensions.y);
+	}
+
+	return true;
+}
+
+void HitTestIndex::Rebuild(Element* root)
+{
+	RMLUI_ZoneScoped;
+
+	dirty = false;
+	elements.clear();
+	unbounded_indices.clear();
+	bounds.clear();
+	cells.clear();
+	num_columns = 0;
+	num_rows = 0;
+
+	AddStackingContext(root);
+
+	if (!bounds.empty())
+	{
+		Vector2f grid_min = bounds[0].min;
+		Vector2f grid_max = bounds[0].max;
+		for (const Bounds& element_bounds : bounds)
+		{
+			grid_min = Math::Min(grid_min, element_bounds.min);
+			grid_max = Math::Max(grid_max, element_bounds.max);
+		}
+
+		const Vector2f grid_size = grid_max - grid_min;
+		if (!std::isfinite(grid_size.x) || !std::isfinite(grid_size.y))
+		{
+			// Test every element rather than building an unbounded grid.
+			for (const Bounds& element_bounds : bounds)
+				unbounded_indices.push_back(element_bounds.index);
+			std::sort(unbounded_indices.begin(), unbounded_indices.end());
+			bounds.clear();
+			return;
+		}
+
+		grid_origin = grid_min;
+		cell_size = MinCellSize;
+		while (true)
+		{
+			num_columns = (int)(grid_size.x / cell_size) + 1;
+			num_rows = (int)(grid_size.y / cell_size) + 1;
+			if (num_columns * num_rows <= MaxNumCells)
+				break;
+			cell_size *= 2.f;
+		}
+
+		cells.resize(num_columns * num_rows);
+
+		for (const Bounds& element_bounds : bounds)
+		{
+			const int column_begin = (int)((element_bounds.min.x - grid_origin.x) / cell_size);
+			const int row_begin = (int)((element_bounds.min.y - grid_origin.y) / cell_size);
+			const int column_end = Math::Min((int)((element_bounds.max.x - grid_origin.x) / cell_size) + 1, num_columns);
+			const int row_end = Math::Min((int)((element_bounds.max.y - grid_origin.y) / cell_size) + 1, num_rows);
+
+			if ((column_end - column_begin) * (row_end - row_begin) > MaxCellsPerElement)
+			{
+				unbounded_indices.push_back(element_bounds.index);
+				continue;
+			}
+
+			for (int row = row_begin; row < row_end; row++)
+			{
+				for (int column = column_begin; column < column_end; column++)
+					cells[row * num_columns + column].push_back(element_bounds.index);
+			}
+		}
+
+		std::sort(unbounded_indices.begin(), unbounded_indices.end());
+	}
+
+	bounds.clear();
+}
+
+void HitTestIndex::AddStackingContext(Element* element)
+{
+	// Mirrors the traversal in Context::GetElementAtPoint(): elements with their own stacking context are searched before themselves, otherwise
+	// later elements in the stacking context are tested first.
+	if (element->stacking_context_dirty)
+		element->BuildLocalStackingContext();
+
+	for (int i = (int)element->stacking_context.size() - 1; i >= 0; --i)
+	{
+		Element* child = element->stacking_context[i];
+		if (child->local_stacking_context)
+			AddStackingContext(child);
+		else
+			AddElement(child);
+	}
+
+	AddElement(element);
+}
+
+void HitTestIndex::AddElement(Element* element)
+{
+	const uint32_t index = (uint32_t)elements.size();
+	elements.push_back(element);
+
+	// The bounds of transformed elements are not easily determined.
+	const TransformState* transform_state = element->GetTransformState();
+	if (transform_state && transform_state->GetTransform())
+	{
+		unbounded_indices.push_back(index);
+		return;
+	}
+
+	const Vector2f position = element->GetAbsoluteOffset(Box::BORDER);
+
+	Bounds element_bounds = {index, Vector2f(FLT_MAX), Vector2f(-FLT_MAX)};
+	for (int i = 0; i < element->GetNumBoxes(); i++)
+	{
+		Vector2f box_offset;
+		const Box& box = element->GetBox(i, box_offset);
+		const Vector2f box_min = position + box_offset;
+		element_bounds.min = Math::Min(element_bounds.min, box_min);
+		element_bounds.max = Math::Max(element_bounds.max, box_min + box.GetSize(Box::BORDER));
+	}
+
+	bounds.push_back(element_bounds);
+}
+
+} // namespace Rml
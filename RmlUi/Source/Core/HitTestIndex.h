@@ -0,0 +1,92 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_HITTESTINDEX_H
+#define RMLUI_CORE_HITTESTINDEX_H
+
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class Element;
+
+/**
+	A spatial index of the elements in a document for finding the element under a point.
+
+	The elements of the document's stacking context are flattened into the order in which they would be tested by walking the nested stacking
+	contexts from top to bottom, and their border boxes are bucketed into a uniform grid. A query only tests the elements in the grid cell under
+	the point, in addition to transformed and very large elements which are always tested. The index is rebuilt on the first query after it has
+	been marked dirty by changes to the stacking context, layout or transforms of any of its elements.
+ */
+
+class HitTestIndex : NonCopyMoveable {
+public:
+	/// Marks the index as outdated, it is rebuilt on the next query.
+	void MarkDirty();
+
+	/// Returns the topmost element under the point in the stacking context of the root element, including the root itself.
+	/// @param[in] root The element owning the index, must have a local stacking context.
+	/// @param[in] point The point to test, in window coordinates.
+	/// @param[in] ignore_element If set, this element and its descendants are ignored.
+	/// @return The element found, or nullptr if no element is under the point.
+	Element* FindElementAtPoint(Element* root, Vector2f point, const Element* ignore_element);
+
+	/// Returns true if the point lies within one of the element's border boxes and its clipping region, after projecting the point onto the
+	/// element's plane. Elements without pointer events are never hit.
+	static bool HitTest(Element* element, Vector2f point);
+
+private:
+	void Rebuild(Element* root);
+	void AddStackingContext(Element* element);
+	void AddElement(Element* element);
+
+	struct Bounds {
+		uint32_t index;
+		Vector2f min, max;
+	};
+
+	bool dirty = true;
+
+	// All elements in the order they are tested.
+	Vector<Element*> elements;
+	// Indices of elements tested regardless of the point, in ascending order.
+	Vector<uint32_t> unbounded_indices;
+	// Bounds of the remaining elements, only used while rebuilding.
+	Vector<Bounds> bounds;
+
+	// Grid cells, each holding the indices of the elements overlapping it in ascending order.
+	Vector<Vector<uint32_t>> cells;
+	Vector2f grid_origin;
+	float cell_size = 0.f;
+	int num_columns = 0;
+	int num_rows = 0;
+};
+
+} // namespace Rml
+#endif
@@ -0,0 +1,101 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "LayoutArena.h"
+#include "../../Include/RmlUi/Core/Debug.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include <cstddef>
+#include <new>
+
+namespace Rml {
+
+LayoutArena::LayoutArena(size_t block_size) : block_size(GetAlignedSize(block_size))
+{}
+
+void* LayoutArena::Allocate(size_t size)
+{
+	size = GetAlignedSize(size);
+	num_live_allocations += 1;
+	used_size += size;
+	high_water_mark = Math::Max(high_water_mark, used_size);
+
+	if (size > block_size)
+		return ::operator new(size);
+
+	if (blocks.empty())
+	{
+		blocks.push_back(UniquePtr<byte[]>(new byte[block_size]));
+	}
+	else if (block_offset + size > block_size)
+	{
+		block_index += 1;
+		block_offset = 0;
+		if (block_index == blocks.size())
+			blocks.push_back(UniquePtr<byte[]>(new byte[block_size]));
+	}
+
+	byte* memory = blocks[block_index].get() + block_offset;
+	block_offset += size;
+
+	return memory;
+}
+
+void LayoutArena::Deallocate(void* memory, size_t size)
+{
+	RMLUI_ASSERT(num_live_allocations > 0);
+
+	size = GetAlignedSize(size);
+	if (size > block_size)
+		::operator delete(memory);
+
+	num_live_allocations -= 1;
+	if (num_live_allocations == 0)
+	{
+		block_index = 0;
+		block_offset = 0;
+		used_size = 0;
+	}
+}
+
+size_t LayoutArena::GetHighWaterMark() const
+{
+	return high_water_mark;
+}
+
+void LayoutArena::ResetHighWaterMark()
+{
+	high_water_mark = used_size;
+}
+
+size_t LayoutArena::GetAlignedSize(size_t size)
+{
+	constexpr size_t alignment = alignof(std::max_align_t);
+	return (size + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace Rml
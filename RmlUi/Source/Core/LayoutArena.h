@@ -0,0 +1,77 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_LAYOUTARENA_H
+#define RMLUI_CORE_LAYOUTARENA_H
+
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+/**
+	A bump-pointer allocator for the short-lived boxes created while formatting elements.
+
+	Memory is handed out from large blocks in allocation order, and released memory is not reused individually. Instead, once every allocation
+	has been released, which happens at the end of each layout, the arena rewinds to the start of its first block. Blocks are kept for the
+	next layout. Allocations too large for a block are passed on to the general-purpose allocator.
+ */
+
+class LayoutArena : NonCopyMoveable {
+public:
+	/// @param[in] block_size The size of each block of memory in bytes.
+	explicit LayoutArena(size_t block_size);
+
+	/// Allocates memory aligned for any fundamental type.
+	void* Allocate(size_t size);
+	/// Releases memory from Allocate(), the size must match the allocated size.
+	void Deallocate(void* memory, size_t size);
+
+	/// Returns the largest number of bytes handed out between two rewinds of the arena, since the high-water mark was last reset.
+	size_t GetHighWaterMark() const;
+	/// Resets the high-water mark to the number of bytes handed out since the last rewind.
+	void ResetHighWaterMark();
+
+private:
+	static size_t GetAlignedSize(size_t size);
+
+	size_t block_size;
+	Vector<UniquePtr<byte[]>> blocks;
+
+	// The position of the next allocation.
+	size_t block_index = 0;
+	size_t block_offset = 0;
+
+	size_t num_live_allocations = 0;
+	// Bytes handed out since the last rewind, including released ones.
+	size_t used_size = 0;
+	size_t high_water_mark = 0;
+};
+
+} // namespace Rml
+#endif
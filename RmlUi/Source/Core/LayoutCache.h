@@ -0,0 +1,152 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_LAYOUTCACHE_H
+#define RMLUI_CORE_LAYOUTCACHE_H
+
+#include "../../Include/RmlUi/Core/Box.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+/**
+	Results from formatting an element, kept between layouts to avoid formatting the same contents under the same constraints more than once.
+
+	Each result is keyed by the constraints it was produced under. All results are cleared whenever the layout of the element or any of its
+	descendants is dirtied, as they may no longer be reproduced by formatting the element again. The containing block of the last format is
+	kept regardless, so that a layout boundary can be formatted again on its own under the same constraints as in the layout of its parent.
+ */
+
+class LayoutCache {
+public:
+	/// Clears all results.
+	void Clear()
+	{
+		format.valid = false;
+		measure.valid = false;
+		shrink_to_fit.valid = false;
+	}
+
+	/// Returns true if the current layout of the element and its descendants is the result of formatting the element as a root under the given
+	/// constraints, and nothing affecting it has changed since.
+	/// @param[out] out_visible_overflow_size The visible overflow size resulting from this layout.
+	bool FindFormat(Vector2f containing_block, const Box* override_initial_box, Vector2f& out_visible_overflow_size) const
+	{
+		if (!format.valid || format.containing_block != containing_block || format.has_override_box != (override_initial_box != nullptr) ||
+			(override_initial_box && format.override_box != *override_initial_box))
+			return false;
+
+		out_visible_overflow_size = format.visible_overflow_size;
+		return true;
+	}
+	/// Stores the constraints of the element's current layout, after formatting the element as a root.
+	void StoreFormat(Vector2f containing_block, const Box* override_initial_box, Vector2f visible_overflow_size)
+	{
+		format.valid = true;
+		format.containing_block = containing_block;
+		format.has_override_box = (override_initial_box != nullptr);
+		format.override_box = (override_initial_box ? *override_initial_box : Box());
+		format.visible_overflow_size = visible_overflow_size;
+	}
+	/// Returns the containing block the element was last formatted under as a root, false if it has never been formatted as a root.
+	bool GetRootContainingBlock(Vector2f& out_containing_block) const
+	{
+		if (!has_root_containing_block)
+			return false;
+		out_containing_block = root_containing_block;
+		return true;
+	}
+	void StoreRootContainingBlock(Vector2f containing_block)
+	{
+		has_root_containing_block = true;
+		root_containing_block = containing_block;
+	}
+
+	/// Called when the layout of the element is modified other than by formatting it as a root. Any measurements remain valid.
+	void ClearFormat() { format.valid = false; }
+
+	/// Returns the box resulting from formatting the element with the given initial box, or nullptr if not measured.
+	const Box* FindMeasure(Vector2f containing_block, const Box& initial_box) const
+	{
+		if (!measure.valid || measure.containing_block != containing_block || measure.initial_box != initial_box)
+			return nullptr;
+		return &measure.result_box;
+	}
+	void StoreMeasure(Vector2f containing_block, const Box& initial_box, const Box& result_box)
+	{
+		measure.valid = true;
+		measure.containing_block = containing_block;
+		measure.initial_box = initial_box;
+		measure.result_box = result_box;
+	}
+
+	/// Returns true and retrieves the shrink-to-fit width of the element, if measured for the given containing block.
+	bool FindShrinkToFitWidth(Vector2f containing_block, float& out_width) const
+	{
+		if (!shrink_to_fit.valid || shrink_to_fit.containing_block != containing_block)
+			return false;
+		out_width = shrink_to_fit.width;
+		return true;
+	}
+	void StoreShrinkToFitWidth(Vector2f containing_block, float width)
+	{
+		shrink_to_fit.valid = true;
+		shrink_to_fit.containing_block = containing_block;
+		shrink_to_fit.width = width;
+	}
+
+private:
+	struct FormatEntry {
+		bool valid = false;
+		bool has_override_box = false;
+		Vector2f containing_block;
+		Box override_box;
+		Vector2f visible_overflow_size;
+	};
+	struct MeasureEntry {
+		bool valid = false;
+		Vector2f containing_block;
+		Box initial_box;
+		Box result_box;
+	};
+	struct ShrinkToFitEntry {
+		bool valid = false;
+		Vector2f containing_block;
+		float width = 0.f;
+	};
+
+	FormatEntry format;
+	MeasureEntry measure;
+	ShrinkToFitEntry shrink_to_fit;
+
+	bool has_root_containing_block = false;
+	Vector2f root_containing_block;
+};
+
+} // namespace Rml
+#endif
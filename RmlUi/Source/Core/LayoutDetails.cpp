@@ -32,6 +32,7 @@
 #include "../../Include/RmlUi/Core/ElementScroll.h"
 #include "../../Include/RmlUi/Core/Math.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
+#include "LayoutCache.h"
 #include "LayoutEngine.h"
 #include <float.h>
 
@@ -244,6 +245,14 @@ float LayoutDetails::GetShrinkToFitWidth(Element* element, Vector2f containing_b
 {
 	RMLUI_ASSERT(element);
 
+	LayoutCache& layout_cache = element->GetLayoutCache();
+	float cached_width = 0.f;
+	if (layout_cache.FindShrinkToFitWidth(containing_block, cached_width))
+		return cached_width;
+
+	// The element and its children are formatted below in a temporary block box, replacing their current layout.
+	layout_cache.ClearFormat();
+
 	Box box;
 	float min_height, max_height;
 	LayoutDetails::BuildBox(box, containing_block, element, BoxContext::Block, containing_block.x);
@@ -269,7 +278,10 @@ float LayoutDetails::GetShrinkToFitWidth(Element* element, Vector2f containing_b
 	// away with not closing the boxes. This is avoided for performance reasons.
 	//block_context_box->Close();
 
-	return Math::Min(containing_block.x, block_context_box->GetShrinkToFitWidth());
+	const float shrink_to_fit_width = Math::Min(containing_block.x, block_context_box->GetShrinkToFitWidth());
+	layout_cache.StoreShrinkToFitWidth(containing_block, shrink_to_fit_width);
+
+	return shrink_to_fit_width;
 }
 
 ComputedAxisSize LayoutDetails::BuildComputedHorizontalSize(const ComputedValues& computed)
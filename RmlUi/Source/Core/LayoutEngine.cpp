@@ -31,31 +31,22 @@
 #include "../../Include/RmlUi/Core/Element.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include "LayoutArena.h"
 #include "LayoutBlockBoxSpace.h"
+#include "LayoutCache.h"
 #include "LayoutDetails.h"
 #include "LayoutFlex.h"
 #include "LayoutInlineBoxText.h"
 #include "LayoutTable.h"
-#include "Pool.h"
 #include <cstddef>
 #include <float.h>
 
 namespace Rml {
 
-#define MAX(a, b) (a > b ? a : b)
+// Layout boxes only live for the duration of a single layout, thus they are all released together by the end of it.
+static LayoutArena layout_arena(64 * 1024);
 
-template <size_t Size>
-struct LayoutChunk {
-	alignas(std::max_align_t) byte buffer[Size];
-};
-
-static constexpr std::size_t ChunkSizeBig = sizeof(LayoutBlockBox);
-static constexpr std::size_t ChunkSizeMedium = MAX(sizeof(LayoutInlineBox), sizeof(LayoutInlineBoxText));
-static constexpr std::size_t ChunkSizeSmall = MAX(sizeof(LayoutLineBox), sizeof(LayoutBlockBoxSpace));
-
-static Pool< LayoutChunk<ChunkSizeBig> > layout_chunk_pool_big(50, true);
-static Pool< LayoutChunk<ChunkSizeMedium> > layout_chunk_pool_medium(50, true);
-static Pool< LayoutChunk<ChunkSizeSmall> > layout_chunk_pool_small(50, true);
+static uint64_t num_formatted_elements = 0;
 
 static inline bool ValidateTopLevelElement(Element* element)
 {
@@ -84,6 +75,29 @@ static inline bool ValidateTopLevelElement(Element* element)
 	return true;
 }
 
+// Returns true if the element is an in-flow block whose size does not depend on its contents, and which is formatted as an independent
+// formatting context.
+static bool IsIndependentBlock(Element* element)
+{
+	using namespace Style;
+	const ComputedValues& computed = element->GetComputedValues();
+
+	if (computed.display() != Display::Block || computed.float_() != Float::None || computed.position() == Position::Absolute ||
+		computed.position() == Position::Fixed)
+		return false;
+
+	// Percentage heights resolve to 'auto' inside parents of automatic height, thus only lengths are definite.
+	if (computed.width().type == Width::Auto || computed.height().type != Height::Length)
+		return false;
+
+	if (computed.contain() == Contain::Layout)
+		return true;
+
+	// Relatively positioned elements are already the containing block of their absolutely positioned descendants, while clipping prevents their
+	// contents from overflowing into the parent.
+	return computed.position() == Position::Relative && computed.overflow_x() != Overflow::Visible && computed.overflow_y() != Overflow::Visible;
+}
+
 // Formats the contents for a root-level element (usually a document or floating element).
 void LayoutEngine::FormatElement(Element* element, Vector2f containing_block, const Box* override_initial_box, Vector2f* out_visible_overflow_size)
 {
@@ -96,7 +110,22 @@ void LayoutEngine::FormatElement(Element* element, Vector2f containing_block, co
 
 	if (!ValidateTopLevelElement(element))
 		return;
-	
+
+	// Nothing needs to be done if the element's current layout was formatted under the same constraints, and nothing has changed since.
+	LayoutCache& layout_cache = element->GetLayoutCache();
+	layout_cache.StoreRootContainingBlock(containing_block);
+
+	Vector2f cached_visible_overflow_size;
+	if (layout_cache.FindFormat(containing_block, override_initial_box, cached_visible_overflow_size))
+	{
+		if (out_visible_overflow_size)
+			*out_visible_overflow_size = cached_visible_overflow_size;
+		element->OnLayout();
+		return;
+	}
+
+	num_formatted_elements += 1;
+
 	auto containing_block_box = MakeUnique<LayoutBlockBox>(nullptr, nullptr, Box(containing_block), 0.0f, FLT_MAX);
 
 	Box box;
@@ -124,41 +153,90 @@ void LayoutEngine::FormatElement(Element* element, Vector2f containing_block, co
 
 	block_context_box->CloseAbsoluteElements();
 
+	const Vector2f visible_overflow_size = block_context_box->GetVisibleOverflowSize();
 	if (out_visible_overflow_size)
-		*out_visible_overflow_size = block_context_box->GetVisibleOverflowSize();
+		*out_visible_overflow_size = visible_overflow_size;
+
+	layout_cache.StoreFormat(containing_block, override_initial_box ? &box : nullptr, visible_overflow_size);
 
 	element->OnLayout();
 }
 
+Box LayoutEngine::MeasureElement(Element* element, Vector2f containing_block, const Box& initial_box)
+{
+	LayoutCache& layout_cache = element->GetLayoutCache();
+	if (const Box* cached_box = layout_cache.FindMeasure(containing_block, initial_box))
+		return *cached_box;
+
+	FormatElement(element, containing_block, &initial_box);
+
+	const Box result_box = element->GetBox();
+	layout_cache.StoreMeasure(containing_block, initial_box, result_box);
+	return result_box;
+}
+
+bool LayoutEngine::IsLayoutBoundary(Element* element)
+{
+	const Style::Position position = element->GetComputedValues().position();
+	if (position == Style::Position::Absolute || position == Style::Position::Fixed)
+		return true;
+
+	return IsIndependentBlock(element);
+}
+
+bool LayoutEngine::FormatLayoutBoundary(Element* element)
+{
+	RMLUI_ZoneScopedC(0xB22222);
+	RMLUI_ASSERT(IsLayoutBoundary(element));
+
+	// Hidden elements are formatted when they become visible, which dirties the layout of their parent.
+	if (!element->IsVisible(true))
+		return true;
+
+	if (!element->GetParentNode())
+		return false;
+
+	// Format the element with the same containing block as during the layout of its parent. The containing block may not be derived from the
+	// parent's box, as eg. the parent's height is treated as indefinite when it is sized automatically.
+	Vector2f containing_block;
+	if (!element->GetLayoutCache().GetRootContainingBlock(containing_block))
+		return false;
+
+	const Box previous_box = element->GetBox();
+	const Style::Position position = element->GetComputedValues().position();
+
+	if (position == Style::Position::Absolute || position == Style::Position::Fixed)
+		FormatElement(element, containing_block);
+	else
+		FormatElement(element, containing_block, &previous_box);
+
+	// The position of the element was determined using its margins, and any element laid out after it may depend on its size.
+	return element->GetBox() == previous_box;
+}
+
+uint64_t LayoutEngine::GetNumFormattedElements()
+{
+	return num_formatted_elements;
+}
+
 void* LayoutEngine::AllocateLayoutChunk(size_t size)
 {
-	static_assert(ChunkSizeBig > ChunkSizeMedium && ChunkSizeMedium > ChunkSizeSmall, "The following assumes a strict ordering of the chunk sizes.");
-
-	// Note: If any change is made here, make sure a corresponding change is applied to the deallocation procedure below.
-	if (size <= ChunkSizeSmall)
-		return layout_chunk_pool_small.AllocateAndConstruct();
-	else if (size <= ChunkSizeMedium)
-		return layout_chunk_pool_medium.AllocateAndConstruct();
-	else if (size <= ChunkSizeBig)
-		return layout_chunk_pool_big.AllocateAndConstruct();
-
-	RMLUI_ERROR;
-	return nullptr;
+	return layout_arena.Allocate(size);
 }
 
 void LayoutEngine::DeallocateLayoutChunk(void* chunk, size_t size)
 {
-	// Note: If any change is made here, make sure a corresponding change is applied to the allocation procedure above.
-	if (size <= ChunkSizeSmall)
-		layout_chunk_pool_small.DestroyAndDeallocate((LayoutChunk<ChunkSizeSmall>*)chunk);
-	else if (size <= ChunkSizeMedium)
-		layout_chunk_pool_medium.DestroyAndDeallocate((LayoutChunk<ChunkSizeMedium>*)chunk);
-	else if (size <= ChunkSizeBig)
-		layout_chunk_pool_big.DestroyAndDeallocate((LayoutChunk<ChunkSizeBig>*)chunk);
-	else
-	{
-		RMLUI_ERROR;
-	}
+	layout_arena.Deallocate(chunk, size);
+}
+
+size_t LayoutEngine::GetLayoutArenaHighWaterMark()
+{
+	return layout_arena.GetHighWaterMark();
+}
+
+void LayoutEngine::ResetLayoutArenaHighWaterMark()
+{
+	layout_arena.ResetHighWaterMark();
 }
 
 // Positions a single element and its children within this layout.
@@ -182,6 +260,8 @@ bool LayoutEngine::FormatElement(LayoutBlockBox* block_context_box, Element* ele
 	if (display == Style::Display::None)
 		return true;
 
+	num_formatted_elements += 1;
+
 	// Tables and flex boxes need to be specially handled when they are absolutely positioned or floated. Currently it is assumed for both
 	// FormatElement(element, containing_block) and GetShrinkToFitWidth(), and possibly others, that they are strictly called on block boxes.
 	// The mentioned functions need to be updated if we want to support all combinations of display, position, and float properties.
@@ -219,6 +299,11 @@ bool LayoutEngine::FormatElement(LayoutBlockBox* block_context_box, Element* ele
 		return block_context_box->AddFloatElement(element);
 	}
 
+	// Formatting the element within our context replaces any layout cached from formatting it on its own, except for inline-blocks which are
+	// formatted on their own below.
+	if (element->layout_cache && display != Style::Display::InlineBlock)
+		element->layout_cache->ClearFormat();
+
 	// The element is nothing exceptional, so format it according to its display property.
 	switch (display)
 	{
@@ -261,6 +346,17 @@ bool LayoutEngine::FormatElementBlock(LayoutBlockBox* block_context_box, Element
 	if (new_block_context_box == nullptr)
 		return false;
 
+	if (IsIndependentBlock(element))
+	{
+		// The size of the block is definite, so we can place it without its contents. The contents are then formatted separately, exactly as
+		// when the block is formatted on its own as a layout boundary.
+		if (new_block_context_box->Close() != LayoutBlockBox::OK)
+			return false;
+
+		FormatElement(element, LayoutDetails::GetContainingBlock(block_context_box), &element->GetBox());
+		return true;
+	}
+
 	// Format the element's children.
 	for (int i = 0; i < element->GetNumChildren(); i++)
 	{
@@ -56,9 +56,36 @@ public:
 	/// @param[in] element The element to lay out.
 	static bool FormatElement(LayoutBlockBox* block_context_box, Element* element);
 
+	/// Formats the element as a root and returns its resulting box, reusing the result of an earlier call with the same constraints if nothing has
+	/// changed since.
+	/// @param[in] element The element to measure.
+	/// @param[in] containing_block The size of the containing block.
+	/// @param[in] initial_box The initial box of the element, as for FormatElement().
+	/// @return The box of the element after formatting.
+	/// @note The layout of the element is not updated when the result is reused, thus it must be formatted again before its layout is used.
+	static Box MeasureElement(Element* element, Vector2f containing_block, const Box& initial_box);
+
+	/// Returns true if changes inside the element never affect the layout outside of it, so that its contents can be formatted on their own. This
+	/// applies to absolutely positioned elements, and to blocks of definite width and height which either have 'contain: layout' set, or are
+	/// relatively positioned and clip their overflow. Such blocks are always formatted as independent formatting contexts.
+	/// @param[in] element The element to test.
+	static bool IsLayoutBoundary(Element* element);
+	/// Formats a layout boundary on its own, keeping the position determined by the last layout of its parent.
+	/// @param[in] element The layout boundary to format.
+	/// @return False if the element's box changed, then the layout outside the element is invalid and its document must be formatted in full.
+	static bool FormatLayoutBoundary(Element* element);
+
+	/// Returns the number of elements formatted since initialisation, including those formatted as the root of a layout. Roots whose cached
+	/// layout is reused are not counted.
+	static uint64_t GetNumFormattedElements();
+
 	static void* AllocateLayoutChunk(size_t size);
 	static void DeallocateLayoutChunk(void* chunk, size_t size);
 
+	/// Returns the largest number of bytes used for layout boxes during a single layout, since the last reset.
+	static size_t GetLayoutArenaHighWaterMark();
+	static void ResetLayoutArenaHighWaterMark();
+
 private:
 	/// Formats and positions an element as a block element.
 	/// @param[in] block_context_box The open block box to layout the element in.
@@ -74,6 +74,12 @@ bool RenderInterface::GenerateTexture(TextureHandle& /*texture_handle*/, const b
 	return false;
 }
 
+// Called by RmlUi when a region of a previously generated texture has changed.
+bool RenderInterface::UpdateTexture(TextureHandle /*texture_handle*/, const byte* /*source*/, const Vector2i& /*source_dimensions*/, const Vector2i& /*region_offset*/, const Vector2i& /*region_dimensions*/)
+{
+	return false;
+}
+
 // Called by RmlUi when a loaded texture is no longer required.
 void RenderInterface::ReleaseTexture(TextureHandle /*texture*/)
 {
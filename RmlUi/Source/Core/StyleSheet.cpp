@@ -39,10 +39,16 @@
 
 namespace Rml {
 
+// Atoms must not be created concurrently, thus the atom is created along with the style sheets instead of during matching.
+static Atom text_tag_atom = Atom::Invalid;
+
 StyleSheet::StyleSheet()
 {
 	root = MakeUnique<StyleSheetNode>();
 	specificity_offset = 0;
+
+	if (text_tag_atom == Atom::Invalid)
+		text_tag_atom = AtomTable::GetOrCreate("#text");
 }
 
 StyleSheet::~StyleSheet()
@@ -196,22 +202,25 @@ const Sprite* StyleSheet::GetSprite(const String& name) const
 }
 
 // Returns the compiled element definition for a given element hierarchy.
-SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Element* element) const
+SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Element* element, bool* out_sibling_shareable) const
 {
-	RMLUI_ASSERT_NONRECURSIVE;
-
-	// Using static to avoid allocations. Make sure we don't call this function recursively.
-	static Vector< const StyleSheetNode* > applicable_nodes;
+	// Using thread-local storage to avoid allocations while still allowing definitions to be resolved concurrently.
+	static thread_local Vector< const StyleSheetNode* > applicable_nodes;
 	applicable_nodes.clear();
 
-	auto AddApplicableNodes = [element](const StyleSheetIndex::NodeIndex& node_index, const String& key) {
-		auto it_nodes = node_index.find(Hash<String>()(key));
+	// The definition can only be shared if every node considered, whether it applies or not, would be decided the same way for the siblings.
+	bool sibling_shareable = true;
+
+	auto AddApplicableNodes = [element, &sibling_shareable](const StyleSheetIndex::NodeIndex& node_index, Atom key) {
+		auto it_nodes = node_index.find(static_cast<std::size_t>(key));
 		if (it_nodes != node_index.end())
 		{
 			const StyleSheetIndex::NodeList& nodes = it_nodes->second;
 
 			for (const StyleSheetNode* node : nodes)
 			{
+				sibling_shareable &= node->IsSiblingShareable();
+
 				// We found a node that has at least one requirement matching the element. Now see if we satisfy the remaining requirements of the
 				// node, including all ancestor nodes. What this involves is traversing the style nodes backwards, trying to match nodes in the
 				// element's hierarchy to nodes in the style hierarchy.
@@ -222,19 +231,23 @@ SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Elemen
 	};
 
 	// See if there are any styles defined for this element.
-	const String& tag = element->GetTagName();
-	const String& id = element->GetId();
-	const StringList& class_names = element->GetStyle()->GetClassNameList();
+	const ElementStyle* style = element->GetStyle();
+	const Atom tag = style->GetTagAtom();
+	const Atom id = style->GetIdAtom();
 
 	// Text elements are never matched.
-	if (tag == "#text")
+	if (tag == text_tag_atom)
+	{
+		if (out_sibling_shareable)
+			*out_sibling_shareable = true;
 		return nullptr;
+	}
 
 	// First, look up the indexed requirements. 
-	if (!id.empty())
+	if (id != Atom::Invalid)
 		AddApplicableNodes(styled_node_index.ids, id);
 
-	for (const String& name : class_names)
+	for (Atom name : style->GetClassAtomList())
 		AddApplicableNodes(styled_node_index.classes, name);
 
 	AddApplicableNodes(styled_node_index.tags, tag);
@@ -242,10 +255,17 @@ SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Elemen
 	// Also check all remaining nodes that don't contain any indexed requirements.
 	for (const StyleSheetNode* node : styled_node_index.other)
 	{
+		sibling_shareable &= node->IsSiblingShareable();
+
 		if (node->IsApplicable(element))
 			applicable_nodes.push_back(node);
 	}
 
+	StyleSheetNode::FlushMatchStats();
+
+	if (out_sibling_shareable)
+		*out_sibling_shareable = sibling_shareable;
+
 	// If this element definition won't actually store any information, don't bother with it.
 	if (applicable_nodes.empty())
 		return nullptr;
@@ -260,6 +280,7 @@ SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Elemen
 	});
 
 	// Check if this puppy has already been cached in the node index.
+	std::lock_guard<std::mutex> lock(node_cache_mutex);
 	SharedPtr<const ElementDefinition>& definition = node_cache[applicable_nodes];
 	if (!definition)
 	{
@@ -30,13 +30,29 @@
 #include "../../Include/RmlUi/Core/Element.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/StyleSheet.h"
+#include "ElementStyle.h"
 #include "StyleSheetFactory.h"
 #include "StyleSheetSelector.h"
 #include <algorithm>
+#include <atomic>
 #include <tuple>
 
 namespace Rml {
 
+namespace {
+	// Counters are accumulated per thread and only added to the shared totals once per matched element.
+	struct MatchCounters {
+		uint64_t ancestor_filter_rejects = 0;
+		uint64_t hierarchy_walks = 0;
+		uint64_t matches = 0;
+	};
+	thread_local MatchCounters local_match_counters;
+
+	std::atomic<uint64_t> total_ancestor_filter_rejects{0};
+	std::atomic<uint64_t> total_hierarchy_walks{0};
+	std::atomic<uint64_t> total_matches{0};
+} // namespace
+
 static inline bool IsTextElement(const Element* element)
 {
 	return element->GetTagName() == "#text";
@@ -50,11 +66,15 @@ StyleSheetNode::StyleSheetNode()
 StyleSheetNode::StyleSheetNode(StyleSheetNode* parent, const CompoundSelector& selector) : parent(parent), selector(selector)
 {
 	CalculateAndSetSpecificity();
+	CalculateAncestorRequirements();
+	CalculateSiblingShareable();
 }
 
 StyleSheetNode::StyleSheetNode(StyleSheetNode* parent, CompoundSelector&& selector) : parent(parent), selector(std::move(selector))
 {
 	CalculateAndSetSpecificity();
+	CalculateAncestorRequirements();
+	CalculateSiblingShareable();
 }
 
 StyleSheetNode* StyleSheetNode::GetOrCreateChildNode(const CompoundSelector& other)
@@ -131,8 +151,8 @@ void StyleSheetNode::BuildIndex(StyleSheetIndex& styled_node_index) const
 	// If this has properties defined, then we insert it into the styled node index.
 	if (properties.GetNumProperties() > 0)
 	{
-		auto IndexInsertNode = [](StyleSheetIndex::NodeIndex& node_index, const String& key, const StyleSheetNode* node) {
-			StyleSheetIndex::NodeList& nodes = node_index[Hash<String>()(key)];
+		auto IndexInsertNode = [](StyleSheetIndex::NodeIndex& node_index, Atom key, const StyleSheetNode* node) {
+			StyleSheetIndex::NodeList& nodes = node_index[static_cast<std::size_t>(key)];
 			auto it = std::find(nodes.begin(), nodes.end(), node);
 			if (it == nodes.end())
 				nodes.push_back(node);
@@ -140,7 +160,7 @@ void StyleSheetNode::BuildIndex(StyleSheetIndex& styled_node_index) const
 
 		// Add this node to the appropriate index for looking up applicable nodes later. Prioritize the most unique requirement first and the most
 		// general requirement last. This way we are able to rule out as many nodes as possible as quickly as possible.
-		if (!selector.id.empty())
+		if (selector.id != Atom::Invalid)
 		{
 			IndexInsertNode(styled_node_index.ids, selector.id, this);
 		}
@@ -150,7 +170,7 @@ void StyleSheetNode::BuildIndex(StyleSheetIndex& styled_node_index) const
 			// class with the most unique name. For example by adding the class from this node's list that has the fewest existing matches.
 			IndexInsertNode(styled_node_index.classes, selector.class_names.front(), this);
 		}
-		else if (!selector.tag.empty())
+		else if (selector.tag != Atom::Invalid)
 		{
 			IndexInsertNode(styled_node_index.tags, selector.tag, this);
 		}
@@ -170,6 +190,11 @@ int StyleSheetNode::GetSpecificity() const
 	return specificity;
 }
 
+bool StyleSheetNode::IsSiblingShareable() const
+{
+	return sibling_shareable;
+}
+
 // Imports properties from a single rule definition (ie, with a shared specificity) into the node's
 // properties.
 void StyleSheetNode::ImportProperties(const PropertyDictionary& _properties, int rule_specificity)
@@ -185,21 +210,23 @@ const PropertyDictionary& StyleSheetNode::GetProperties() const
 
 bool StyleSheetNode::Match(const Element* element) const
 {
-	if (!selector.tag.empty() && selector.tag != element->GetTagName())
+	const ElementStyle* style = element->GetStyle();
+
+	if (selector.tag != Atom::Invalid && selector.tag != style->GetTagAtom())
 		return false;
 
-	if (!selector.id.empty() && selector.id != element->GetId())
+	if (selector.id != Atom::Invalid && selector.id != style->GetIdAtom())
 		return false;
 
-	for (auto& name : selector.class_names)
+	for (Atom name : selector.class_names)
 	{
-		if (!element->IsClassSet(name))
+		if (!style->IsClassSet(name))
 			return false;
 	}
 
-	for (auto& name : selector.pseudo_class_names)
+	for (Atom name : selector.pseudo_class_names)
 	{
-		if (!element->IsPseudoClassSet(name))
+		if (!style->IsPseudoClassSet(name))
 			return false;
 	}
 
@@ -368,22 +395,24 @@ bool StyleSheetNode::IsApplicable(const Element* element) const
 
 	// We could in principle just call Match() here and then go on with the ancestor style nodes. Instead, we test the requirements of this node in a
 	// particular order for performance reasons.
-	for (const String& name : selector.pseudo_class_names)
+	ElementStyle* style = element->GetStyle();
+
+	for (Atom name : selector.pseudo_class_names)
 	{
-		if (!element->IsPseudoClassSet(name))
+		if (!style->IsPseudoClassSet(name))
 			return false;
 	}
 
-	if (!selector.tag.empty() && selector.tag != element->GetTagName())
+	if (selector.tag != Atom::Invalid && selector.tag != style->GetTagAtom())
 		return false;
 
-	for (const String& name : selector.class_names)
+	for (Atom name : selector.class_names)
 	{
-		if (!element->IsClassSet(name))
+		if (!style->IsClassSet(name))
 			return false;
 	}
 
-	if (!selector.id.empty() && selector.id != element->GetId())
+	if (selector.id != Atom::Invalid && selector.id != style->GetIdAtom())
 		return false;
 
 	if (!selector.attributes.empty() && !MatchAttributes(element))
@@ -394,21 +423,97 @@ bool StyleSheetNode::IsApplicable(const Element* element) const
 		return false;
 
 	// Walk up through all our parent nodes, each one of them must be matched by some ancestor or sibling element.
-	if (parent && !TraverseMatch(element))
-		return false;
+	if (parent && parent->parent)
+	{
+		// Before walking, reject the element if any names required from its ancestors are definitely missing.
+		if (!ancestor_requirements.IsEmpty() && !style->GetAncestorFilter().MayContainAll(ancestor_requirements))
+		{
+			local_match_counters.ancestor_filter_rejects += 1;
+			return false;
+		}
+
+		local_match_counters.hierarchy_walks += 1;
+		if (!TraverseMatch(element))
+			return false;
+	}
 
+	local_match_counters.matches += 1;
 	return true;
 }
 
+void StyleSheetNode::FlushMatchStats()
+{
+	MatchCounters& counters = local_match_counters;
+	if (counters.ancestor_filter_rejects)
+		total_ancestor_filter_rejects.fetch_add(counters.ancestor_filter_rejects, std::memory_order_relaxed);
+	if (counters.hierarchy_walks)
+		total_hierarchy_walks.fetch_add(counters.hierarchy_walks, std::memory_order_relaxed);
+	if (counters.matches)
+		total_matches.fetch_add(counters.matches, std::memory_order_relaxed);
+	counters = MatchCounters();
+}
+
+SelectorMatchStats StyleSheetNode::GetMatchStats()
+{
+	FlushMatchStats();
+
+	SelectorMatchStats stats;
+	stats.ancestor_filter_rejects = total_ancestor_filter_rejects.load(std::memory_order_relaxed);
+	stats.hierarchy_walks = total_hierarchy_walks.load(std::memory_order_relaxed);
+	stats.matches = total_matches.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void StyleSheetNode::ResetMatchStats()
+{
+	local_match_counters = MatchCounters();
+	total_ancestor_filter_rejects.store(0, std::memory_order_relaxed);
+	total_hierarchy_walks.store(0, std::memory_order_relaxed);
+	total_matches.store(0, std::memory_order_relaxed);
+}
+
+void StyleSheetNode::CalculateAncestorRequirements()
+{
+	ancestor_requirements.Clear();
+
+	// A parent node connected through a descendant or child combinator must match an ancestor of the element matched by its child node. That
+	// element is either the element itself, one of its ancestors, or a sibling of either, which all share the element's ancestors. Nodes connected
+	// through sibling combinators match siblings, which are not reflected in the filter.
+	for (const StyleSheetNode* node = this; node->parent && node->parent->parent; node = node->parent)
+	{
+		if (node->selector.combinator != SelectorCombinator::Descendant && node->selector.combinator != SelectorCombinator::Child)
+			continue;
+
+		const CompoundSelector& required = node->parent->selector;
+		if (required.tag != Atom::Invalid)
+			ancestor_requirements.Add(required.tag);
+		if (required.id != Atom::Invalid)
+			ancestor_requirements.Add(required.id);
+		for (Atom class_name : required.class_names)
+			ancestor_requirements.Add(class_name);
+	}
+}
+
+void StyleSheetNode::CalculateSiblingShareable()
+{
+	// Attributes and structural selectors are specific to the element itself, and nodes connected through sibling combinators match the
+	// element's siblings. Everything else is the same for siblings with the same names, because they share their ancestors.
+	const bool sibling_combinator =
+		(parent && parent->parent &&
+			(selector.combinator == SelectorCombinator::NextSibling || selector.combinator == SelectorCombinator::SubsequentSibling));
+
+	sibling_shareable = (selector.attributes.empty() && selector.structural_selectors.empty() && !sibling_combinator);
+}
+
 void StyleSheetNode::CalculateAndSetSpecificity()
 {
 	// First calculate the specificity of this node alone.
 	specificity = 0;
 
-	if (!selector.tag.empty())
+	if (selector.tag != Atom::Invalid)
 		specificity += SelectorSpecificity::Tag;
 
-	if (!selector.id.empty())
+	if (selector.id != Atom::Invalid)
 		specificity += SelectorSpecificity::ID;
 
 	specificity += SelectorSpecificity::Class * (int)selector.class_names.size();
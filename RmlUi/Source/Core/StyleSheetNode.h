@@ -29,8 +29,10 @@
 #ifndef RMLUI_CORE_STYLESHEETNODE_H
 #define RMLUI_CORE_STYLESHEETNODE_H
 
+#include "../../Include/RmlUi/Core/Core.h"
 #include "../../Include/RmlUi/Core/PropertyDictionary.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include "AncestorFilter.h"
 #include "StyleSheetSelector.h"
 
 namespace Rml {
@@ -78,9 +80,23 @@ public:
 
 	/// Returns the specificity of this node.
 	int GetSpecificity() const;
+	/// Returns true if this node matches all siblings with equal tag, id, classes and pseudo-classes alike, that is, the node does not depend on
+	/// the element's attributes or its position among its siblings.
+	bool IsSiblingShareable() const;
+
+	/// Returns the counters of the selector matching done so far.
+	static SelectorMatchStats GetMatchStats();
+	/// Resets the selector matching counters.
+	static void ResetMatchStats();
+	/// Adds the counters accumulated by the calling thread to the totals.
+	static void FlushMatchStats();
 
 private:
 	void CalculateAndSetSpecificity();
+	// Collects the names that any match of this node requires to be present on the element's ancestors.
+	void CalculateAncestorRequirements();
+	// Determines whether matches of this node can be shared between siblings.
+	void CalculateSiblingShareable();
 
 	// Match an element to the local node requirements.
 	inline bool Match(const Element* element) const;
@@ -99,6 +115,12 @@ private:
 	// A measure of specificity of this node; the attribute in a node with a higher value will override those of a node with a lower value.
 	int specificity = 0;
 
+	// The tag, id and class names required from the ancestors of matching elements, used to reject elements without walking the hierarchy.
+	AncestorFilter ancestor_requirements;
+
+	// True if the node only depends on the element's tag, id, classes, pseudo-classes and ancestors.
+	bool sibling_shareable = true;
+
 	PropertyDictionary properties;
 
 	StyleSheetNodeList children;
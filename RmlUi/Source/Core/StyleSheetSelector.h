@@ -30,6 +30,7 @@
 #define RMLUI_CORE_STYLESHEETSELECTOR_H
 
 #include "../../Include/RmlUi/Core/Types.h"
+#include "Atom.h"
 
 namespace Rml {
 
@@ -138,10 +139,10 @@ using StructuralSelectorList = Vector<StructuralSelector>;
     Such as div#foo.bar:nth-child(2)
  */
 struct CompoundSelector {
-	String tag;
-	String id;
-	StringList class_names;
-	StringList pseudo_class_names;
+	Atom tag = Atom::Invalid;
+	Atom id = Atom::Invalid;
+	AtomList class_names;
+	AtomList pseudo_class_names;
 	AttributeSelectorList attributes;
 	StructuralSelectorList structural_selectors;
 	SelectorCombinator combinator = SelectorCombinator::Descendant; // Determines how to match with our parent node.
@@ -72,6 +72,12 @@ Vector2i Texture::GetDimensions(RenderInterface* render_interface) const
 	return resource->GetDimensions(render_interface);
 }
 
+void Texture::UpdateRegion(const byte* data, Vector2i dimensions, Vector2i region_offset, Vector2i region_dimensions)
+{
+	if (resource)
+		resource->UpdateRegion(data, dimensions, region_offset, region_dimensions);
+}
+
 bool Texture::operator==(const Texture& other) const
 {
 	return resource == other.resource;
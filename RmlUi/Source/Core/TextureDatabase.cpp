@@ -95,6 +95,19 @@ SharedPtr<TextureResource> TextureDatabase::Fetch(const String& source, const St
 	return resource;
 }
 
+bool TextureDatabase::ReleaseTexture(const String& source, RenderInterface* render_interface)
+{
+	if (!texture_database)
+		return false;
+
+	auto iterator = texture_database->textures.find(source);
+	if (iterator == texture_database->textures.end() || !iterator->second->HoldsRenderInterface(render_interface))
+		return false;
+
+	iterator->second->Release(render_interface);
+	return true;
+}
+
 void TextureDatabase::AddCallbackTexture(TextureResource* texture)
 {
 	if (texture_database)
@@ -107,6 +120,52 @@ void TextureDatabase::RemoveCallbackTexture(TextureResource* texture)
 		texture_database->callback_textures.erase(texture);
 }
 
+void TextureDatabase::AddTextureUser(const String& source, Element* element)
+{
+	if (texture_database && !source.empty())
+		texture_database->texture_users[source][element] += 1;
+}
+
+void TextureDatabase::RemoveTextureUser(const String& source, Element* element)
+{
+	if (!texture_database || source.empty())
+		return;
+
+	auto it_source = texture_database->texture_users.find(source);
+	if (it_source == texture_database->texture_users.end())
+		return;
+
+	auto& users = it_source->second;
+	auto it_user = users.find(element);
+	if (it_user == users.end())
+		return;
+
+	if (--it_user->second <= 0)
+	{
+		users.erase(it_user);
+		if (users.empty())
+			texture_database->texture_users.erase(it_source);
+	}
+}
+
+ElementList TextureDatabase::GetTextureUsers(const String& source)
+{
+	ElementList result;
+
+	if (texture_database)
+	{
+		auto it_source = texture_database->texture_users.find(source);
+		if (it_source != texture_database->texture_users.end())
+		{
+			result.reserve(it_source->second.size());
+			for (const auto& user : it_source->second)
+				result.push_back(user.first);
+		}
+	}
+
+	return result;
+}
+
 StringList TextureDatabase::GetSourceList()
 {
 	StringList result;
@@ -33,6 +33,7 @@
 
 namespace Rml {
 
+class Element;
 class RenderInterface;
 class TextureResource;
 
@@ -54,12 +55,23 @@ public:
 	/// Pass nullptr to release all textures in the database.
 	static void ReleaseTextures(RenderInterface* render_interface = nullptr);
 
+	/// Release the texture with the given source bound through a render interface.
+	/// @return True if the texture was loaded through the render interface.
+	static bool ReleaseTexture(const String& source, RenderInterface* render_interface);
+
 	/// Adds a texture resource with a callback function and stores it as a weak (raw) pointer in the database.
 	static void AddCallbackTexture(TextureResource* texture);
 
 	/// Removes a callback texture from the database.
 	static void RemoveCallbackTexture(TextureResource* texture);
 
+	/// Registers an element drawing the texture with the given source, so that reloading the texture only visits its users.
+	/// Each call must be balanced by a call to RemoveTextureUser() before the element is destroyed.
+	static void AddTextureUser(const String& source, Element* element);
+	static void RemoveTextureUser(const String& source, Element* element);
+	/// Returns the elements registered as users of the texture with the given source.
+	static ElementList GetTextureUsers(const String& source);
+
 	/// Return a list of all texture sources currently in the database.
 	static StringList GetSourceList();
 
@@ -75,6 +87,10 @@ private:
 
 	using CallbackTextureMap = UnorderedSet<TextureResource*>;
 	CallbackTextureMap callback_textures;
+
+	// Number of registrations of each element by texture source.
+	using TextureUserMap = UnorderedMap<String, SmallUnorderedMap<Element*, int>>;
+	TextureUserMap texture_users;
 };
 
 } // namespace Rml
@@ -130,6 +130,25 @@ void TextureResource::Release(RenderInterface* render_interface)
 	}
 }
 
+void TextureResource::UpdateRegion(const byte* data, Vector2i dimensions, Vector2i region_offset, Vector2i region_dimensions)
+{
+	for (auto it = texture_data.begin(); it != texture_data.end();)
+	{
+		RenderInterface* render_interface = it->first;
+		TextureHandle handle = it->second.first;
+
+		if (handle && it->second.second == dimensions && render_interface->UpdateTexture(handle, data, dimensions, region_offset, region_dimensions))
+		{
+			++it;
+			continue;
+		}
+
+		if (handle)
+			render_interface->ReleaseTexture(handle);
+		it = texture_data.erase(it);
+	}
+}
+
 bool TextureResource::Load(RenderInterface* render_interface)
 {
 	RMLUI_ZoneScoped;
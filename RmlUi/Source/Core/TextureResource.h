@@ -65,6 +65,9 @@ public:
 	/// Releases the texture's handle.
 	void Release(RenderInterface* render_interface = nullptr);
 
+	/// Uploads a changed region of the texture to the render interfaces holding it, or releases it from those which can't update it.
+	void UpdateRegion(const byte* data, Vector2i dimensions, Vector2i region_offset, Vector2i region_dimensions);
+
 	/// For debugging. Returns true if the texture holds a reference to the given render interface, otherwise false.
 	inline bool HoldsRenderInterface(RenderInterface* render_interface) const { return texture_data.count(render_interface); }
 
@@ -0,0 +1,204 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+#include "WorkerPool.h"
+#include "../../Include/RmlUi/Core/Math.h"
+
+namespace Rml {
+
+static inline uint64_t PackRange(uint32_t begin, uint32_t end)
+{
+	return (uint64_t(begin) << 32) | uint64_t(end);
+}
+
+static inline void UnpackRange(uint64_t range, uint32_t& begin, uint32_t& end)
+{
+	begin = uint32_t(range >> 32);
+	end = uint32_t(range);
+}
+
+WorkerPool::WorkerPool(int _num_threads) : num_threads(Math::Max(_num_threads, 1))
+{
+	ranges.reset(new TaskRange[num_threads]);
+
+	threads.reserve(num_threads - 1);
+	for (int participant = 1; participant < num_threads; participant++)
+		threads.emplace_back(&WorkerPool::WorkerMain, this, participant);
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		shutdown = true;
+	}
+	work_condition.notify_all();
+
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+int WorkerPool::GetNumThreads() const
+{
+	return num_threads;
+}
+
+void WorkerPool::ParallelFor(int num_tasks, const Function<void(int)>& task)
+{
+	if (num_tasks <= 0)
+		return;
+
+	if (threads.empty() || num_tasks == 1)
+	{
+		for (int i = 0; i < num_tasks; i++)
+			task(i);
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		// Workers may still be searching for work from the previous loop, they must not see the new ranges until they are done.
+		idle_condition.wait(lock, [this] { return active_workers == 0; });
+
+		current_task = &task;
+		remaining_tasks.store(num_tasks, std::memory_order_relaxed);
+
+		for (int participant = 0; participant < num_threads; participant++)
+		{
+			const uint32_t begin = uint32_t(int64_t(num_tasks) * participant / num_threads);
+			const uint32_t end = uint32_t(int64_t(num_tasks) * (participant + 1) / num_threads);
+			ranges[participant].range.store(PackRange(begin, end), std::memory_order_relaxed);
+		}
+
+		generation += 1;
+	}
+	work_condition.notify_all();
+
+	RunTasks(0);
+
+	// Wait for the tasks that were taken by the workers to complete.
+	std::unique_lock<std::mutex> lock(mutex);
+	done_condition.wait(lock, [this] { return remaining_tasks.load(std::memory_order_acquire) == 0; });
+}
+
+void WorkerPool::WorkerMain(int participant)
+{
+	uint64_t seen_generation = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			work_condition.wait(lock, [&] { return shutdown || generation != seen_generation; });
+			if (shutdown)
+				return;
+
+			seen_generation = generation;
+			active_workers += 1;
+		}
+
+		RunTasks(participant);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			active_workers -= 1;
+		}
+		idle_condition.notify_all();
+	}
+}
+
+void WorkerPool::RunTasks(int participant)
+{
+	// A worker may wake up after the loop it was notified for has already finished. Then all ranges are empty and the task is never called.
+	const Function<void(int)>* task = current_task;
+
+	int index = 0;
+	do
+	{
+		while (PopTask(participant, index))
+		{
+			(*task)(index);
+			if (remaining_tasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				// Notify while holding the mutex, so that the wakeup cannot be lost between the caller's check and wait.
+				std::lock_guard<std::mutex> lock(mutex);
+				done_condition.notify_all();
+			}
+		}
+	} while (StealTasks(participant));
+}
+
+bool WorkerPool::PopTask(int participant, int& out_index)
+{
+	std::atomic<uint64_t>& range = ranges[participant].range;
+	uint64_t value = range.load(std::memory_order_acquire);
+
+	while (true)
+	{
+		uint32_t begin, end;
+		UnpackRange(value, begin, end);
+		if (begin >= end)
+			return false;
+
+		if (range.compare_exchange_weak(value, PackRange(begin + 1, end), std::memory_order_acq_rel, std::memory_order_acquire))
+		{
+			out_index = int(begin);
+			return true;
+		}
+	}
+}
+
+bool WorkerPool::StealTasks(int participant)
+{
+	for (int offset = 1; offset < num_threads; offset++)
+	{
+		std::atomic<uint64_t>& victim_range = ranges[(participant + offset) % num_threads].range;
+		uint64_t value = victim_range.load(std::memory_order_acquire);
+
+		while (true)
+		{
+			uint32_t begin, end;
+			UnpackRange(value, begin, end);
+			if (begin >= end)
+				break;
+
+			// Take the back half of the range, or the last remaining task.
+			const uint32_t middle = begin + (end - begin) / 2;
+			if (victim_range.compare_exchange_weak(value, PackRange(begin, middle), std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				// Our own range is empty here and others never write to an empty range, so it can be safely replaced.
+				ranges[participant].range.store(PackRange(middle, end), std::memory_order_release);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+} // namespace Rml
@@ -0,0 +1,92 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+#ifndef RMLUI_CORE_WORKERPOOL_H
+#define RMLUI_CORE_WORKERPOOL_H
+
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Rml {
+
+/**
+	A small pool of worker threads for running data-parallel loops.
+
+	Each participating thread owns a contiguous range of the loop's indices. Threads take indices from the front of their own range and,
+	once it is exhausted, steal the back half of another thread's range. The calling thread participates in the work as well.
+ */
+
+class WorkerPool : NonCopyMoveable {
+public:
+	/// Creates the pool.
+	/// @param[in] num_threads The total number of threads working on each loop, including the calling thread.
+	explicit WorkerPool(int num_threads);
+	~WorkerPool();
+
+	/// Returns the total number of threads working on each loop, including the calling thread.
+	int GetNumThreads() const;
+
+	/// Calls the task for every index in [0, num_tasks) and blocks until all calls have returned.
+	/// @note Must only be called from a single thread at a time, the task must not call back into the pool.
+	void ParallelFor(int num_tasks, const Function<void(int)>& task);
+
+private:
+	// A half-open range of task indices, packed as [begin, end) into 32 bits each so that it can be updated atomically.
+	struct TaskRange {
+		std::atomic<uint64_t> range{0};
+		// Keep each range on its own cache line to avoid false sharing between threads.
+		char padding[64 - sizeof(std::atomic<uint64_t>)];
+	};
+
+	void WorkerMain(int participant);
+	// Runs tasks from our own range and steals from others until no more work can be found.
+	void RunTasks(int participant);
+	bool PopTask(int participant, int& out_index);
+	bool StealTasks(int participant);
+
+	int num_threads;
+	UniquePtr<TaskRange[]> ranges;
+	Vector<std::thread> threads;
+
+	std::mutex mutex;
+	std::condition_variable work_condition;
+	std::condition_variable idle_condition;
+	std::condition_variable done_condition;
+	uint64_t generation = 0;
+	int active_workers = 0;
+	bool shutdown = false;
+
+	const Function<void(int)>* current_task = nullptr;
+	std::atomic<int> remaining_tasks{0};
+};
+
+} // namespace Rml
+#endif
@@ -30,6 +30,7 @@
 #include "RmlUi/Core.h"
 
 #include "common/gd_core.h"
+#include "core/hashfuncs.h"
 #include "scene/resources/mesh.h"
 #include "servers/visual_server.h"
 
@@ -39,81 +40,410 @@
 
 struct MeshWrapper
 {
-	Ref<ArrayMesh> mesh;
+	RID mesh;
 	Rml::TextureHandle texture;
-	MeshWrapper() : texture(0) {}
+	int num_vertices;
+	int num_indices;
+	uint32_t hash;
+	bool unpacked; // drawn with the texture on its own rather than its atlas region
+	std::vector<uint8_t> contents; // source vertices followed by indices, compared on a hash match
+	MeshWrapper *next; // link in the free or released list
+	MeshWrapper() : texture(0), num_vertices(0), num_indices(0), hash(0), unpacked(false), next(nullptr) {}
 };
 
+static const int MESH_WRAPPER_CHUNK_SIZE = 64;
+
+// The hash only narrows down candidates, a collision must not render another mesh.
+static bool _mesh_contents_match(const MeshWrapper *wrapper, uint32_t hash, const Rml::Vertex *vertices, int num_vertices, const int *indices, int num_indices)
+{
+	const size_t vertex_bytes = num_vertices * sizeof(Rml::Vertex);
+	const size_t index_bytes = num_indices * sizeof(int);
+	if (wrapper->hash != hash || wrapper->num_vertices != num_vertices || wrapper->num_indices != num_indices || wrapper->contents.size() != vertex_bytes + index_bytes) {
+		return false;
+	}
+	return memcmp(wrapper->contents.data(), vertices, vertex_bytes) == 0 && memcmp(wrapper->contents.data() + vertex_bytes, indices, index_bytes) == 0;
+}
+
+static _FORCE_INLINE_ uint64_t _mesh_key(int num_vertices, int num_indices)
+{
+	return (uint64_t(uint32_t(num_vertices)) << 32) | uint32_t(num_indices);
+}
+
 struct TextureWrapper
 {
 	Ref<Texture> texture;
-	TextureWrapper(const Ref<Texture> &texture) : texture(texture) {}
+	RID rid;           // VisualServer texture owned by the wrapper, used for generated textures instead of 'texture'
+	Vector2 size;      // size of 'rid'
+	Rect2 uv_rect;     // area of the texture covered by the handle, not the full texture for atlas regions
+	int atlas_region;  // region in the renderer's atlas, or -1
+	Ref<Texture> unpacked; // the texture on its own for atlas regions, see _uses_unpacked_texture()
+	TextureWrapper(const Ref<Texture> &texture, const Rect2 &uv_rect = Rect2(0, 0, 1, 1), int atlas_region = -1) : texture(texture), uv_rect(uv_rect), atlas_region(atlas_region) {}
+};
+
+// Texture coordinates outside [0, 1], such as from tiled decorators, would sample the neighbouring regions of an atlas page.
+// Such geometry is drawn with the texture on its own instead.
+static bool _uses_unpacked_texture(Rml::TextureHandle texture, const Rml::Vertex *vertices, int num_vertices)
+{
+	const TextureWrapper *wrapper = (const TextureWrapper*)texture;
+	if (!wrapper || wrapper->atlas_region < 0 || wrapper->unpacked.is_null()) {
+		return false;
+	}
+	for (int i = 0; i < num_vertices; i++) {
+		const Rml::Vector2f &uv = vertices[i].tex_coord;
+		if (uv.x < 0.f || uv.x > 1.f || uv.y < 0.f || uv.y > 1.f) {
+			return true;
+		}
+	}
+	return false;
+}
+
+static _FORCE_INLINE_ RID _get_texture_rid(Rml::TextureHandle texture, bool unpacked = false)
+{
+	TextureWrapper *wrapper = (TextureWrapper*)texture;
+	if (!wrapper) {
+		return RID();
+	}
+	if (unpacked) {
+		return wrapper->unpacked->get_rid();
+	}
+	if (wrapper->rid.is_valid()) {
+		return wrapper->rid;
+	}
+	return wrapper->texture.is_valid() ? wrapper->texture->get_rid() : RID();
+}
+
+// Wraps a rectangle of RGBA8 pixels in an image, copying only the rows and columns inside it.
+static Ref<Image> _create_rgba_image(const Rml::byte *source, int source_width, int x, int y, int width, int height)
+{
+	PoolByteArray data;
+	data.resize(width * height * 4);
+	{
+		PoolByteArray::Write w = data.write();
+		const int row_size = width * 4;
+		for (int row = 0; row < height; row++) {
+			memcpy(w.ptr() + row * row_size, source + ((y + row) * source_width + x) * 4, row_size);
+		}
+	}
+	Ref<Image> image;
+	image.instance();
+	image->create(width, height, false, Image::FORMAT_RGBA8, data);
+	return image;
+}
+
+static _FORCE_INLINE_ Rect2 _get_texture_uv_rect(Rml::TextureHandle texture, bool unpacked = false)
+{
+	return (texture && !unpacked) ? ((TextureWrapper*)texture)->uv_rect : Rect2(0, 0, 1, 1);
+}
+
+// Byte to normalised float, avoids a division per colour channel.
+struct ColourTable
+{
+	float value[256];
+	ColourTable() {
+		for (int i = 0; i < 256; i++) {
+			value[i] = i / 255.f;
+		}
+	}
 };
+static const ColourTable colour_table;
 
-GodotRenderInterface::GodotRenderInterface()
+void GodotRenderInterface::ConvertVertices(const Rml::Vertex *vertices, int num_vertices, const Point2 &offset, Point2 *points, Point2 *uvs, Color *colors, const Rect2 &uv_rect)
+{
+	const float *lut = colour_table.value;
+	for (int i = 0; i < num_vertices; i++) {
+		const Rml::Vertex &vertex = vertices[i];
+		points[i] = Point2(vertex.position.x + offset.x, vertex.position.y + offset.y);
+		uvs[i] = Point2(uv_rect.position.x + vertex.tex_coord.x * uv_rect.size.x, uv_rect.position.y + vertex.tex_coord.y * uv_rect.size.y);
+		colors[i] = Color(lut[vertex.colour.red], lut[vertex.colour.green], lut[vertex.colour.blue], lut[vertex.colour.alpha]);
+	}
+}
+
+GodotRenderInterface::GodotRenderInterface() : m_width(0), m_height(0), segment_count(0), segment_dirty(true), scissor_enabled(false), free_wrappers(nullptr), atlas(nullptr), atlas_enabled(false), atlas_max_image_size(128), texture_loader(nullptr), async_textures(false), await_textures(false)
 {
 	canvas_item = VisualServer::get_singleton()->canvas_item_create();
 }
 
 GodotRenderInterface::~GodotRenderInterface()
 {
+	PurgeReleasedGeometry();
+	// Geometry still alive at this point was never released by RmlUi; the chunks own the wrappers.
+	for (size_t i = 0; i < wrapper_chunks.size(); i++) {
+		for (int k = 0; k < MESH_WRAPPER_CHUNK_SIZE; k++) {
+			if (wrapper_chunks[i][k].mesh.is_valid()) {
+				VisualServer::get_singleton()->free(wrapper_chunks[i][k].mesh);
+			}
+		}
+		delete[] wrapper_chunks[i];
+	}
+	for (int i = 0; i < segment_items.size(); i++) {
+		VisualServer::get_singleton()->free(segment_items[i]);
+	}
 	VisualServer::get_singleton()->free(canvas_item);
+	if (atlas) {
+		memdelete(atlas);
+	}
+	if (texture_loader) {
+		memdelete(texture_loader);
+	}
 }
 
-// Called by RmlUi when it wants to render geometry that it does not wish to optimise.
-void GodotRenderInterface::RenderGeometry(Rml::Vertex *vertices, int num_vertices, int *indices, int num_indices, const Rml::TextureHandle texture, const Rml::Vector2f &translation)
+void GodotRenderInterface::SetAsyncTextureLoading(bool enable)
 {
-	PoolVector2Array v, t;
-	PoolColorArray c;
-	for(int i = 0; i < num_vertices; i++) {
-		v.push_back(Vector2(vertices[i].position.x, vertices[i].position.y));
-		t.push_back(Vector2(vertices[i].tex_coord.x, vertices[i].tex_coord.y));
-		c.push_back(Color(vertices[i].colour.red/255.0, vertices[i].colour.green/255.0, vertices[i].colour.blue/255.f, vertices[i].colour.alpha/255.0));
+	async_textures = enable;
+	if (enable && !texture_loader) {
+		texture_loader = memnew(GodotTextureLoader);
+
+		Ref<Image> image;
+		image.instance();
+		image->create(1, 1, false, Image::FORMAT_RGBA8);
+		image->fill(Color(0, 0, 0, 0));
+		Ref<ImageTexture> texture;
+		texture.instance();
+		texture->create_from_image(image, 0);
+		placeholder_texture = texture;
 	}
+}
 
-	PoolIntArray index;
-	for(int i = 0; i < num_indices; i++) {
-		index.push_back(indices[i]);
+void GodotRenderInterface::UpdateTextureLoading()
+{
+	if (!texture_loader) {
+		return;
 	}
+	std::vector<GodotTextureLoader::LoadedTexture> loaded;
+	texture_loader->Collect(loaded);
+	for (size_t i = 0; i < loaded.size(); i++) {
+		const Rml::String &source = loaded[i].first;
+		loaded_textures[source] = loaded[i].second;
+		// Releases the placeholder, the elements using it request the texture again during the next update.
+		if (!Rml::ReloadTexture(source, this)) {
+			loaded_textures.erase(source);
+		}
+	}
+}
 
-	Array mesh_array;
-	mesh_array.clear();
-	mesh_array.resize(VS::ARRAY_MAX);
-	mesh_array[VS::ARRAY_VERTEX] = v;
-	mesh_array[VS::ARRAY_TEX_UV] = t;
-	mesh_array[VS::ARRAY_COLOR] = c;
-	mesh_array[VS::ARRAY_INDEX] = index;
+int GodotRenderInterface::GetPendingTextureCount() const
+{
+	return texture_loader ? texture_loader->GetPendingCount() : 0;
+}
 
-	Ref<ArrayMesh> mesh = newref(ArrayMesh);
-	mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, mesh_array, Array(), Mesh::ARRAY_FLAG_USE_2D_VERTICES);
+void GodotRenderInterface::SetTextureAtlas(bool enable, int max_image_size)
+{
+	atlas_enabled = enable;
+	atlas_max_image_size = max_image_size;
+	if (enable && !atlas) {
+		atlas = memnew(GodotTextureAtlas);
+	}
+}
 
-	Transform2D transform;
-	transform.translate(translation.x, translation.y);
-	Color modulate(1,1,1,1);
-	RID texture_rid = texture ? ((Texture*)texture)->get_rid() : RID();
-	RID normal_map_rid;
-	RID mask_rid;
+const GodotTextureAtlas::Stats *GodotRenderInterface::GetTextureAtlasStats() const
+{
+	return atlas ? &atlas->GetStats() : nullptr;
+}
 
-	VisualServer::get_singleton()->canvas_item_add_mesh(canvas_item, mesh->get_rid(), transform, modulate, texture_rid, normal_map_rid, mask_rid);
+void GodotRenderInterface::SetParentItem(RID parent)
+{
+	VisualServer::get_singleton()->canvas_item_set_parent(canvas_item, parent);
+}
+
+void GodotRenderInterface::BeginFrame()
+{
+	VisualServer *vs = VisualServer::get_singleton();
+	vs->canvas_item_clear(canvas_item);
+	for (int i = 0; i < segment_count; i++) {
+		vs->canvas_item_clear(segment_items[i]);
+	}
+	segment_count = 0;
+	segment_dirty = true;
+}
+
+void GodotRenderInterface::EndFrame()
+{
+	FlushBatch();
+	if (atlas) {
+		atlas->Commit();
+	}
+	PurgeReleasedGeometry();
+	// Published and reset here rather than in BeginFrame(), so that textures generated during the updates since the last
+	// rendered frame are counted. In idle mode several updates may run between two rendered frames.
+	last_frame_stats = frame_stats;
+	frame_stats = RenderStats();
+}
+
+MeshWrapper *GodotRenderInterface::AllocateMeshWrapper()
+{
+	if (!free_wrappers) {
+		MeshWrapper *chunk = new MeshWrapper[MESH_WRAPPER_CHUNK_SIZE];
+		for (int i = 0; i < MESH_WRAPPER_CHUNK_SIZE - 1; i++) {
+			chunk[i].next = &chunk[i + 1];
+		}
+		wrapper_chunks.push_back(chunk);
+		free_wrappers = chunk;
+	}
+	MeshWrapper *wrapper = free_wrappers;
+	free_wrappers = wrapper->next;
+	wrapper->next = nullptr;
+	return wrapper;
+}
+
+void GodotRenderInterface::FreeMeshWrapper(MeshWrapper *wrapper)
+{
+	if (wrapper->mesh.is_valid()) {
+		VisualServer::get_singleton()->free(wrapper->mesh);
+	}
+	*wrapper = MeshWrapper();
+	wrapper->next = free_wrappers;
+	free_wrappers = wrapper;
+}
+
+// Frees the meshes of all geometry released and not recompiled since the last purge.
+void GodotRenderInterface::PurgeReleasedGeometry()
+{
+	for (std::map<uint64_t, MeshWrapper*>::iterator it = released_wrappers.begin(); it != released_wrappers.end(); ++it) {
+		MeshWrapper *wrapper = it->second;
+		while (wrapper) {
+			MeshWrapper *next = wrapper->next;
+			FreeMeshWrapper(wrapper);
+			wrapper = next;
+		}
+	}
+	released_wrappers.clear();
+}
+
+// Returns the canvas item matching the current scissor state, starting a new segment when it changed.
+RID GodotRenderInterface::GetDrawItem()
+{
+	if (segment_dirty) {
+		VisualServer *vs = VisualServer::get_singleton();
+		if (segment_count == segment_items.size()) {
+			RID item = vs->canvas_item_create();
+			vs->canvas_item_set_parent(item, canvas_item);
+			vs->canvas_item_set_draw_index(item, segment_count);
+			segment_items.push_back(item);
+		}
+		RID item = segment_items[segment_count++];
+		vs->canvas_item_set_clip(item, scissor_enabled);
+		vs->canvas_item_set_custom_rect(item, scissor_enabled, scissor_region);
+		segment_dirty = false;
+	}
+	return segment_items[segment_count - 1];
+}
+
+// Submits the accumulated geometry as a single triangle array.
+void GodotRenderInterface::FlushBatch()
+{
+	if (batch_indices.empty())
+		return;
+
+	const int num_vertices = batch_points.size();
+	const int num_indices = batch_indices.size();
+
+	Vector<Point2> points, uvs;
+	Vector<Color> colors;
+	Vector<int> indices;
+	points.resize(num_vertices);
+	uvs.resize(num_vertices);
+	colors.resize(num_vertices);
+	indices.resize(num_indices);
+	memcpy(points.ptrw(), batch_points.data(), num_vertices * sizeof(Point2));
+	memcpy(uvs.ptrw(), batch_uvs.data(), num_vertices * sizeof(Point2));
+	memcpy(colors.ptrw(), batch_colors.data(), num_vertices * sizeof(Color));
+	memcpy(indices.ptrw(), batch_indices.data(), num_indices * sizeof(int));
+
+	VisualServer::get_singleton()->canvas_item_add_triangle_array(GetDrawItem(), indices, points, colors, uvs, Vector<int>(), Vector<float>(), batch_texture);
+
+	frame_stats.draw_calls++;
+	frame_stats.vertices += num_vertices;
+	frame_stats.indices += num_indices;
+
+	batch_points.clear();
+	batch_uvs.clear();
+	batch_colors.clear();
+	batch_indices.clear();
+}
+
+// Called by RmlUi when it wants to render geometry that it does not wish to optimise.
+void GodotRenderInterface::RenderGeometry(Rml::Vertex *vertices, int num_vertices, int *indices, int num_indices, const Rml::TextureHandle texture, const Rml::Vector2f &translation)
+{
+	const bool unpacked = _uses_unpacked_texture(texture, vertices, num_vertices);
+	const RID texture_rid = _get_texture_rid(texture, unpacked);
+	if (texture_rid != batch_texture) {
+		FlushBatch();
+		batch_texture = texture_rid;
+	}
+	frame_stats.geometry_calls++;
+
+	// Translation is baked into the positions so that draws with different offsets can share a batch.
+	const int base_vertex = batch_points.size();
+	const int base_index = batch_indices.size();
+	batch_points.resize(base_vertex + num_vertices);
+	batch_uvs.resize(base_vertex + num_vertices);
+	batch_colors.resize(base_vertex + num_vertices);
+	batch_indices.resize(base_index + num_indices);
+
+	ConvertVertices(vertices, num_vertices, Point2(translation.x, translation.y), &batch_points[base_vertex], &batch_uvs[base_vertex], &batch_colors[base_vertex], _get_texture_uv_rect(texture, unpacked));
+	int *index_out = &batch_indices[base_index];
+	for(int i = 0; i < num_indices; i++) {
+		index_out[i] = base_vertex + indices[i];
+	}
 }
 
 // Called by RmlUi when it wants to compile geometry it believes will be static for the forseeable future.
 Rml::CompiledGeometryHandle GodotRenderInterface::CompileGeometry(Rml::Vertex *vertices, int num_vertices, int *indices, int num_indices, const Rml::TextureHandle texture)
 {
-	MeshWrapper* wrapper = new MeshWrapper();
+	const uint32_t hash = hash_djb2_buffer((const uint8_t *)indices, num_indices * sizeof(int), hash_djb2_buffer((const uint8_t *)vertices, num_vertices * sizeof(Rml::Vertex)));
+
+	// Prefer a mesh released earlier this frame with the same layout, ideally with identical contents.
+	MeshWrapper *wrapper = nullptr;
+	std::map<uint64_t, MeshWrapper*>::iterator it = released_wrappers.find(_mesh_key(num_vertices, num_indices));
+	if (it != released_wrappers.end()) {
+		MeshWrapper **link = &it->second;
+		for (MeshWrapper **scan = link; *scan; scan = &(*scan)->next) {
+			if (_mesh_contents_match(*scan, hash, vertices, num_vertices, indices, num_indices)) {
+				link = scan;
+				break;
+			}
+		}
+		wrapper = *link;
+		*link = wrapper->next;
+		wrapper->next = nullptr;
+		if (!it->second) {
+			released_wrappers.erase(it);
+		}
+	}
+
+	// Texture coordinates are baked for the texture's atlas region, so contents only match for the same handle.
+	if (wrapper && wrapper->texture == texture && _mesh_contents_match(wrapper, hash, vertices, num_vertices, indices, num_indices)) {
+		wrapper->texture = texture;
+		frame_stats.mesh_reuses++;
+		return (Rml::CompiledGeometryHandle)wrapper;
+	}
+
+	if (!wrapper) {
+		wrapper = AllocateMeshWrapper();
+	}
 	wrapper->texture = texture;
+	wrapper->num_vertices = num_vertices;
+	wrapper->num_indices = num_indices;
+	wrapper->hash = hash;
+	wrapper->unpacked = _uses_unpacked_texture(texture, vertices, num_vertices);
+	wrapper->contents.resize(num_vertices * sizeof(Rml::Vertex) + num_indices * sizeof(int));
+	memcpy(wrapper->contents.data(), vertices, num_vertices * sizeof(Rml::Vertex));
+	memcpy(wrapper->contents.data() + num_vertices * sizeof(Rml::Vertex), indices, num_indices * sizeof(int));
 
 	PoolVector2Array v, t;
 	PoolColorArray c;
-	for(int i = 0; i < num_vertices; i++) {
-		v.push_back(Vector2(vertices[i].position.x, vertices[i].position.y));
-		t.push_back(Vector2(vertices[i].tex_coord.x, vertices[i].tex_coord.y));
-		c.push_back(Color(vertices[i].colour.red/255.0, vertices[i].colour.green/255.0, vertices[i].colour.blue/255.f, vertices[i].colour.alpha/255.0));
-	}
-
 	PoolIntArray index;
-	for(int i = 0; i < num_indices; i++) {
-		index.push_back(indices[i]);
+	v.resize(num_vertices);
+	t.resize(num_vertices);
+	c.resize(num_vertices);
+	index.resize(num_indices);
+	{
+		PoolVector2Array::Write vw = v.write();
+		PoolVector2Array::Write tw = t.write();
+		PoolColorArray::Write cw = c.write();
+		ConvertVertices(vertices, num_vertices, Point2(), vw.ptr(), tw.ptr(), cw.ptr(), _get_texture_uv_rect(texture, wrapper->unpacked));
+		PoolIntArray::Write iw = index.write();
+		memcpy(iw.ptr(), indices, num_indices * sizeof(int));
 	}
 
 	Array mesh_array;
@@ -123,11 +453,14 @@ Rml::CompiledGeometryHandle GodotRenderInterface::CompileGeometry(Rml::Vertex *v
 	mesh_array[VS::ARRAY_COLOR] = c;
 	mesh_array[VS::ARRAY_INDEX] = index;
 
-	if (wrapper->mesh.is_null()) {
-		wrapper->mesh = newref(ArrayMesh);
+	VisualServer *vs = VisualServer::get_singleton();
+	if (wrapper->mesh.is_valid()) {
+		vs->mesh_clear(wrapper->mesh);
+	} else {
+		wrapper->mesh = vs->mesh_create();
 	}
-	wrapper->mesh->add_surface_from_arrays(Mesh::PRIMITIVE_TRIANGLES, mesh_array, Array(), Mesh::ARRAY_FLAG_USE_2D_VERTICES);
-
+	vs->mesh_add_surface_from_arrays(wrapper->mesh, VS::PRIMITIVE_TRIANGLES, mesh_array, Array(), VS::ARRAY_FLAG_USE_2D_VERTICES);
+	frame_stats.mesh_uploads++;
 
 	return (Rml::CompiledGeometryHandle)wrapper;
 }
@@ -138,67 +471,150 @@ void GodotRenderInterface::RenderCompiledGeometry(Rml::CompiledGeometryHandle ge
 	MeshWrapper* wrapper = (MeshWrapper*)geometry;
 
 	ERR_FAIL_NULL(wrapper);
-	ERR_FAIL_COND(wrapper->mesh.is_null());
+	ERR_FAIL_COND(!wrapper->mesh.is_valid());
+
+	// Keep the painter's order: pending immediate geometry goes first.
+	FlushBatch();
+	frame_stats.geometry_calls++;
 
 	Transform2D transform;
+	transform.translate(translation.x, translation.y);
 	Color modulate(1,1,1,1);
-	Texture *texture = (Texture*)wrapper->texture;
-	RID texture_rid = texture ? texture->get_rid() : RID();
+	RID texture_rid = _get_texture_rid(wrapper->texture, wrapper->unpacked);
 	RID normal_map_rid;
 	RID mask_rid;
 
-	VisualServer::get_singleton()->canvas_item_add_mesh(canvas_item, wrapper->mesh->get_rid(), transform, modulate, texture_rid, normal_map_rid, mask_rid);
+	VisualServer::get_singleton()->canvas_item_add_mesh(GetDrawItem(), wrapper->mesh, transform, modulate, texture_rid, normal_map_rid, mask_rid);
+	frame_stats.draw_calls++;
 }
 
 // Called by RmlUi when it wants to release application-compiled geometry.
 void GodotRenderInterface::ReleaseCompiledGeometry(Rml::CompiledGeometryHandle geometry)
 {
-	((MeshWrapper*)geometry)->mesh->clear_mesh();
+	MeshWrapper* wrapper = (MeshWrapper*)geometry;
+
+	ERR_FAIL_NULL(wrapper);
+
+	MeshWrapper *&bucket = released_wrappers[_mesh_key(wrapper->num_vertices, wrapper->num_indices)];
+	wrapper->next = bucket;
+	bucket = wrapper;
 }
 
 // Called by RmlUi when it wants to enable or disable scissoring to clip content.
 void GodotRenderInterface::EnableScissorRegion(bool enable)
 {
-	VisualServer::get_singleton()->canvas_item_set_clip(canvas_item, enable);
+	if (enable != scissor_enabled) {
+		FlushBatch();
+		scissor_enabled = enable;
+		segment_dirty = true;
+	}
 }
 
 // Called by RmlUi when it wants to change the scissor region.
 void GodotRenderInterface::SetScissorRegion(int x, int y, int width, int height)
 {
-	VisualServer::get_singleton()->canvas_item_set_custom_rect(canvas_item, true, Rect2(x, y, width, height));
+	const Rect2 region(x, y, width, height);
+	if (region != scissor_region && scissor_enabled) {
+		FlushBatch();
+		segment_dirty = true;
+	}
+	scissor_region = region;
 }
 
 // Called by RmlUi when a texture is required by the library.
 bool GodotRenderInterface::LoadTexture(Rml::TextureHandle &texture_handle, Rml::Vector2i &texture_dimensions, const Rml::String &source)
 {
-	if (RES texture = ResourceLoader::load(source.c_str(), "Texture")) {
-		TextureWrapper *wrapper = memnew(TextureWrapper(texture));
-		texture_handle = (Rml::TextureHandle)wrapper;
-		Rml::Log::Message(Rml::Log::LT_INFO, "Texture loaded from %s.", source.c_str());
-
+	Ref<Texture> texture;
+	std::map<Rml::String, Ref<Texture>>::iterator it = loaded_textures.find(source);
+	if (it != loaded_textures.end()) {
+		texture = it->second;
+		loaded_textures.erase(it);
+	} else if (async_textures && !await_textures) {
+		// The dimensions are unknown until the image is loaded. Images without an explicit size lay out at 1x1 and are
+		// laid out again once the texture is reloaded, see ElementImage::OnTextureReload().
+		texture_loader->Request(source);
+		texture_dimensions = Rml::Vector2i(1, 1);
+		texture_handle = (Rml::TextureHandle)memnew(TextureWrapper(placeholder_texture));
 		return true;
+	} else {
+		texture = ResourceLoader::load(source.c_str(), "Texture");
 	}
-	return false;
+	if (texture.is_null()) {
+		return false;
+	}
+	texture_dimensions = Rml::Vector2i(texture->get_width(), texture->get_height());
+
+	Ref<Image> image;
+	if (atlas_enabled && texture_dimensions.x <= atlas_max_image_size && texture_dimensions.y <= atlas_max_image_size) {
+		image = texture->get_data();
+	}
+	if (image.is_valid()) {
+		Ref<Texture> page;
+		Rect2 uv_rect;
+		const int region = atlas->Insert(image, page, uv_rect);
+		if (region >= 0) {
+			TextureWrapper *wrapper = memnew(TextureWrapper(page, uv_rect, region));
+			wrapper->unpacked = texture;
+			texture_handle = (Rml::TextureHandle)wrapper;
+			Rml::Log::Message(Rml::Log::LT_INFO, "Texture loaded from %s into atlas.", source.c_str());
+			return true;
+		}
+	}
+
+	texture_handle = (Rml::TextureHandle)memnew(TextureWrapper(texture));
+	Rml::Log::Message(Rml::Log::LT_INFO, "Texture loaded from %s.", source.c_str());
+	return true;
 }
 
 // Called by RmlUi when a texture is required to be built from an internally-generated sequence of pixels.
 bool GodotRenderInterface::GenerateTexture(Rml::TextureHandle &texture_handle, const Rml::byte *source, const Rml::Vector2i &source_dimensions)
 {
-	const int source_size = source_dimensions.x * source_dimensions.y * 4;
-	PoolByteArray source_data;
-	source_data.resize(source_size); // RGBA only
-	memcpy(source_data.write().ptr(), source, source_size);
-	Image* img = memnew(Image);
-	img->create(source_dimensions.x, source_dimensions.y, false, Image::FORMAT_RGBA8, source_data);
-	Ref<ImageTexture> texture = memnew(ImageTexture);
-	texture->create_from_image(img);
-	TextureWrapper *wrapper = memnew(TextureWrapper(texture));
+	ERR_FAIL_COND_V(source_dimensions.x <= 0 || source_dimensions.y <= 0, false);
+
+	// The image shares its pool with the VisualServer upload, so the pixels are copied once.
+	// Generated textures are font pages and effect layers drawn at 1:1, so they don't need mipmaps.
+	VisualServer *vs = VisualServer::get_singleton();
+	TextureWrapper *wrapper = memnew(TextureWrapper(Ref<Texture>()));
+	wrapper->rid = vs->texture_create();
+	wrapper->size = Vector2(source_dimensions.x, source_dimensions.y);
+	vs->texture_allocate(wrapper->rid, source_dimensions.x, source_dimensions.y, 0, Image::FORMAT_RGBA8, VisualServer::TEXTURE_TYPE_2D, VisualServer::TEXTURE_FLAG_FILTER);
+	vs->texture_set_data(wrapper->rid, _create_rgba_image(source, source_dimensions.x, 0, 0, source_dimensions.x, source_dimensions.y));
+
+	frame_stats.texture_uploads++;
+	frame_stats.texture_upload_bytes += source_dimensions.x * source_dimensions.y * 4;
 	texture_handle = (Rml::TextureHandle)wrapper;
 	return true;
 }
 
+// Called by RmlUi when part of a generated texture has changed. Only the region is uploaded.
+bool GodotRenderInterface::UpdateTexture(Rml::TextureHandle texture_handle, const Rml::byte *source, const Rml::Vector2i &source_dimensions, const Rml::Vector2i &region_offset, const Rml::Vector2i &region_dimensions)
+{
+	TextureWrapper *wrapper = (TextureWrapper*)texture_handle;
+	if (!wrapper || !wrapper->rid.is_valid() || wrapper->size != Vector2(source_dimensions.x, source_dimensions.y)) {
+		return false;
+	}
+	ERR_FAIL_COND_V(region_offset.x < 0 || region_offset.y < 0 || region_offset.x + region_dimensions.x > source_dimensions.x || region_offset.y + region_dimensions.y > source_dimensions.y, false);
+	if (region_dimensions.x <= 0 || region_dimensions.y <= 0) {
+		return true;
+	}
+
+	Ref<Image> image = _create_rgba_image(source, source_dimensions.x, region_offset.x, region_offset.y, region_dimensions.x, region_dimensions.y);
+	VisualServer::get_singleton()->texture_set_data_partial(wrapper->rid, image, 0, 0, region_dimensions.x, region_dimensions.y, region_offset.x, region_offset.y, 0);
+
+	frame_stats.texture_uploads++;
+	frame_stats.texture_upload_bytes += region_dimensions.x * region_dimensions.y * 4;
+	return true;
+}
+
 // Called by RmlUi when a loaded texture is no longer required.
 void GodotRenderInterface::ReleaseTexture(Rml::TextureHandle texture_handle)
 {
-	memdelete((TextureWrapper*)texture_handle);
+	TextureWrapper *wrapper = (TextureWrapper*)texture_handle;
+	if (wrapper->atlas_region >= 0) {
+		atlas->Remove(wrapper->atlas_region);
+	}
+	if (wrapper->rid.is_valid()) {
+		VisualServer::get_singleton()->free(wrapper->rid);
+	}
+	memdelete(wrapper);
 }
@@ -31,22 +31,127 @@
 
 #include <RmlUi/Core/RenderInterface.h>
 
+#include "Godot_TextureAtlas.h"
+#include "Godot_TextureLoader.h"
+
+#include "core/color.h"
+#include "core/math/rect2.h"
+#include "core/math/vector2.h"
 #include "core/rid.h"
+#include "core/vector.h"
+
+#include <map>
+#include <vector>
+
+struct MeshWrapper;
 
 /// Low level Godot Engine render interface for RmlUi
 /// @author Pawel Piecuch
 class GodotRenderInterface : public Rml::RenderInterface
 {
+public:
+	/// Per-frame submission counters, published and reset by EndFrame(). Work done by updates that are not
+	/// followed by a render, such as in idle mode, is counted towards the next rendered frame.
+	struct RenderStats
+	{
+		int geometry_calls; // RenderGeometry/RenderCompiledGeometry calls issued by RmlUi
+		int draw_calls;     // canvas commands actually submitted to the VisualServer
+		int vertices;
+		int indices;
+		int mesh_uploads;   // compiled geometry that had to be (re)uploaded
+		int mesh_reuses;    // compiled geometry served from a released mesh with identical contents
+		int texture_uploads;      // generated textures created or updated
+		int texture_upload_bytes; // pixel data sent for them
+		RenderStats() : geometry_calls(0), draw_calls(0), vertices(0), indices(0), mesh_uploads(0), mesh_reuses(0), texture_uploads(0), texture_upload_bytes(0) {}
+	};
+
+private:
 	RID canvas_item;
 	int m_width;
 	int m_height;
 
+	// Child canvas items, one per run of draws sharing the same scissor state.
+	// They are kept between frames and only cleared, so scissoring costs no allocation.
+	Vector<RID> segment_items;
+	int segment_count;
+	bool segment_dirty;
+
+	bool scissor_enabled;
+	Rect2 scissor_region;
+
+	// Immediate geometry is accumulated here until the texture or scissor state changes.
+	RID batch_texture;
+	std::vector<Point2> batch_points;
+	std::vector<Point2> batch_uvs;
+	std::vector<Color> batch_colors;
+	std::vector<int> batch_indices;
+
+	// Compiled geometry wrappers are allocated in chunks and recycled through a free list.
+	// Released wrappers keep their mesh RID until the end of the frame, bucketed by
+	// vertex/index count, so geometry recompiled in the same frame can reuse them.
+	std::vector<MeshWrapper*> wrapper_chunks;
+	MeshWrapper *free_wrappers;
+	std::map<uint64_t, MeshWrapper*> released_wrappers;
+
+	// Optional atlas for small loaded images; kept alive once created so existing handles stay valid.
+	GodotTextureAtlas *atlas;
+	bool atlas_enabled;
+	int atlas_max_image_size;
+
+	// Background texture loading. Placeholders are returned until the texture arrives, then RmlUi is
+	// asked to reload it, which picks the finished texture from loaded_textures.
+	GodotTextureLoader *texture_loader;
+	bool async_textures;
+	bool await_textures;
+	Ref<Texture> placeholder_texture;
+	std::map<Rml::String, Ref<Texture>> loaded_textures;
+
+	RenderStats frame_stats;
+	RenderStats last_frame_stats;
+
+	RID GetDrawItem();
+	void FlushBatch();
+
+	MeshWrapper *AllocateMeshWrapper();
+	void FreeMeshWrapper(MeshWrapper *wrapper);
+	void PurgeReleasedGeometry();
+
 public:
 	GodotRenderInterface();
 	~GodotRenderInterface();
 
     void SetViewport(int width, int height);
 
+	// Parents the renderer's canvas item, so the geometry follows the owner's transform and visibility.
+	void SetParentItem(RID parent);
+
+	// Discards the previous frame's canvas commands. Must be called before Context::Render().
+	void BeginFrame();
+	// Submits any pending batch. Must be called after Context::Render().
+	void EndFrame();
+	// Counters of the last rendered frame. In idle mode they are kept until a frame is rendered again.
+	const RenderStats &GetFrameStats() const { return last_frame_stats; }
+
+	// Loads textures on a worker thread, drawing a transparent placeholder until they are available. The placeholder
+	// measures 1x1 pixels, so <img> elements without a width and height in RML or RCSS change size once loaded.
+	void SetAsyncTextureLoading(bool enable);
+	// Temporarily loads textures synchronously, e.g. while a loading screen is being displayed.
+	void SetAwaitTextures(bool enable) { await_textures = enable; }
+	// Swaps in the textures loaded since the last call. Must be called before Context::Update().
+	void UpdateTextureLoading();
+	// Returns the number of textures queued or being loaded.
+	int GetPendingTextureCount() const;
+
+	// Packs loaded images up to the given size into shared atlas pages. Geometry with texture coordinates
+	// outside [0, 1], such as tiled decorators, is drawn with the image's own texture instead.
+	void SetTextureAtlas(bool enable, int max_image_size);
+	// Returns the atlas statistics, or null if the atlas was never enabled.
+	const GodotTextureAtlas::Stats *GetTextureAtlasStats() const;
+
+	// Converts RmlUi vertices into Godot's split position/uv/colour streams, offsetting positions and
+	// mapping texture coordinates into uv_rect. The output arrays must hold at least num_vertices elements.
+	static void ConvertVertices(const Rml::Vertex* vertices, int num_vertices, const Point2& offset, Point2* points, Point2* uvs, Color* colors, const Rect2& uv_rect = Rect2(0, 0, 1, 1));
+
 	// Called by RmlUi when it wants to render geometry that it does not wish to optimise.
 	virtual void RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture, const Rml::Vector2f& translation);
 
@@ -67,6 +172,8 @@ public:
 	virtual bool LoadTexture(Rml::TextureHandle& texture_handle, Rml::Vector2i& texture_dimensions, const Rml::String& source);
 	// Called by RmlUi when a texture is required to be built from an internally-generated sequence of pixels.
 	virtual bool GenerateTexture(Rml::TextureHandle& texture_handle, const Rml::byte* source, const Rml::Vector2i& source_dimensions);
+	// Called by RmlUi when part of a generated texture has changed.
+	virtual bool UpdateTexture(Rml::TextureHandle texture_handle, const Rml::byte* source, const Rml::Vector2i& source_dimensions, const Rml::Vector2i& region_offset, const Rml::Vector2i& region_dimensions);
 	// Called by RmlUi when a loaded texture is no longer required.
 	virtual void ReleaseTexture(Rml::TextureHandle texture_handle);
 
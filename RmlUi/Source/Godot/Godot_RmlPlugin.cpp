@@ -28,49 +28,222 @@
 
 #include "Godot_RmlPlugin.h"
 #include "Godot_RmlUtils.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/FontEngineInterface.h>
 
+#include "core/os/file_access.h"
 #include "core/os/os.h"
 #include "core/os/input_event.h"
 #include "core/os/keyboard.h"
 
 std::map<Rml::ElementDocument*, GodotRmlDocument*> GodotRmlPlugin::rmlDocuments;
 
-GodotRmlPlugin::GodotRmlPlugin()
+// RmlUi core state is global, so it is shared by all plugin instances and
+// torn down together with the last one. Each instance owns its own context.
+static GodotSystemInterface *core_system_interface = nullptr;
+static int core_instances = 0;
+static int core_context_serial = 0;
+#ifdef DEBUG_ENABLED
+// The context hosting the debugger documents. When it goes away the debugger moves to another context.
+static Rml::Context *debugger_host = nullptr;
+#endif
+
+GodotRmlPlugin::GodotRmlPlugin() : context(nullptr), idleMode(false), pendingInput(true), renderPending(true), nextUpdateTime(0)
 {
-	SetRenderInterface(&renderer);
-	SetSystemInterface(&systemInterface);
+	if (core_instances++ == 0)
+	{
+		core_system_interface = memnew(GodotSystemInterface);
+		SetSystemInterface(core_system_interface);
+
+		Rml::Initialise();
 
-	Rml::Initialise();
+		// Initialize Lua scripting support
+		Rml::Lua::Initialise();
+	}
 
 	// add default GodotRmlPluginControls
 }
 
 GodotRmlPlugin::~GodotRmlPlugin()
 {
+	if (context)
+	{
+#ifdef DEBUG_ENABLED
+		const bool hosts_debugger = (context == debugger_host);
+		if (hosts_debugger)
+		{
+			Rml::Debugger::Shutdown();
+			debugger_host = nullptr;
+		}
+#endif
+		Rml::UnregisterPlugin(this);
+		Rml::RemoveContext(context->GetName());
+		context = nullptr;
+#ifdef DEBUG_ENABLED
+		if (hosts_debugger && Rml::GetNumContexts() > 0)
+		{
+			Rml::Context *host = Rml::GetContext(0);
+			if (Rml::Debugger::Initialise(host))
+			{
+				debugger_host = host;
+			}
+		}
+#endif
+	}
+	// Resources created through our renderer must not outlive it.
+	Rml::ReleaseTextures(&renderer);
+
+	if (--core_instances == 0)
+	{
+		Rml::Shutdown();
+		memdelete(core_system_interface);
+		core_system_interface = nullptr;
+	}
 }
 
 void GodotRmlPlugin::setup()
 {
-	context = Rml::CreateContext("main", {1, 1});
+	const Rml::String name = Rml::CreateString(32, "main_%d", core_context_serial++);
+	context = Rml::CreateContext(name, {1, 1}, &renderer);
 	if (context == nullptr)
 	{
-		Rml::Shutdown();
 		WARN_PRINT("Failed to initialize RmlUi");
 		return;
 	}
 
-	// Initialize Lua scripting support
-	Rml::Lua::Initialise();
-
 #ifdef DEBUG_ENABLED
-	Rml::Debugger::Initialise(context);
+	// The debugger is hosted by a single context and can be pointed at any other one.
+	if (!debugger_host)
+	{
+		if (Rml::Debugger::Initialise(context))
+		{
+			debugger_host = context;
+		}
+	}
+	else
+	{
+		Rml::Debugger::SetContext(context);
+	}
 #endif
 	RegisterPlugin(this);
 
 	initialiseKeyMap();
 }
 
+void GodotRmlPlugin::prewarmFont(const Rml::String &family, int size, const Rml::String &characters)
+{
+	ERR_FAIL_COND(size <= 0);
+	if (!characters.empty())
+	{
+		prewarmQueue.push_back(FontPrewarm{family, size, characters, 0, 0});
+	}
+}
+
+void GodotRmlPlugin::updatePrewarm()
+{
+	// RmlUi's font engine is not thread-safe, so glyphs are rasterised here in small batches instead of on a worker thread.
+	static const uint64_t PREWARM_BUDGET_USEC = 2000;
+	static const int PREWARM_BATCH_CHARACTERS = 16;
+
+	// Every style and weight of the family is prewarmed, variants without a face of their own resolve to one already done.
+	static const struct
+	{
+		Rml::Style::FontStyle style;
+		Rml::Style::FontWeight weight;
+	} PREWARM_VARIANTS[] = {
+		{ Rml::Style::FontStyle::Normal, Rml::Style::FontWeight::Normal },
+		{ Rml::Style::FontStyle::Normal, Rml::Style::FontWeight::Bold },
+		{ Rml::Style::FontStyle::Italic, Rml::Style::FontWeight::Normal },
+		{ Rml::Style::FontStyle::Italic, Rml::Style::FontWeight::Bold },
+	};
+	static const int PREWARM_VARIANT_COUNT = int(sizeof(PREWARM_VARIANTS) / sizeof(PREWARM_VARIANTS[0]));
+
+	const uint64_t start = OS::get_singleton()->get_ticks_usec();
+	Rml::FontEngineInterface *font_interface = Rml::GetFontEngineInterface();
+
+	while (!prewarmQueue.empty() && OS::get_singleton()->get_ticks_usec() - start < PREWARM_BUDGET_USEC)
+	{
+		FontPrewarm &job = prewarmQueue.front();
+		if (job.variant >= PREWARM_VARIANT_COUNT)
+		{
+			prewarmQueue.pop_front();
+			continue;
+		}
+
+		Rml::FontFaceHandle handle = font_interface->GetFontFaceHandle(job.family, PREWARM_VARIANTS[job.variant].style, PREWARM_VARIANTS[job.variant].weight, job.size);
+		if (!handle)
+		{
+			ERR_PRINT(vformat("Cannot prewarm unknown font family %s", job.family.c_str()));
+			prewarmQueue.pop_front();
+			continue;
+		}
+
+		bool duplicate = false;
+		for (int i = 0; i < job.variant && !duplicate; i++)
+			duplicate = (font_interface->GetFontFaceHandle(job.family, PREWARM_VARIANTS[i].style, PREWARM_VARIANTS[i].weight, job.size) == handle);
+		if (duplicate)
+		{
+			job.variant++;
+			continue;
+		}
+
+		// Take a batch of whole UTF-8 code points.
+		size_t end = job.offset;
+		for (int i = 0; i < PREWARM_BATCH_CHARACTERS && end < job.characters.size(); i++)
+		{
+			end++;
+			while (end < job.characters.size() && (job.characters[end] & 0xC0) == 0x80)
+				end++;
+		}
+		const Rml::String batch = job.characters.substr(job.offset, end - job.offset);
+
+		// Measuring appends the glyphs, generating the string adds them to the font textures.
+		Rml::GeometryList geometry;
+		font_interface->GetStringWidth(handle, batch, Rml::Character::Null);
+		font_interface->GenerateString(handle, 0, batch, Rml::Vector2f(0, 0), Rml::Colourb(255, 255, 255), 1.f, geometry);
+
+		job.offset = end;
+		if (job.offset >= job.characters.size())
+		{
+			job.offset = 0;
+			job.variant++;
+		}
+	}
+}
+
+bool GodotRmlPlugin::loadGlyphCache(const String &path)
+{
+	if (!FileAccess::exists(path))
+	{
+		return false;
+	}
+	Error err;
+	Vector<uint8_t> data = FileAccess::get_file_as_array(path, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, false, "Cannot read glyph cache " + path);
+	return Rml::LoadFontGlyphCache(data.ptr(), data.size());
+}
+
+bool GodotRmlPlugin::saveGlyphCache(const String &path)
+{
+	Rml::Vector<Rml::byte> data;
+	if (!Rml::SaveFontGlyphCache(data))
+	{
+		return false;
+	}
+	Error err;
+	FileAccessRef file = FileAccess::open(path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, false, "Cannot write glyph cache " + path);
+	file->store_buffer(data.data(), data.size());
+	return true;
+}
+
+void GodotRmlPlugin::setCanvasParent(RID parent)
+{
+	renderer.SetParentItem(parent);
+}
+
 void GodotRmlPlugin::loadFont(const std::string &file)
 {
 	Rml::LoadFontFace(toDataPath(file));
@@ -123,6 +296,7 @@ GodotRmlDocument *GodotRmlPlugin::getDocumentFromRmlUi(Rml::ElementDocument* doc
 void GodotRmlPlugin::toggleDebugger()
 {
 #ifdef DEBUG_ENABLED
+	Rml::Debugger::SetContext(context);
 	Rml::Debugger::SetVisible(!Rml::Debugger::IsVisible());
 #else
 	WARN_PRINT("Debugger is not available in this build.");
@@ -141,25 +315,58 @@ void GodotRmlPlugin::hideDebugger()
 void GodotRmlPlugin::showDebugger()
 {
 #ifdef DEBUG_ENABLED
+	Rml::Debugger::SetContext(context);
 	Rml::Debugger::SetVisible(true);
 #else
 	WARN_PRINT("Debugger is not available in this build.");
 #endif
 }
 
+void GodotRmlPlugin::setStyleThreadCount(int count)
+{
+	if (context)
+		context->SetStyleThreadCount(count);
+}
+
+void GodotRmlPlugin::setIdleMode(bool enable)
+{
+	idleMode = enable;
+	pendingInput = true;
+}
+
 void GodotRmlPlugin::update()
 {
+	renderer.UpdateTextureLoading();
+	updatePrewarm();
+
+	const double now = Rml::GetSystemInterface()->GetElapsedTime();
+	const bool timeout = now >= nextUpdateTime;
+	if (idleMode && !timeout && !pendingInput && !context->IsRenderDirty())
+		return;
+
 	context->Update();
+
+	// Elements such as the text caret animate without dirtying anything, they only request updates.
+	renderPending = renderPending || timeout || context->IsRenderDirty();
+	pendingInput = false;
+	nextUpdateTime = now + context->GetNextUpdateDelay();
 }
 
 void GodotRmlPlugin::draw()
 {
+	if (idleMode && !renderPending)
+		return;
+	renderPending = false;
+
+	renderer.BeginFrame();
 	context->Render();
+	renderer.EndFrame();
 }
 
 void GodotRmlPlugin::resize(int w, int h)
 {
 	context->SetDimensions({w, h});
+	pendingInput = true;
 }
 
 void GodotRmlPlugin::initialiseKeyMap()
@@ -307,6 +514,8 @@ void GodotRmlPlugin::injectEvent(const Ref<InputEvent> &event)
 	using namespace Rml::Input;
 	using Rml::Input::KeyIdentifier;
 
+	pendingInput = true;
+
 	if (const InputEventKey *e = Object::cast_to<InputEventKey>(*event)) {
 		const uint32_t gdkey = e->get_scancode();
 		const wchar_t c = static_cast<wchar_t>(e->get_unicode());
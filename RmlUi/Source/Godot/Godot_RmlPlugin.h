@@ -44,6 +44,7 @@
 
 #include <string>
 #include <map>
+#include <deque>
 
 #define GODOTRMLUI_LOG "GodotRmlUi"
 
@@ -57,8 +58,25 @@ public:
 	void update();
 	void draw();
 
+	// In idle mode update() and draw() do nothing until the context changed, received input,
+	// or the delay requested through Context::RequestNextUpdate() has elapsed.
+	void setIdleMode(bool enable);
+	bool isIdleMode() const { return idleMode; }
+
+	// Attaches the renderer's canvas item to the owning control's canvas item.
+	void setCanvasParent(RID parent);
+
 	// always load font before calling setup
 	void loadFont(const std::string &file);
+
+	// Queues rasterising the characters of a font family at the given size. The work is spread over
+	// the following updates, a few milliseconds per frame, ahead of the text being displayed.
+	void prewarmFont(const Rml::String &family, int size, const Rml::String &characters);
+	int getPendingPrewarmCount() const { return (int)prewarmQueue.size(); }
+
+	// Restores or stores the rasterised glyphs of all font faces, see Rml::LoadFontGlyphCache().
+	bool loadGlyphCache(const String &path);
+	bool saveGlyphCache(const String &path);
 	
 	GodotRmlDocument* loadDocument(const std::string &docPath);
 
@@ -78,11 +96,20 @@ public:
 
 	static GodotRmlDocument* getDocumentFromRmlUi(Rml::ElementDocument* doc);
 	Rml::Context* getContext() { return context; }
+	const GodotRenderInterface::RenderStats &getRenderStats() const { return renderer.GetFrameStats(); }
+	const GodotTextureAtlas::Stats *getTextureAtlasStats() const { return renderer.GetTextureAtlasStats(); }
+	void setTextureAtlas(bool enable, int maxImageSize) { renderer.SetTextureAtlas(enable, maxImageSize); }
+	void setAsyncTextureLoading(bool enable) { renderer.SetAsyncTextureLoading(enable); }
+	void setAwaitTextures(bool enable) { renderer.SetAwaitTextures(enable); }
+	int getPendingTextureCount() const { return renderer.GetPendingTextureCount(); }
+	void setStyleThreadCount(int count);
 
 private:
 	void OnDocumentLoad(Rml::ElementDocument *document);
 	void OnElementCreate(Rml::Element *element);
 
+	void updatePrewarm();
+
 	std::map<uint32_t, Rml::Input::KeyIdentifier> _keymap;
 
 	int getMouseButton(int button);
@@ -91,8 +118,22 @@ private:
 	static std::map<Rml::ElementDocument*, GodotRmlDocument*> rmlDocuments;
 
 	GodotRenderInterface renderer;
-	GodotSystemInterface systemInterface;
 	Rml::Context* context;
+
+	bool idleMode;
+	bool pendingInput;   // input or resize received since the last update
+	bool renderPending;  // the last update requires a render
+	double nextUpdateTime;
+
+	struct FontPrewarm
+	{
+		Rml::String family;
+		int size;
+		Rml::String characters;
+		size_t offset; // bytes of 'characters' already rasterised
+		int variant;   // index of the style and weight being rasterised
+	};
+	std::deque<FontPrewarm> prewarmQueue;
 };
 
 #endif // RMLUI_GODOT_PLUGIN_H
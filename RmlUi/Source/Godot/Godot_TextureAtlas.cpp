@@ -0,0 +1,198 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "Godot_TextureAtlas.h"
+
+#include <limits.h>
+
+// Border around every image, filled with its edge pixels so that filtering doesn't pick up neighbours.
+static const int PADDING = 1;
+
+GodotTextureAtlas::GodotTextureAtlas(int page_size, int max_pages) : page_size(page_size), max_pages(max_pages)
+{
+}
+
+GodotTextureAtlas::~GodotTextureAtlas()
+{
+}
+
+int GodotTextureAtlas::AddPage()
+{
+	Page page;
+	page.image.instance();
+	page.image->create(page_size, page_size, false, Image::FORMAT_RGBA8);
+	page.texture.instance();
+	page.texture->create_from_image(page.image, Texture::FLAG_FILTER);
+	page.next_y = 0;
+	page.live = 0;
+	page.dirty = false;
+	pages.push_back(page);
+
+	stats.pages++;
+	stats.total_pixels += page_size * page_size;
+	return pages.size() - 1;
+}
+
+// Finds room for a rectangle: on the existing shelf wasting the least height, or on a new shelf.
+bool GodotTextureAtlas::Allocate(int width, int height, int &r_page, int &r_shelf, Point2i &r_position)
+{
+	if (width > page_size || height > page_size)
+		return false;
+
+	int best_page = -1, best_shelf = -1, best_waste = INT_MAX;
+	for (size_t p = 0; p < pages.size(); p++) {
+		const std::vector<Shelf> &shelves = pages[p].shelves;
+		for (size_t s = 0; s < shelves.size(); s++) {
+			const Shelf &shelf = shelves[s];
+			if (shelf.height < height || shelf.x + width > page_size)
+				continue;
+			const int waste = shelf.height - height;
+			// Don't mix very different heights on a shelf that is in use.
+			if (shelf.live > 0 && waste > height / 2 + PADDING * 2)
+				continue;
+			if (waste < best_waste) {
+				best_page = p;
+				best_shelf = s;
+				best_waste = waste;
+			}
+		}
+	}
+
+	if (best_page < 0) {
+		for (size_t p = 0; p < pages.size() && best_page < 0; p++) {
+			if (pages[p].next_y + height <= page_size)
+				best_page = p;
+		}
+		if (best_page < 0) {
+			if ((int)pages.size() >= max_pages)
+				return false;
+			best_page = AddPage();
+		}
+		Page &page = pages[best_page];
+		Shelf shelf = { page.next_y, height, 0, 0 };
+		page.shelves.push_back(shelf);
+		page.next_y += height;
+		best_shelf = page.shelves.size() - 1;
+	}
+
+	Shelf &shelf = pages[best_page].shelves[best_shelf];
+	r_page = best_page;
+	r_shelf = best_shelf;
+	r_position = Point2i(shelf.x, shelf.y);
+	shelf.x += width;
+	return true;
+}
+
+int GodotTextureAtlas::Insert(const Ref<Image> &p_image, Ref<Texture> &r_page, Rect2 &r_uv_rect)
+{
+	ERR_FAIL_COND_V(p_image.is_null() || p_image->empty(), -1);
+
+	Ref<Image> image = p_image;
+	if (image->is_compressed() || image->get_format() != Image::FORMAT_RGBA8) {
+		image = p_image->duplicate();
+		if (image->is_compressed() && image->decompress() != OK) {
+			stats.rejections++;
+			return -1;
+		}
+		image->convert(Image::FORMAT_RGBA8);
+	}
+
+	const int w = image->get_width();
+	const int h = image->get_height();
+	int page_index, shelf_index;
+	Point2i position;
+	if (!Allocate(w + PADDING * 2, h + PADDING * 2, page_index, shelf_index, position)) {
+		stats.rejections++;
+		return -1;
+	}
+
+	Page &page = pages[page_index];
+	const Point2 dest(position.x + PADDING, position.y + PADDING);
+	page.image->blit_rect(image, Rect2(0, 0, w, h), dest);
+	page.image->blit_rect(image, Rect2(0, 0, w, 1), dest + Point2(0, -1));
+	page.image->blit_rect(image, Rect2(0, h - 1, w, 1), dest + Point2(0, h));
+	page.image->blit_rect(image, Rect2(0, 0, 1, h), dest + Point2(-1, 0));
+	page.image->blit_rect(image, Rect2(w - 1, 0, 1, h), dest + Point2(w, 0));
+	page.dirty = true;
+	page.live++;
+	page.shelves[shelf_index].live++;
+
+	Region region = { page_index, shelf_index, (w + PADDING * 2) * (h + PADDING * 2), true };
+	int id;
+	if (free_regions.empty()) {
+		id = regions.size();
+		regions.push_back(region);
+	} else {
+		id = free_regions.back();
+		free_regions.pop_back();
+		regions[id] = region;
+	}
+
+	stats.regions++;
+	stats.used_pixels += region.area;
+
+	r_page = page.texture;
+	r_uv_rect = Rect2(dest.x / page_size, dest.y / page_size, float(w) / page_size, float(h) / page_size);
+	return id;
+}
+
+void GodotTextureAtlas::Remove(int id)
+{
+	ERR_FAIL_INDEX(id, (int)regions.size());
+	Region &region = regions[id];
+	ERR_FAIL_COND(!region.used);
+
+	Page &page = pages[region.page];
+	Shelf &shelf = page.shelves[region.shelf];
+	page.live--;
+	if (--shelf.live == 0) {
+		shelf.x = 0;
+		// Give the height of trailing empty shelves back to the page.
+		while (!page.shelves.empty() && page.shelves.back().live == 0) {
+			page.next_y = page.shelves.back().y;
+			page.shelves.pop_back();
+		}
+	}
+
+	region.used = false;
+	free_regions.push_back(id);
+
+	stats.regions--;
+	stats.used_pixels -= region.area;
+	stats.evictions++;
+}
+
+void GodotTextureAtlas::Commit()
+{
+	for (size_t p = 0; p < pages.size(); p++) {
+		if (pages[p].dirty) {
+			pages[p].texture->set_data(pages[p].image);
+			pages[p].dirty = false;
+		}
+	}
+}
@@ -0,0 +1,112 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_GODOT_TEXTUREATLAS_H
+#define RMLUI_GODOT_TEXTUREATLAS_H
+
+#include "core/image.h"
+#include "core/math/rect2.h"
+#include "scene/resources/texture.h"
+
+#include <vector>
+
+/// Packs small images into shared texture pages, so that geometry referencing different
+/// images can be drawn with a single texture. Images are placed on shelves (rows) of similar
+/// height; a shelf is reclaimed once all images on it were removed.
+/// @author Pawel Piecuch
+class GodotTextureAtlas
+{
+public:
+	struct Stats
+	{
+		int pages;
+		int regions;        // images currently held by the atlas
+		int used_pixels;    // area covered by live images, including padding
+		int total_pixels;   // area of all pages
+		int evictions;      // images removed from the atlas
+		int rejections;     // images that did not fit and were loaded as standalone textures
+		Stats() : pages(0), regions(0), used_pixels(0), total_pixels(0), evictions(0), rejections(0) {}
+	};
+
+	GodotTextureAtlas(int page_size = 1024, int max_pages = 4);
+	~GodotTextureAtlas();
+
+	/// Copies the image into a free area of one of the pages.
+	/// @param[in] image The image to insert, converted to RGBA8 if necessary.
+	/// @param[out] r_page The texture of the page the image was placed on.
+	/// @param[out] r_uv_rect The area of the image on the page, in normalised coordinates.
+	/// @return The region id to pass to Remove(), or -1 if the image did not fit.
+	int Insert(const Ref<Image> &image, Ref<Texture> &r_page, Rect2 &r_uv_rect);
+	/// Releases a region returned by Insert().
+	void Remove(int region);
+
+	/// Uploads the pages modified since the last call.
+	void Commit();
+
+	int GetPageSize() const { return page_size; }
+	const Stats &GetStats() const { return stats; }
+
+private:
+	struct Shelf
+	{
+		int y, height;
+		int x;     // next free column
+		int live;  // regions still placed on this shelf
+	};
+
+	struct Page
+	{
+		Ref<Image> image;
+		Ref<ImageTexture> texture;
+		std::vector<Shelf> shelves;
+		int next_y;
+		int live;
+		bool dirty;
+	};
+
+	struct Region
+	{
+		int page, shelf;
+		int area;
+		bool used;
+	};
+
+	bool Allocate(int width, int height, int &r_page, int &r_shelf, Point2i &r_position);
+	int AddPage();
+
+	int page_size;
+	int max_pages;
+
+	std::vector<Page> pages;
+	std::vector<Region> regions;
+	std::vector<int> free_regions;
+
+	Stats stats;
+};
+
+#endif // RMLUI_GODOT_TEXTUREATLAS_H
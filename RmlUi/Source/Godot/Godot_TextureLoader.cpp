@@ -0,0 +1,103 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "Godot_TextureLoader.h"
+
+#include "core/io/resource_loader.h"
+
+GodotTextureLoader::GodotTextureLoader() : thread_started(false), exit_thread(false)
+{
+}
+
+GodotTextureLoader::~GodotTextureLoader()
+{
+	if (thread_started) {
+		mutex.lock();
+		exit_thread = true;
+		mutex.unlock();
+		semaphore.post();
+		thread.wait_to_finish();
+	}
+}
+
+void GodotTextureLoader::Request(const Rml::String& source)
+{
+	MutexLock lock(mutex);
+	if (!pending.insert(source).second) {
+		return;
+	}
+	queue.push_back(source);
+	if (!thread_started) {
+		thread.start(_thread_func, this);
+		thread_started = true;
+	}
+	semaphore.post();
+}
+
+void GodotTextureLoader::Collect(std::vector<LoadedTexture>& r_loaded)
+{
+	MutexLock lock(mutex);
+	for (size_t i = 0; i < loaded.size(); i++) {
+		pending.erase(loaded[i].first);
+		r_loaded.push_back(loaded[i]);
+	}
+	loaded.clear();
+}
+
+int GodotTextureLoader::GetPendingCount() const
+{
+	MutexLock lock(mutex);
+	return pending.size();
+}
+
+void GodotTextureLoader::_thread_func(void* p_userdata)
+{
+	GodotTextureLoader *self = (GodotTextureLoader*)p_userdata;
+	while (true) {
+		self->semaphore.wait();
+
+		self->mutex.lock();
+		if (self->exit_thread) {
+			self->mutex.unlock();
+			return;
+		}
+		if (self->queue.empty()) {
+			self->mutex.unlock();
+			continue;
+		}
+		const Rml::String source = self->queue.front();
+		self->queue.pop_front();
+		self->mutex.unlock();
+
+		Ref<Texture> texture = ResourceLoader::load(source.c_str(), "Texture");
+
+		self->mutex.lock();
+		self->loaded.push_back(LoadedTexture(source, texture));
+		self->mutex.unlock();
+	}
+}
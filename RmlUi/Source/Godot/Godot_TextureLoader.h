@@ -0,0 +1,75 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_GODOT_TEXTURELOADER_H
+#define RMLUI_GODOT_TEXTURELOADER_H
+
+#include <RmlUi/Core/Types.h>
+
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "scene/resources/texture.h"
+
+#include <deque>
+#include <set>
+#include <utility>
+#include <vector>
+
+/// Loads textures through the ResourceLoader on a worker thread.
+/// @author Pawel Piecuch
+class GodotTextureLoader
+{
+public:
+	using LoadedTexture = std::pair<Rml::String, Ref<Texture>>;
+
+	GodotTextureLoader();
+	~GodotTextureLoader();
+
+	/// Queues a texture for loading, unless it is already pending.
+	void Request(const Rml::String& source);
+	/// Moves the textures loaded since the last call into r_loaded. A failed load yields a null texture.
+	void Collect(std::vector<LoadedTexture>& r_loaded);
+	/// Returns the number of textures queued or being loaded.
+	int GetPendingCount() const;
+
+private:
+	static void _thread_func(void* p_userdata);
+
+	Thread thread;
+	bool thread_started;
+	bool exit_thread;
+	mutable Mutex mutex;
+	Semaphore semaphore;
+
+	std::deque<Rml::String> queue;
+	std::set<Rml::String> pending;
+	std::vector<LoadedTexture> loaded;
+};
+
+#endif // RMLUI_GODOT_TEXTURELOADER_H
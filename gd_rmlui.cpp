@@ -8,6 +8,7 @@
 #include "Godot/Godot_Renderer.h"
 #include "Godot/Godot_Platform.h"
 
+#include <RmlUi/Core/Core.h>
 #include <RmlUi/Core/ElementDocument.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/Types.h>
@@ -304,7 +305,7 @@ void GodotRmlCustomElementWrapper::OnAttributeChange(const Rml::ElementAttribute
 // RmlDocument — GDScript Wrapper
 // =========================================================================
 
-RmlDocument::RmlDocument() : _doc(nullptr) {}
+RmlDocument::RmlDocument() : _doc(nullptr), _await_textures(false) {}
 RmlDocument::~RmlDocument() {}
 
 void RmlDocument::show() {
@@ -394,6 +395,11 @@ void RmlDocument::set_element_class(const String &p_id, const String &p_class, b
 	}
 }
 
+// While a document awaiting textures is visible, its control loads textures synchronously,
+// so that e.g. a loading screen never shows placeholders.
+void RmlDocument::set_await_textures(bool p_enable) { _await_textures = p_enable; }
+bool RmlDocument::is_await_textures() const { return _await_textures; }
+
 Ref<RmlDocument> RmlDocument::load_from_string(const String &p_rml, GdRmlUIControl *p_ctrl) {
 	ERR_FAIL_COND_V(!p_ctrl || !p_ctrl->_plugin, Ref<RmlDocument>());
 	Rml::Context *ctx = p_ctrl->_plugin->getContext();
@@ -421,13 +427,17 @@ void RmlDocument::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_element_inner_rml", "id", "rml"), &RmlDocument::set_element_inner_rml);
 	ClassDB::bind_method(D_METHOD("get_element_inner_rml", "id"), &RmlDocument::get_element_inner_rml);
 	ClassDB::bind_method(D_METHOD("set_element_class", "id", "class_name", "activate"), &RmlDocument::set_element_class);
+	ClassDB::bind_method(D_METHOD("set_await_textures", "enable"), &RmlDocument::set_await_textures);
+	ClassDB::bind_method(D_METHOD("is_await_textures"), &RmlDocument::is_await_textures);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "await_textures"), "set_await_textures", "is_await_textures");
 }
 
 // =========================================================================
 // GdRmlUIControl — Main Control Node
 // =========================================================================
 
-GdRmlUIControl::GdRmlUIControl() : _plugin(nullptr) {}
+GdRmlUIControl::GdRmlUIControl() : _plugin(nullptr), _idle_mode(false), _texture_atlas(false), _atlas_max_image_size(128), _async_texture_loading(false), _pending_textures(0), _style_threads(1) {}
 
 GdRmlUIControl::~GdRmlUIControl() {
 	if (_plugin) {
@@ -442,7 +452,17 @@ void GdRmlUIControl::_notification(int p_what) {
 			if (!_plugin) {
 				_plugin = memnew(GodotRmlPlugin);
 				_plugin->setup();
+				_plugin->setIdleMode(_idle_mode);
+				_plugin->setTextureAtlas(_texture_atlas, _atlas_max_image_size);
+				_plugin->setAsyncTextureLoading(_async_texture_loading);
+				_plugin->setStyleThreadCount(_style_threads);
+				if (!_glyph_cache_path.empty()) {
+					_plugin->loadGlyphCache(_glyph_cache_path);
+				}
 			}
+			// The context draws into its own canvas item, parented to ours, so it is
+			// rebuilt only when the context renders and never by Control::update().
+			_plugin->setCanvasParent(get_canvas_item());
 			Size2 sz = get_size();
 			if (sz.x > 0 && sz.y > 0) {
 				_plugin->resize(sz.x, sz.y);
@@ -451,16 +471,28 @@ void GdRmlUIControl::_notification(int p_what) {
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
 			set_process(false);
-		} break;
-		case NOTIFICATION_PROCESS: {
 			if (_plugin) {
-				_plugin->update();
-				update();
+				_plugin->setCanvasParent(RID());
+				save_glyph_cache();
 			}
 		} break;
-		case NOTIFICATION_DRAW: {
+		case NOTIFICATION_PROCESS: {
 			if (_plugin) {
+				if (_async_texture_loading) {
+					bool await = false;
+					for (int i = 0; i < _documents.size() && !await; i++) {
+						await = _documents[i]->_await_textures && _documents[i]->is_visible();
+					}
+					_plugin->setAwaitTextures(await);
+				}
+				_plugin->update();
 				_plugin->draw();
+
+				const int pending = _plugin->getPendingTextureCount();
+				if (_pending_textures > 0 && pending == 0) {
+					emit_signal("textures_loaded");
+				}
+				_pending_textures = pending;
 			}
 		} break;
 		case NOTIFICATION_RESIZED: {
@@ -508,8 +540,129 @@ void GdRmlUIControl::load_font(const String &p_path) {
 	_plugin->loadFont(p_path.utf8().get_data());
 }
 
+void GdRmlUIControl::prewarm_font(const String &p_family, const PoolIntArray &p_sizes, const String &p_charset) {
+	ERR_FAIL_COND(!_plugin);
+	const CharString family = p_family.utf8();
+	const CharString charset = p_charset.utf8();
+	PoolIntArray::Read sizes = p_sizes.read();
+	for (int i = 0; i < p_sizes.size(); i++) {
+		_plugin->prewarmFont(family.get_data(), sizes[i], charset.get_data());
+	}
+}
+
 int GdRmlUIControl::get_document_count() const { return _documents.size(); }
 
+Dictionary GdRmlUIControl::get_render_stats() const {
+	Dictionary result;
+	if (!_plugin) return result;
+	const GodotRenderInterface::RenderStats &stats = _plugin->getRenderStats();
+	result["geometry_calls"] = stats.geometry_calls;
+	result["draw_calls"] = stats.draw_calls;
+	result["vertices"] = stats.vertices;
+	result["indices"] = stats.indices;
+	result["mesh_uploads"] = stats.mesh_uploads;
+	result["mesh_reuses"] = stats.mesh_reuses;
+	result["texture_uploads"] = stats.texture_uploads;
+	result["texture_upload_bytes"] = stats.texture_upload_bytes;
+	return result;
+}
+
+// Selector matching counters, shared by all controls and accumulated until reset.
+Dictionary GdRmlUIControl::get_style_stats() const {
+	Dictionary result;
+	const Rml::SelectorMatchStats stats = Rml::GetSelectorMatchStats();
+	result["ancestor_filter_rejects"] = (int64_t)stats.ancestor_filter_rejects;
+	result["hierarchy_walks"] = (int64_t)stats.hierarchy_walks;
+	result["matches"] = (int64_t)stats.matches;
+	return result;
+}
+
+void GdRmlUIControl::reset_style_stats() {
+	Rml::ResetSelectorMatchStats();
+}
+
+// Layouts performed during the last update of the context.
+Dictionary GdRmlUIControl::get_layout_stats() const {
+	Dictionary result;
+	if (!_plugin || !_plugin->getContext()) return result;
+	const Rml::LayoutStats &stats = _plugin->getContext()->GetLayoutStats();
+	result["full_layouts"] = stats.full_layouts;
+	result["boundary_layouts"] = stats.boundary_layouts;
+	result["formatted_elements"] = stats.formatted_elements;
+	result["layout_arena_bytes"] = stats.layout_arena_bytes;
+	return result;
+}
+
+void GdRmlUIControl::set_idle_mode(bool p_enable) {
+	_idle_mode = p_enable;
+	if (_plugin) _plugin->setIdleMode(p_enable);
+}
+
+bool GdRmlUIControl::is_idle_mode() const { return _idle_mode; }
+
+void GdRmlUIControl::set_texture_atlas(bool p_enable) {
+	_texture_atlas = p_enable;
+	if (_plugin) _plugin->setTextureAtlas(_texture_atlas, _atlas_max_image_size);
+}
+
+bool GdRmlUIControl::is_texture_atlas() const { return _texture_atlas; }
+
+void GdRmlUIControl::set_atlas_max_image_size(int p_size) {
+	ERR_FAIL_COND(p_size < 1);
+	_atlas_max_image_size = p_size;
+	if (_plugin) _plugin->setTextureAtlas(_texture_atlas, _atlas_max_image_size);
+}
+
+int GdRmlUIControl::get_atlas_max_image_size() const { return _atlas_max_image_size; }
+
+void GdRmlUIControl::set_async_texture_loading(bool p_enable) {
+	_async_texture_loading = p_enable;
+	if (_plugin) _plugin->setAsyncTextureLoading(p_enable);
+}
+
+bool GdRmlUIControl::is_async_texture_loading() const { return _async_texture_loading; }
+
+int GdRmlUIControl::get_pending_texture_count() const {
+	return _plugin ? _plugin->getPendingTextureCount() : 0;
+}
+
+// Glyphs rasterised during the session are stored here when the control leaves the tree, and
+// restored when it enters it, so that later runs skip rasterising them.
+void GdRmlUIControl::set_glyph_cache_path(const String &p_path) {
+	_glyph_cache_path = p_path;
+	if (_plugin && !p_path.empty()) _plugin->loadGlyphCache(p_path);
+}
+
+String GdRmlUIControl::get_glyph_cache_path() const { return _glyph_cache_path; }
+
+bool GdRmlUIControl::save_glyph_cache() {
+	if (!_plugin || _glyph_cache_path.empty()) return false;
+	return _plugin->saveGlyphCache(_glyph_cache_path);
+}
+
+// Element definitions are matched on this many threads during each update; computed values,
+// events and property changes are still processed on the main thread.
+void GdRmlUIControl::set_style_threads(int p_count) {
+	ERR_FAIL_COND(p_count < 1);
+	_style_threads = p_count;
+	if (_plugin) _plugin->setStyleThreadCount(p_count);
+}
+
+int GdRmlUIControl::get_style_threads() const { return _style_threads; }
+
+Dictionary GdRmlUIControl::get_atlas_stats() const {
+	Dictionary result;
+	if (!_plugin) return result;
+	const GodotTextureAtlas::Stats *stats = _plugin->getTextureAtlasStats();
+	if (!stats) return result;
+	result["pages"] = stats->pages;
+	result["regions"] = stats->regions;
+	result["occupancy"] = stats->total_pixels > 0 ? float(stats->used_pixels) / stats->total_pixels : 0.f;
+	result["evictions"] = stats->evictions;
+	result["rejections"] = stats->rejections;
+	return result;
+}
+
 void GdRmlUIControl::toggle_debugger() { if (_plugin) _plugin->toggleDebugger(); }
 void GdRmlUIControl::show_debugger() { if (_plugin) _plugin->showDebugger(); }
 void GdRmlUIControl::hide_debugger() { if (_plugin) _plugin->hideDebugger(); }
@@ -519,10 +672,39 @@ void GdRmlUIControl::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("load_document_from_string", "rml"), &GdRmlUIControl::load_document_from_string);
 	ClassDB::bind_method(D_METHOD("load_font", "path"), &GdRmlUIControl::load_font);
 	ClassDB::bind_method(D_METHOD("get_document_count"), &GdRmlUIControl::get_document_count);
+	ClassDB::bind_method(D_METHOD("get_render_stats"), &GdRmlUIControl::get_render_stats);
+	ClassDB::bind_method(D_METHOD("get_style_stats"), &GdRmlUIControl::get_style_stats);
+	ClassDB::bind_method(D_METHOD("reset_style_stats"), &GdRmlUIControl::reset_style_stats);
+	ClassDB::bind_method(D_METHOD("get_layout_stats"), &GdRmlUIControl::get_layout_stats);
 	ClassDB::bind_method(D_METHOD("toggle_debugger"), &GdRmlUIControl::toggle_debugger);
 	ClassDB::bind_method(D_METHOD("show_debugger"), &GdRmlUIControl::show_debugger);
 	ClassDB::bind_method(D_METHOD("hide_debugger"), &GdRmlUIControl::hide_debugger);
+	ClassDB::bind_method(D_METHOD("set_idle_mode", "enable"), &GdRmlUIControl::set_idle_mode);
+	ClassDB::bind_method(D_METHOD("is_idle_mode"), &GdRmlUIControl::is_idle_mode);
+	ClassDB::bind_method(D_METHOD("set_texture_atlas", "enable"), &GdRmlUIControl::set_texture_atlas);
+	ClassDB::bind_method(D_METHOD("is_texture_atlas"), &GdRmlUIControl::is_texture_atlas);
+	ClassDB::bind_method(D_METHOD("set_atlas_max_image_size", "size"), &GdRmlUIControl::set_atlas_max_image_size);
+	ClassDB::bind_method(D_METHOD("get_atlas_max_image_size"), &GdRmlUIControl::get_atlas_max_image_size);
+	ClassDB::bind_method(D_METHOD("get_atlas_stats"), &GdRmlUIControl::get_atlas_stats);
+	ClassDB::bind_method(D_METHOD("set_async_texture_loading", "enable"), &GdRmlUIControl::set_async_texture_loading);
+	ClassDB::bind_method(D_METHOD("is_async_texture_loading"), &GdRmlUIControl::is_async_texture_loading);
+	ClassDB::bind_method(D_METHOD("get_pending_texture_count"), &GdRmlUIControl::get_pending_texture_count);
+	ClassDB::bind_method(D_METHOD("prewarm_font", "family", "sizes", "charset"), &GdRmlUIControl::prewarm_font);
+	ClassDB::bind_method(D_METHOD("set_glyph_cache_path", "path"), &GdRmlUIControl::set_glyph_cache_path);
+	ClassDB::bind_method(D_METHOD("get_glyph_cache_path"), &GdRmlUIControl::get_glyph_cache_path);
+	ClassDB::bind_method(D_METHOD("save_glyph_cache"), &GdRmlUIControl::save_glyph_cache);
+	ClassDB::bind_method(D_METHOD("set_style_threads", "count"), &GdRmlUIControl::set_style_threads);
+	ClassDB::bind_method(D_METHOD("get_style_threads"), &GdRmlUIControl::get_style_threads);
 	ClassDB::bind_method(D_METHOD("_gui_input", "event"), &GdRmlUIControl::_gui_input);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "idle_mode"), "set_idle_mode", "is_idle_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "texture_atlas"), "set_texture_atlas", "is_texture_atlas");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "atlas_max_image_size", PROPERTY_HINT_RANGE, "1,1024,1"), "set_atlas_max_image_size", "get_atlas_max_image_size");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "async_texture_loading"), "set_async_texture_loading", "is_async_texture_loading");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "glyph_cache_path", PROPERTY_HINT_FILE), "set_glyph_cache_path", "get_glyph_cache_path");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "style_threads", PROPERTY_HINT_RANGE, "1,64,1"), "set_style_threads", "get_style_threads");
+
+	ADD_SIGNAL(MethodInfo("textures_loaded"));
 }
 
 // =========================================================================
@@ -702,6 +884,55 @@ const char *RML_EXAMPLE_SETTINGS = R"RML(
 #include "doctest/doctest.h"
 #include "doctest/doctest_godot.h"
 
+#include "core/io/resource_saver.h"
+#include "core/os/dir_access.h"
+#include "core/os/os.h"
+
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/DataModelHandle.h>
+#include <RmlUi/Core/DataTypeRegister.h>
+#include <RmlUi/Core/ElementText.h>
+#include <RmlUi/Core/ElementUtilities.h>
+
+#include "RmlUi/Source/Core/DataExpression.h"
+#include "RmlUi/Source/Core/DataModel.h"
+#include "RmlUi/Source/Core/FontEngineDefault/FontFaceLayer.h"
+
+#include <algorithm>
+
+// Sets up the plugin and its context. Documents loaded through it are closed when the test ends.
+struct RmlTestContext {
+	GodotRmlPlugin plugin;
+	Rml::Context *context = nullptr;
+
+	RmlTestContext() {
+		plugin.setup();
+		context = plugin.getContext();
+		REQUIRE(context != nullptr);
+	}
+
+	~RmlTestContext() {
+		if (context) {
+			context->UnloadAllDocuments();
+			context->Update();
+		}
+	}
+
+	Rml::ElementDocument *load(const Rml::String &rml) {
+		Rml::ElementDocument *document = context->LoadDocumentFromMemory(rml);
+		REQUIRE(document != nullptr);
+		document->Show();
+		context->Update();
+		return document;
+	}
+};
+
+// Returns the text of a data-for row whose only child is its text element.
+static Rml::String GetRowText(Rml::Element *list, int index) {
+	Rml::ElementText *text = rmlui_dynamic_cast<Rml::ElementText *>(list->GetChild(index)->GetChild(0));
+	return text ? text->GetText() : Rml::String();
+}
+
 TEST_SUITE("[[rmlui]] RmlDocument") {
 	TEST_CASE("[rmlui] default document state") {
 		RmlDocument doc;
@@ -709,6 +940,13 @@ TEST_SUITE("[[rmlui]] RmlDocument") {
 		CHECK_FALSE(doc.is_visible());
 	}
 
+	TEST_CASE("[rmlui] await textures flag") {
+		RmlDocument doc;
+		CHECK_FALSE(doc.is_await_textures());
+		doc.set_await_textures(true);
+		CHECK(doc.is_await_textures());
+	}
+
 	TEST_CASE("[rmlui] null document element query returns empty") {
 		RmlDocument doc;
 		CHECK(doc.get_element_by_id("test").empty());
@@ -733,6 +971,33 @@ TEST_SUITE("[[rmlui]] GdRmlUIControl") {
 		CHECK(ctrl.get_document_count() == 0);
 	}
 
+	TEST_CASE("[rmlui] idle mode property") {
+		GdRmlUIControl ctrl;
+		CHECK_FALSE(ctrl.is_idle_mode());
+		ctrl.set_idle_mode(true);
+		CHECK(ctrl.is_idle_mode());
+	}
+
+	TEST_CASE("[rmlui] atlas stats without plugin are empty") {
+		GdRmlUIControl ctrl;
+		ctrl.set_texture_atlas(true);
+		CHECK(ctrl.is_texture_atlas());
+		CHECK(ctrl.get_atlas_stats().empty());
+	}
+
+	TEST_CASE("[rmlui] glyph cache without plugin is not saved") {
+		GdRmlUIControl ctrl;
+		CHECK(ctrl.get_glyph_cache_path().empty());
+		ctrl.set_glyph_cache_path("user://rmlui_glyphs.cache");
+		CHECK(ctrl.get_glyph_cache_path() == "user://rmlui_glyphs.cache");
+		CHECK_FALSE(ctrl.save_glyph_cache());
+	}
+
+	TEST_CASE("[rmlui] render stats without plugin are empty") {
+		GdRmlUIControl ctrl;
+		CHECK(ctrl.get_render_stats().empty());
+	}
+
 	TEST_CASE("[rmlui] load document without plugin returns null") {
 		GdRmlUIControl ctrl;
 		Ref<RmlDocument> doc;
@@ -812,6 +1077,1340 @@ TEST_SUITE("[[rmlui]] GodotRmlDocument (internal)") {
 	}
 }
 
+// Fills a square of the given size, with texture coordinates from 0 to uv_scale.
+static void MakeTestQuad(Rml::Vertex (&vertices)[4], int (&indices)[6], float size, float uv_scale = 1.f) {
+	const Rml::Vector2f corners[4] = { Rml::Vector2f(0, 0), Rml::Vector2f(1, 0), Rml::Vector2f(1, 1), Rml::Vector2f(0, 1) };
+	for (int i = 0; i < 4; i++) {
+		vertices[i].position = corners[i] * size;
+		vertices[i].tex_coord = corners[i] * uv_scale;
+		vertices[i].colour = Rml::Colourb(255, 255, 255, 255);
+	}
+	const int quad_indices[6] = { 0, 1, 2, 0, 2, 3 };
+	memcpy(indices, quad_indices, sizeof(quad_indices));
+}
+
+// Generates a texture of opaque white pixels through the renderer.
+static Rml::TextureHandle GenerateTestTexture(GodotRenderInterface &renderer, Rml::Vector2i dimensions) {
+	std::vector<Rml::byte> pixels(dimensions.x * dimensions.y * 4, 255);
+	Rml::TextureHandle texture = 0;
+	REQUIRE(renderer.GenerateTexture(texture, pixels.data(), dimensions));
+	return texture;
+}
+
+TEST_SUITE("[[rmlui]] GodotRenderInterface") {
+	TEST_CASE("[rmlui] vertex conversion matches per-channel division") {
+		Rml::Vertex vertices[2];
+		vertices[0].position = Rml::Vector2f(1, 2);
+		vertices[0].tex_coord = Rml::Vector2f(0.25f, 0.75f);
+		vertices[0].colour = Rml::Colourb(0, 51, 128, 255);
+		vertices[1].position = Rml::Vector2f(-3, 4);
+		vertices[1].tex_coord = Rml::Vector2f(1, 0);
+		vertices[1].colour = Rml::Colourb(255, 0, 17, 0);
+
+		Point2 points[2], uvs[2];
+		Color colors[2];
+		GodotRenderInterface::ConvertVertices(vertices, 2, Point2(10, 20), points, uvs, colors);
+
+		CHECK(points[0] == Point2(11, 22));
+		CHECK(points[1] == Point2(7, 24));
+		CHECK(uvs[0] == Point2(0.25f, 0.75f));
+		CHECK(uvs[1] == Point2(1, 0));
+		CHECK(colors[0].is_equal_approx(Color(0, 51 / 255.f, 128 / 255.f, 1)));
+		CHECK(colors[1].is_equal_approx(Color(1, 0, 17 / 255.f, 0)));
+	}
+
+	TEST_CASE("[rmlui] vertex conversion throughput") {
+		const int counts[] = { 10000, 100000 };
+		for (int c = 0; c < 2; c++) {
+			const int count = counts[c];
+			std::vector<Rml::Vertex> vertices(count);
+			for (int i = 0; i < count; i++) {
+				vertices[i].position = Rml::Vector2f(i, i);
+				vertices[i].colour = Rml::Colourb(i & 0xff, (i >> 8) & 0xff, 0, 255);
+			}
+			std::vector<Point2> points(count), uvs(count);
+			std::vector<Color> colors(count);
+
+			const uint64_t start = OS::get_singleton()->get_ticks_usec();
+			GodotRenderInterface::ConvertVertices(vertices.data(), count, Point2(), points.data(), uvs.data(), colors.data());
+			const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - start;
+
+			MESSAGE(vformat("Converted %d vertices in %d usec.", count, (int64_t)elapsed));
+			CHECK(points[count - 1] == Point2(count - 1, count - 1));
+		}
+	}
+
+	TEST_CASE("[rmlui] immediate geometry is batched per texture and scissor state") {
+		GodotRenderInterface renderer;
+		Rml::Vertex vertices[4];
+		int indices[6];
+		MakeTestQuad(vertices, indices, 10.f);
+		const Rml::TextureHandle texture = GenerateTestTexture(renderer, Rml::Vector2i(4, 4));
+
+		renderer.BeginFrame();
+		// Draws with different translations but the same texture share a batch.
+		for (int i = 0; i < 3; i++)
+			renderer.RenderGeometry(vertices, 4, indices, 6, 0, Rml::Vector2f(i * 10.f, 0));
+		renderer.RenderGeometry(vertices, 4, indices, 6, texture, Rml::Vector2f(0, 10));
+		renderer.RenderGeometry(vertices, 4, indices, 6, texture, Rml::Vector2f(10, 10));
+
+		// Enabling the scissor starts a new batch, setting the same region again does not.
+		renderer.EnableScissorRegion(true);
+		renderer.SetScissorRegion(0, 0, 5, 5);
+		renderer.RenderGeometry(vertices, 4, indices, 6, texture, Rml::Vector2f(0, 20));
+		renderer.SetScissorRegion(0, 0, 5, 5);
+		renderer.RenderGeometry(vertices, 4, indices, 6, texture, Rml::Vector2f(10, 20));
+		renderer.EnableScissorRegion(false);
+		renderer.EndFrame();
+
+		const GodotRenderInterface::RenderStats &stats = renderer.GetFrameStats();
+		CHECK(stats.geometry_calls == 7);
+		CHECK(stats.draw_calls == 3);
+		CHECK(stats.vertices == 28);
+		CHECK(stats.indices == 42);
+
+		// Alternating textures break every batch.
+		renderer.BeginFrame();
+		for (int i = 0; i < 4; i++)
+			renderer.RenderGeometry(vertices, 4, indices, 6, i % 2 ? texture : 0, Rml::Vector2f());
+		renderer.EndFrame();
+		CHECK(renderer.GetFrameStats().geometry_calls == 4);
+		CHECK(renderer.GetFrameStats().draw_calls == 4);
+
+		renderer.ReleaseTexture(texture);
+	}
+
+	TEST_CASE("[rmlui] geometry recompiled in the same frame reuses its mesh") {
+		GodotRenderInterface renderer;
+		Rml::Vertex vertices[4];
+		int indices[6];
+		MakeTestQuad(vertices, indices, 10.f);
+		const Rml::TextureHandle texture = GenerateTestTexture(renderer, Rml::Vector2i(4, 4));
+
+		renderer.BeginFrame();
+		const Rml::CompiledGeometryHandle geometry = renderer.CompileGeometry(vertices, 4, indices, 6, 0);
+		renderer.EndFrame();
+		CHECK(renderer.GetFrameStats().mesh_uploads == 1);
+
+		// Identical contents are served from the released mesh without uploading it again.
+		renderer.BeginFrame();
+		renderer.ReleaseCompiledGeometry(geometry);
+		Rml::CompiledGeometryHandle reused = renderer.CompileGeometry(vertices, 4, indices, 6, 0);
+		CHECK(reused == geometry);
+		renderer.RenderCompiledGeometry(reused, Rml::Vector2f(5, 5));
+		renderer.EndFrame();
+		CHECK(renderer.GetFrameStats().mesh_reuses == 1);
+		CHECK(renderer.GetFrameStats().mesh_uploads == 0);
+		CHECK(renderer.GetFrameStats().draw_calls == 1);
+
+		// The same layout with other contents or another texture reuses the mesh, but uploads the new contents.
+		renderer.BeginFrame();
+		renderer.ReleaseCompiledGeometry(reused);
+		vertices[2].position = Rml::Vector2f(20, 20);
+		reused = renderer.CompileGeometry(vertices, 4, indices, 6, 0);
+		renderer.ReleaseCompiledGeometry(reused);
+		reused = renderer.CompileGeometry(vertices, 4, indices, 6, texture);
+		renderer.EndFrame();
+		CHECK(reused == geometry);
+		CHECK(renderer.GetFrameStats().mesh_reuses == 0);
+		CHECK(renderer.GetFrameStats().mesh_uploads == 2);
+
+		// Meshes released and not recompiled are freed at the end of the frame.
+		renderer.BeginFrame();
+		renderer.ReleaseCompiledGeometry(reused);
+		renderer.EndFrame();
+		renderer.BeginFrame();
+		reused = renderer.CompileGeometry(vertices, 4, indices, 6, texture);
+		renderer.ReleaseCompiledGeometry(reused);
+		renderer.EndFrame();
+		CHECK(renderer.GetFrameStats().mesh_reuses == 0);
+		CHECK(renderer.GetFrameStats().mesh_uploads == 1);
+
+		renderer.ReleaseTexture(texture);
+	}
+
+	TEST_CASE("[rmlui] generated textures upload only their updated regions") {
+		GodotRenderInterface renderer;
+		renderer.BeginFrame();
+		const Rml::TextureHandle texture = GenerateTestTexture(renderer, Rml::Vector2i(16, 8));
+
+		std::vector<Rml::byte> pixels(16 * 8 * 4, 128);
+		CHECK(renderer.UpdateTexture(texture, pixels.data(), Rml::Vector2i(16, 8), Rml::Vector2i(4, 2), Rml::Vector2i(8, 4)));
+		// An empty region uploads nothing, while pixels of another size must be generated as a new texture.
+		CHECK(renderer.UpdateTexture(texture, pixels.data(), Rml::Vector2i(16, 8), Rml::Vector2i(0, 0), Rml::Vector2i(0, 0)));
+		CHECK_FALSE(renderer.UpdateTexture(texture, pixels.data(), Rml::Vector2i(8, 16), Rml::Vector2i(0, 0), Rml::Vector2i(8, 4)));
+		bool updated = true;
+		EXPECT_ERROR(updated = renderer.UpdateTexture(texture, pixels.data(), Rml::Vector2i(16, 8), Rml::Vector2i(12, 0), Rml::Vector2i(8, 4)));
+		CHECK_FALSE(updated);
+		renderer.EndFrame();
+
+		const GodotRenderInterface::RenderStats &stats = renderer.GetFrameStats();
+		CHECK(stats.texture_uploads == 2);
+		CHECK(stats.texture_upload_bytes == (16 * 8 + 8 * 4) * 4);
+
+		renderer.ReleaseTexture(texture);
+	}
+
+	TEST_CASE("[rmlui] plugins share the core and own their contexts") {
+		RmlTestContext first;
+		const int num_contexts = Rml::GetNumContexts();
+		{
+			RmlTestContext second;
+			CHECK(second.context != first.context);
+			CHECK(Rml::GetNumContexts() == num_contexts + 1);
+			second.load("<rml><body><p>second</p></body></rml>");
+		}
+
+		// Removing one plugin leaves the core and the other plugin's context working.
+		CHECK(Rml::GetNumContexts() == num_contexts);
+		CHECK(Rml::GetContext(first.context->GetName()) == first.context);
+		Rml::ElementDocument *document = first.load("<rml><body><p id=\"text\">first</p></body></rml>");
+		CHECK(document->GetElementById("text") != nullptr);
+	}
+}
+
+// Creates an opaque image of a single colour.
+static Ref<Image> CreateTestImage(int width, int height, const Color &color) {
+	Ref<Image> image;
+	image.instance();
+	image->create(width, height, false, Image::FORMAT_RGBA8);
+	image->fill(color);
+	return image;
+}
+
+TEST_SUITE("[[rmlui]] GodotTextureAtlas") {
+	TEST_CASE("[rmlui] images are packed onto shelves and their texture coordinates remapped") {
+		const int page_size = 64;
+		GodotTextureAtlas atlas(page_size, 1);
+		Ref<Texture> page, other_page;
+		Rect2 uv_a, uv_b, uv_c;
+
+		// Every image is surrounded by a pixel of padding. The second image is close enough in height to share the first shelf.
+		const int a = atlas.Insert(CreateTestImage(10, 10, Color(1, 0, 0)), page, uv_a);
+		const int b = atlas.Insert(CreateTestImage(10, 6, Color(0, 1, 0)), other_page, uv_b);
+		CHECK(page == other_page);
+		const int c = atlas.Insert(CreateTestImage(20, 20, Color(0, 0, 1)), other_page, uv_c);
+		CHECK(page == other_page);
+		REQUIRE(a >= 0);
+		REQUIRE(b >= 0);
+		REQUIRE(c >= 0);
+		CHECK(uv_a == Rect2(1.f / page_size, 1.f / page_size, 10.f / page_size, 10.f / page_size));
+		CHECK(uv_b == Rect2(13.f / page_size, 1.f / page_size, 10.f / page_size, 6.f / page_size));
+		CHECK(uv_c == Rect2(1.f / page_size, 13.f / page_size, 20.f / page_size, 20.f / page_size));
+
+		// Texture coordinates of geometry are mapped into the image's region of the page.
+		Rml::Vertex vertices[4];
+		int indices[6];
+		MakeTestQuad(vertices, indices, 20.f);
+		Point2 points[4], uvs[4];
+		Color colors[4];
+		GodotRenderInterface::ConvertVertices(vertices, 4, Point2(), points, uvs, colors, uv_c);
+		CHECK(uvs[0] == uv_c.position);
+		CHECK(uvs[2] == uv_c.position + uv_c.size);
+
+		// Images larger than a page are rejected, the atlas never grows beyond its page limit.
+		Rect2 uv_large;
+		CHECK(atlas.Insert(CreateTestImage(page_size, page_size, Color(1, 1, 1)), other_page, uv_large) == -1);
+		CHECK(atlas.Insert(CreateTestImage(40, 40, Color(1, 1, 1)), other_page, uv_large) == -1);
+
+		const GodotTextureAtlas::Stats &stats = atlas.GetStats();
+		CHECK(stats.pages == 1);
+		CHECK(stats.regions == 3);
+		CHECK(stats.used_pixels == 12 * 12 + 12 * 8 + 22 * 22);
+		CHECK(stats.rejections == 2);
+
+		// A shelf emptied of all its images is filled again from its start.
+		atlas.Remove(a);
+		atlas.Remove(b);
+		Rect2 uv_d;
+		CHECK(atlas.Insert(CreateTestImage(10, 10, Color(1, 1, 1)), other_page, uv_d) >= 0);
+		CHECK(uv_d == uv_a);
+		CHECK(stats.regions == 2);
+		CHECK(stats.evictions == 2);
+	}
+}
+
+TEST_SUITE("[[rmlui]] Async textures") {
+	TEST_CASE("[rmlui] images show a placeholder until their texture is loaded") {
+		DirAccessRef dir = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+		dir->make_dir_recursive(OS::get_singleton()->get_user_data_dir());
+		Ref<ImageTexture> source;
+		source.instance();
+		source->create_from_image(CreateTestImage(8, 4, Color(1, 0, 0)), 0);
+		REQUIRE(ResourceSaver::save("user://rmlui_test_texture.res", source) == OK);
+
+		RmlTestContext test;
+		test.plugin.setAsyncTextureLoading(true);
+		Rml::ElementDocument *document = test.load("<rml><head><style>body { display: block; }</style></head>"
+												   "<body><img id=\"image\" src=\"user://rmlui_test_texture.res\"/></body></rml>");
+		Rml::Element *image = document->GetElementById("image");
+		REQUIRE(image != nullptr);
+		CHECK(image->GetBox().GetSize() == Rml::Vector2f(1, 1));
+		CHECK(test.plugin.getPendingTextureCount() == 1);
+
+		// The loaded texture is swapped in by an update, which lays the image out again at its own size.
+		const uint64_t deadline = OS::get_singleton()->get_ticks_usec() + 5000000;
+		while (test.plugin.getPendingTextureCount() > 0 && OS::get_singleton()->get_ticks_usec() < deadline) {
+			OS::get_singleton()->delay_usec(1000);
+			test.plugin.update();
+		}
+		REQUIRE(test.plugin.getPendingTextureCount() == 0);
+		test.context->Update();
+		CHECK(image->GetBox().GetSize() == Rml::Vector2f(8, 4));
+
+		dir->remove(OS::get_singleton()->get_user_data_dir().plus_file("rmlui_test_texture.res"));
+	}
+}
+
+// Generates textures and records the regions uploaded to them, without rendering anything.
+class RecordingRenderInterface : public Rml::RenderInterface {
+public:
+	struct Region {
+		Rml::Vector2i offset, dimensions;
+	};
+
+	void RenderGeometry(Rml::Vertex *, int, int *, int, Rml::TextureHandle, const Rml::Vector2f &) override {}
+	void EnableScissorRegion(bool) override {}
+	void SetScissorRegion(int, int, int, int) override {}
+
+	bool GenerateTexture(Rml::TextureHandle &texture_handle, const Rml::byte *, const Rml::Vector2i &) override {
+		texture_handle = (Rml::TextureHandle)(++num_generated);
+		return true;
+	}
+
+	bool UpdateTexture(Rml::TextureHandle, const Rml::byte *, const Rml::Vector2i &, const Rml::Vector2i &region_offset, const Rml::Vector2i &region_dimensions) override {
+		updated_regions.push_back(Region{ region_offset, region_dimensions });
+		return true;
+	}
+
+	void ReleaseTexture(Rml::TextureHandle) override {}
+
+	int num_generated = 0;
+	Rml::Vector<Region> updated_regions;
+};
+
+// Adds an opaque glyph with a bitmap of the given size.
+static void AddTestGlyph(Rml::FontGlyphMap &glyphs, char character, Rml::Vector2i dimensions) {
+	Rml::FontGlyph &glyph = glyphs[(Rml::Character)character];
+	glyph.dimensions = dimensions;
+	glyph.bitmap_dimensions = dimensions;
+	glyph.bitmap_owned_data.reset(new Rml::byte[dimensions.x * dimensions.y]);
+	memset(glyph.bitmap_owned_data.get(), 255, dimensions.x * dimensions.y);
+	glyph.bitmap_data = glyph.bitmap_owned_data.get();
+}
+
+// Returns the texture coordinates of the top-left corner of a character's geometry, and the texture it renders from.
+static Rml::Vector2f GetGlyphTexCoord(const Rml::FontFaceLayer &layer, char character, int &texture_index) {
+	Rml::Vector<Rml::Geometry> geometry(layer.GetNumTextures());
+	layer.GenerateGeometry(geometry.data(), (Rml::Character)character, Rml::Vector2f(0, 0), Rml::Colourb(255, 255, 255));
+	for (texture_index = 0; texture_index < (int)geometry.size(); texture_index++) {
+		if (!geometry[texture_index].GetVertices().empty())
+			return geometry[texture_index].GetVertices()[0].tex_coord;
+	}
+	texture_index = -1;
+	return Rml::Vector2f(0, 0);
+}
+
+TEST_SUITE("[[rmlui]] Font layer textures") {
+	TEST_CASE("[rmlui] glyphs are packed onto shelves and only their region is uploaded") {
+		RmlTestContext test;
+		RecordingRenderInterface render_interface;
+
+		Rml::FontGlyphMap glyphs;
+		AddTestGlyph(glyphs, 'a', Rml::Vector2i(10, 10));
+		AddTestGlyph(glyphs, 'b', Rml::Vector2i(9, 10));
+		AddTestGlyph(glyphs, 'c', Rml::Vector2i(10, 6));
+		AddTestGlyph(glyphs, 'd', Rml::Vector2i(10, 20));
+
+		Rml::FontFaceLayer layer(nullptr);
+		bool geometry_invalidated = false;
+		REQUIRE(layer.Generate(glyphs, geometry_invalidated));
+		REQUIRE(layer.GetNumTextures() == 1);
+		const Rml::Vector2i dimensions = layer.GetTexture(0)->GetDimensions(&render_interface);
+		CHECK(dimensions == Rml::Vector2i(64, 64));
+		CHECK(render_interface.num_generated == 1);
+
+		// The tallest glyph opens the first shelf, the others follow it on the same shelf, one pixel apart.
+		int texture_index = -1;
+		const Rml::Vector2f scale(float(dimensions.x), float(dimensions.y));
+		CHECK(GetGlyphTexCoord(layer, 'd', texture_index) * scale == Rml::Vector2f(1, 1));
+		CHECK(texture_index == 0);
+		CHECK(GetGlyphTexCoord(layer, 'a', texture_index) * scale == Rml::Vector2f(12, 1));
+		CHECK(GetGlyphTexCoord(layer, 'b', texture_index) * scale == Rml::Vector2f(23, 1));
+		CHECK(GetGlyphTexCoord(layer, 'c', texture_index) * scale == Rml::Vector2f(33, 1));
+
+		// A glyph that no longer fits on the shelf opens a new one below it, and only its own region is uploaded.
+		AddTestGlyph(glyphs, 'e', Rml::Vector2i(20, 10));
+		geometry_invalidated = false;
+		REQUIRE(layer.Generate(glyphs, geometry_invalidated));
+		CHECK(!geometry_invalidated);
+		CHECK(GetGlyphTexCoord(layer, 'e', texture_index) * scale == Rml::Vector2f(1, 22));
+		CHECK(GetGlyphTexCoord(layer, 'a', texture_index) * scale == Rml::Vector2f(12, 1));
+
+		REQUIRE(render_interface.updated_regions.size() == 1);
+		CHECK(render_interface.updated_regions[0].offset == Rml::Vector2i(1, 22));
+		CHECK(render_interface.updated_regions[0].dimensions == Rml::Vector2i(20, 10));
+		CHECK(render_interface.num_generated == 1);
+	}
+
+	TEST_CASE("[rmlui] growing a texture keeps placed glyphs at their pixels") {
+		RmlTestContext test;
+		RecordingRenderInterface render_interface;
+
+		Rml::FontGlyphMap glyphs;
+		AddTestGlyph(glyphs, 'a', Rml::Vector2i(10, 10));
+
+		Rml::FontFaceLayer layer(nullptr);
+		bool geometry_invalidated = false;
+		REQUIRE(layer.Generate(glyphs, geometry_invalidated));
+		REQUIRE(layer.GetTexture(0)->GetDimensions(&render_interface) == Rml::Vector2i(64, 64));
+		int texture_index = -1;
+		const Rml::Vector2f texcoord = GetGlyphTexCoord(layer, 'a', texture_index);
+
+		// Two of these fit on a new shelf below the first glyph, the other two only once the texture has doubled in width.
+		for (char character : { 'b', 'c', 'd', 'e' })
+			AddTestGlyph(glyphs, character, Rml::Vector2i(30, 30));
+		geometry_invalidated = false;
+		REQUIRE(layer.Generate(glyphs, geometry_invalidated));
+		CHECK(geometry_invalidated);
+		REQUIRE(layer.GetNumTextures() == 1);
+
+		// The texture changed size, so it is generated again rather than updated.
+		const Rml::Vector2i dimensions = layer.GetTexture(0)->GetDimensions(&render_interface);
+		CHECK(dimensions == Rml::Vector2i(128, 64));
+		CHECK(render_interface.num_generated == 2);
+		CHECK(render_interface.updated_regions.empty());
+
+		const Rml::Vector2f remapped = GetGlyphTexCoord(layer, 'a', texture_index);
+		CHECK(texture_index == 0);
+		CHECK(remapped.x == doctest::Approx(texcoord.x * 0.5f));
+		CHECK(remapped.y == doctest::Approx(texcoord.y));
+		CHECK(remapped * Rml::Vector2f(float(dimensions.x), float(dimensions.y)) == Rml::Vector2f(1, 1));
+	}
+
+	TEST_CASE("[rmlui] layer textures can be generated after the layer is destroyed") {
+		RmlTestContext test;
+		RecordingRenderInterface render_interface;
+
+		Rml::FontGlyphMap glyphs;
+		AddTestGlyph(glyphs, 'a', Rml::Vector2i(10, 10));
+
+		Rml::Texture texture;
+		{
+			Rml::FontFaceLayer layer(nullptr);
+			bool geometry_invalidated = false;
+			REQUIRE(layer.Generate(glyphs, geometry_invalidated));
+			texture = *layer.GetTexture(0);
+		}
+
+		CHECK(texture.GetHandle(&render_interface) != 0);
+		CHECK(texture.GetDimensions(&render_interface) == Rml::Vector2i(64, 64));
+	}
+}
+
+TEST_SUITE("[[rmlui]] Element id index") {
+	TEST_CASE("[rmlui] id lookup matches search and benchmark") {
+		RmlTestContext test;
+		Rml::Context *context = test.context;
+
+		const int counts[] = { 1000, 10000, 50000 };
+		for (int c = 0; c < 3; c++) {
+			const int count = counts[c];
+			Rml::ElementDocument *document = context->CreateDocument();
+			REQUIRE(document != nullptr);
+
+			// Build a tree with a fan-out of eight, ids are assigned in breadth-first order.
+			std::vector<Rml::Element *> elements;
+			elements.push_back(document);
+			for (int i = 1; i < count; i++) {
+				Rml::ElementPtr element = document->CreateElement("div");
+				element->SetId(Rml::CreateString(16, "e%d", i));
+				elements.push_back(elements[(i - 1) / 8]->AppendChild(std::move(element)));
+			}
+
+			const int lookups = 200;
+			std::vector<Rml::String> ids;
+			for (int i = 0; i < lookups; i++)
+				ids.push_back(Rml::CreateString(16, "e%d", count - 1 - (i * 7919) % (count - 1)));
+
+			uint64_t start = OS::get_singleton()->get_ticks_usec();
+			std::vector<Rml::Element *> searched;
+			for (const Rml::String &id : ids)
+				searched.push_back(Rml::ElementUtilities::GetElementById(document, id));
+			const uint64_t search_elapsed = OS::get_singleton()->get_ticks_usec() - start;
+
+			start = OS::get_singleton()->get_ticks_usec();
+			std::vector<Rml::Element *> indexed;
+			for (const Rml::String &id : ids)
+				indexed.push_back(document->GetElementById(id));
+			const uint64_t index_elapsed = OS::get_singleton()->get_ticks_usec() - start;
+
+			MESSAGE(vformat("%d lookups among %d elements: search %d usec, index %d usec.", lookups, count, (int64_t)search_elapsed, (int64_t)index_elapsed));
+			CHECK(searched == indexed);
+			CHECK(indexed[0] == elements[count - 1]);
+
+			// Removed and renamed elements must no longer be found.
+			Rml::Element *last = elements[count - 1];
+			last->SetId("renamed");
+			CHECK(document->GetElementById(ids[0]) == nullptr);
+			CHECK(document->GetElementById("renamed") == last);
+			last->GetParentNode()->RemoveChild(last);
+			CHECK(document->GetElementById("renamed") == nullptr);
+
+			document->Close();
+			context->Update();
+		}
+	}
+
+	TEST_CASE("[rmlui] duplicate and cleared ids") {
+		RmlTestContext test;
+		Rml::ElementDocument *document = test.load(
+				"<rml><body>"
+				"<div><div><p id='dup'>deep</p></div><p id='dup'>first</p></div>"
+				"<p id='dup'>second</p>"
+				"<p id='other'>other</p>"
+				"</body></rml>");
+		REQUIRE(document != nullptr);
+
+		// Like a search, the shallowest element with the id is found first.
+		Rml::Element *found = document->GetElementById("dup");
+		REQUIRE(found != nullptr);
+		CHECK(found->GetInnerRML() == "second");
+		CHECK(found == Rml::ElementUtilities::GetElementById(document, "dup"));
+
+		found->GetParentNode()->RemoveChild(found);
+		found = document->GetElementById("dup");
+		REQUIRE(found != nullptr);
+		CHECK(found->GetInnerRML() == "first");
+
+		found->GetParentNode()->RemoveChild(found);
+		found = document->GetElementById("dup");
+		REQUIRE(found != nullptr);
+		CHECK(found->GetInnerRML() == "deep");
+
+		Rml::Element *other = document->GetElementById("other");
+		REQUIRE(other != nullptr);
+		other->RemoveAttribute("id");
+		CHECK(document->GetElementById("other") == nullptr);
+		CHECK(Rml::ElementUtilities::GetElementById(document, "other") == nullptr);
+	}
+}
+
+TEST_SUITE("[[rmlui]] Parallel style resolution") {
+	TEST_CASE("[rmlui] style update scaling") {
+		RmlTestContext test;
+		Rml::Context *context = test.context;
+
+		Rml::String rml = "<rml><head><style>"
+						  "body { display: block; }"
+						  "div { display: block; height: 1px; }"
+						  "div.row div.cell:first-child { color: #f00; }"
+						  "div.row > div.cell + div.cell { color: #0f0; }"
+						  "body.toggle div.row:nth-child(odd) div.cell { color: #00f; }"
+						  "body.toggle div.row div.cell:last-child { width: 5px; }"
+						  "</style></head><body>";
+		for (int row = 0; row < 500; row++) {
+			rml += "<div class=\"row\">";
+			for (int cell = 0; cell < 20; cell++)
+				rml += "<div class=\"cell\"/>";
+			rml += "</div>";
+		}
+		rml += "</body></rml>";
+
+		Rml::ElementDocument *document = test.load(rml);
+
+		Rml::Element *first_cell = document->GetFirstChild()->GetFirstChild();
+		const int thread_counts[] = { 1, 4, 8 };
+		for (int t = 0; t < 3; t++) {
+			context->SetStyleThreadCount(thread_counts[t]);
+			CHECK(context->GetStyleThreadCount() == thread_counts[t]);
+
+			// Toggling the class on the body re-matches every element in the document.
+			const uint64_t start = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < 10; i++) {
+				document->SetClass("toggle", i % 2 == 0);
+				context->Update();
+			}
+			const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - start;
+
+			MESSAGE(vformat("10 style updates of 10500 elements on %d threads in %d usec.", thread_counts[t], (int64_t)elapsed));
+			CHECK(first_cell->GetProperty<Rml::Colourb>("color") == Rml::Colourb(255, 0, 0));
+		}
+	}
+
+	TEST_CASE("[rmlui] moved and renamed elements are matched against their new ancestors") {
+		RmlTestContext test;
+		Rml::Context *context = test.context;
+		context->SetStyleThreadCount(4);
+
+		Rml::String rml = "<rml><head><style>"
+						  "body { display: block; }"
+						  "div { display: block; }"
+						  ".a span { color: #f00; }"
+						  ".b span { color: #0f0; }"
+						  "</style></head><body><div id=\"a\" class=\"a\">";
+		for (int i = 0; i < 200; i++)
+			rml += "<div><span/></div>";
+		rml += "</div><div id=\"b\" class=\"b\"/></body></rml>";
+
+		Rml::ElementDocument *document = test.load(rml);
+		Rml::Element *a = document->GetElementById("a");
+		Rml::Element *b = document->GetElementById("b");
+		CHECK(a->GetChild(0)->GetChild(0)->GetProperty<Rml::Colourb>("color") == Rml::Colourb(255, 0, 0));
+
+		// Moving a subtree must rebuild the ancestor filters it was matched with.
+		Rml::Element *moved = b->AppendChild(a->RemoveChild(a->GetChild(0)));
+		context->Update();
+		CHECK(moved->GetChild(0)->GetProperty<Rml::Colourb>("color") == Rml::Colourb(0, 255, 0));
+		CHECK(a->GetChild(0)->GetChild(0)->GetProperty<Rml::Colourb>("color") == Rml::Colourb(255, 0, 0));
+
+		// Renaming an ancestor re-matches all of its descendants.
+		b->SetClass("a", true);
+		b->SetClass("b", false);
+		a->SetClass("b", true);
+		a->SetClass("a", false);
+		context->Update();
+		CHECK(moved->GetChild(0)->GetProperty<Rml::Colourb>("color") == Rml::Colourb(255, 0, 0));
+		for (int i = 0; i < a->GetNumChildren(); i++)
+			CHECK(a->GetChild(i)->GetChild(0)->GetProperty<Rml::Colourb>("color") == Rml::Colourb(0, 255, 0));
+	}
+}
+
+TEST_SUITE("[[rmlui]] Ancestor filter") {
+	TEST_CASE("[rmlui] descendant selectors are rejected without walking") {
+		RmlTestContext test;
+
+		Rml::String rml = "<rml><head><style>"
+						  "body { display: block; }"
+						  ".panel .row span { color: #f00; }"
+						  ".list .item span { color: #0f0; }"
+						  "</style></head><body><div class=\"list\">";
+		for (int i = 0; i < 100; i++)
+			rml += "<div class=\"item\"><span/></div>";
+		rml += "</div></body></rml>";
+
+		Rml::ResetSelectorMatchStats();
+		Rml::ElementDocument *document = test.load(rml);
+
+		const Rml::SelectorMatchStats stats = Rml::GetSelectorMatchStats();
+		MESSAGE(vformat("Rejects: %d, walks: %d, matches: %d.", (int64_t)stats.ancestor_filter_rejects, (int64_t)stats.hierarchy_walks, (int64_t)stats.matches));
+		// Every span is indexed under both rules, but only the '.list .item' rule requires ancestors that exist.
+		CHECK(stats.ancestor_filter_rejects >= 100);
+		CHECK(stats.matches >= 100);
+
+		Rml::Element *span = document->GetFirstChild()->GetFirstChild()->GetFirstChild();
+		CHECK(span->GetProperty<Rml::Colourb>("color") == Rml::Colourb(0, 255, 0));
+	}
+}
+
+TEST_SUITE("[[rmlui]] Style sharing") {
+	TEST_CASE("[rmlui] shared sibling styles match individually resolved styles") {
+		RmlTestContext test;
+		Rml::Context *context = test.context;
+
+		// Siblings with differing ids never share their style, which gives the baseline to compare against.
+		const auto make_rml = [](bool unique_ids) {
+			Rml::String rml = "<rml><head><style>"
+							  "body { display: block; font-size: 10px; }"
+							  "div { display: block; }"
+							  ".list .row { color: #f00; height: 2em; }"
+							  ".list .row:hover { color: #0f0; }"
+							  ".striped .row:nth-child(even) { color: #00f; }"
+							  "</style></head><body><div class=\"list\">";
+			for (int i = 0; i < 2000; i++)
+				rml += unique_ids ? Rml::CreateString(32, "<div id=\"r%d\" class=\"row\"/>", i) : Rml::String("<div class=\"row\"/>");
+			rml += "</div><div class=\"list striped\">";
+			for (int i = 0; i < 4; i++)
+				rml += "<div class=\"row\"/>";
+			return rml + "</div></body></rml>";
+		};
+
+		uint64_t start = OS::get_singleton()->get_ticks_usec();
+		Rml::ElementDocument *unshared = test.load(make_rml(true));
+		const uint64_t unshared_elapsed = OS::get_singleton()->get_ticks_usec() - start;
+
+		start = OS::get_singleton()->get_ticks_usec();
+		Rml::ElementDocument *document = test.load(make_rml(false));
+		const uint64_t shared_elapsed = OS::get_singleton()->get_ticks_usec() - start;
+		MESSAGE(vformat("Styled 2000 sibling rows in %d usec resolved individually, %d usec shared.", (int64_t)unshared_elapsed, (int64_t)shared_elapsed));
+
+		Rml::Element *list = document->GetChild(0);
+		Rml::Element *striped = document->GetChild(1);
+		for (int i : { 0, 1, 1000, 1999 }) {
+			Rml::Element *row = list->GetChild(i);
+			Rml::Element *expected = unshared->GetChild(0)->GetChild(i);
+			CHECK(row->GetProperty<Rml::Colourb>("color") == expected->GetProperty<Rml::Colourb>("color"));
+			CHECK(row->GetComputedValues().height().value == expected->GetComputedValues().height().value);
+			CHECK(row->GetBox() == expected->GetBox());
+		}
+		CHECK(list->GetChild(1999)->GetProperty<Rml::Colourb>("color") == Rml::Colourb(255, 0, 0));
+		CHECK(list->GetChild(1999)->GetComputedValues().height().value == 20.f);
+		unshared->Close();
+		context->Update();
+
+		// Structural selectors must not be shared between siblings.
+		CHECK(striped->GetChild(0)->GetProperty<Rml::Colourb>("color") == Rml::Colourb(255, 0, 0));
+		CHECK(striped->GetChild(1)->GetProperty<Rml::Colourb>("color") == Rml::Colourb(0, 0, 255));
+
+		// Neither must differing pseudo-classes or inline properties.
+		list->GetChild(10)->SetPseudoClass("hover", true);
+		list->GetChild(20)->SetProperty("font-size", "20px");
+		context->Update();
+		CHECK(list->GetChild(10)->GetProperty<Rml::Colourb>("color") == Rml::Colourb(0, 255, 0));
+		CHECK(list->GetChild(11)->GetProperty<Rml::Colourb>("color") == Rml::Colourb(255, 0, 0));
+		CHECK(list->GetChild(20)->GetComputedValues().height().value == 40.f);
+		CHECK(list->GetChild(21)->GetComputedValues().height().value == 20.f);
+	}
+}
+
+TEST_SUITE("[[rmlui]] Computed values") {
+	TEST_CASE("[rmlui] inherited values are shared until modified") {
+		RmlTestContext test;
+		Rml::Context *context = test.context;
+
+		// A distinct inline colour gives every cell its own inherited values, which gives the baseline to compare against.
+		const auto make_rml = [](bool private_values) {
+			Rml::String rml = "<rml><head><style>"
+							  "body { display: block; }"
+							  "div { display: block; }"
+							  ".row { color: #f00; }"
+							  "</style></head><body>";
+			for (int i = 0; i < 1000; i++) {
+				if (private_values)
+					rml += Rml::CreateString(96, "<div class=\"row\"><div style=\"color: #%06x;\">a</div><div style=\"color: #%06x;\">b</div></div>", 2 * i + 1, 2 * i + 2);
+				else
+					rml += "<div class=\"row\"><div>a</div><div>b</div></div>";
+			}
+			return rml + "</body></rml>";
+		};
+
+		Rml::ElementDocument *document = test.load(make_rml(false));
+		Rml::ElementDocument *unshared = test.load(make_rml(true));
+		CHECK(!unshared->GetChild(1)->GetChild(0)->GetComputedValues().SharesInheritedWith(unshared->GetChild(1)->GetComputedValues()));
+
+		// Restyling the whole document writes the font size of every element.
+		const auto restyle = [context](Rml::ElementDocument *restyled_document) {
+			const uint64_t start = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < 10; i++) {
+				restyled_document->SetProperty("font-size", i % 2 == 0 ? "14px" : "16px");
+				context->Update();
+			}
+			return (int64_t)(OS::get_singleton()->get_ticks_usec() - start);
+		};
+		const int64_t unshared_usec = restyle(unshared);
+		const int64_t shared_usec = restyle(document);
+		MESSAGE(vformat("10 full restyles of 3000 elements: %d usec with private values, %d usec with shared values.", unshared_usec, shared_usec));
+		CHECK(document->GetChild(1)->GetChild(0)->GetComputedValues().font_size() == 16.f);
+		CHECK(unshared->GetChild(1)->GetChild(0)->GetComputedValues().font_size() == 16.f);
+		CHECK(document->GetChild(1)->GetChild(0)->GetBox() == unshared->GetChild(1)->GetChild(0)->GetBox());
+		unshared->Close();
+		context->Update();
+
+		Rml::Element *row = document->GetChild(1);
+		const Rml::ComputedValues &row_values = row->GetComputedValues();
+		CHECK(row_values.SharesInheritedWith(document->GetChild(0)->GetComputedValues()));
+		CHECK(!row_values.SharesInheritedWith(document->GetComputedValues()));
+		CHECK(row->GetChild(0)->GetComputedValues().SharesInheritedWith(row_values));
+
+		// Writing to shared values must only affect the element written to.
+		row->GetChild(1)->SetProperty("color", "#0f0");
+		context->Update();
+		CHECK(row->GetChild(1)->GetProperty<Rml::Colourb>("color") == Rml::Colourb(0, 255, 0));
+		CHECK(row->GetChild(0)->GetProperty<Rml::Colourb>("color") == Rml::Colourb(255, 0, 0));
+		CHECK(row->GetProperty<Rml::Colourb>("color") == Rml::Colourb(255, 0, 0));
+
+		// Inherited changes from the root must still reach the elements sharing values.
+		document->SetProperty("font-size", "16px");
+		context->Update();
+		CHECK(row->GetChild(0)->GetComputedValues().font_size() == 16.f);
+	}
+}
+
+TEST_SUITE("[[rmlui]] Layout boundaries") {
+	TEST_CASE("[rmlui] changes inside a boundary only relayout the boundary") {
+		RmlTestContext test;
+		Rml::Context *context = test.context;
+
+		Rml::String rml = "<rml><head><style>"
+						  "body { display: block; font-size: 10px; }"
+						  "div, p { display: block; }"
+						  ".panel { position: relative; width: 100px; height: 50px; overflow: hidden; }"
+						  ".contained { width: 100px; height: 50px; contain: layout; }"
+						  ".popup { position: absolute; top: 0; left: 0; width: 50px; }"
+						  "</style></head><body>";
+		for (int i = 0; i < 200; i++)
+			rml += "<div class=\"panel\"><p>text</p><p>more text</p></div>";
+		rml += "<div class=\"contained\"><p>text</p></div><div class=\"popup\"><p>text</p></div><p id=\"outside\">text</p></body></rml>";
+
+		Rml::ElementDocument *document = test.load(rml);
+
+		Rml::Element *panel = document->GetChild(100);
+		const Rml::Vector2f panel_offset = panel->GetAbsoluteOffset();
+		const Rml::Vector2f next_offset = document->GetChild(101)->GetAbsoluteOffset();
+
+		panel->GetChild(0)->SetInnerRML("changed text");
+		context->Update();
+		CHECK(context->GetLayoutStats().full_layouts == 0);
+		CHECK(context->GetLayoutStats().boundary_layouts == 1);
+		CHECK(context->GetLayoutStats().formatted_elements < 10);
+		CHECK(panel->GetAbsoluteOffset() == panel_offset);
+		CHECK(document->GetChild(101)->GetAbsoluteOffset() == next_offset);
+		CHECK(panel->GetChild(1)->GetAbsoluteOffset().y == panel_offset.y + panel->GetChild(0)->GetBox().GetSize(Rml::Box::MARGIN).y);
+
+		document->GetChild(200)->GetChild(0)->SetInnerRML("changed text");
+		document->GetChild(201)->GetChild(0)->SetInnerRML("changed text");
+		context->Update();
+		CHECK(context->GetLayoutStats().full_layouts == 0);
+		CHECK(context->GetLayoutStats().boundary_layouts == 2);
+
+		// Changes outside of any boundary, or changes to the size of a boundary, require a full layout.
+		document->GetElementById("outside")->SetInnerRML("changed text");
+		context->Update();
+		CHECK(context->GetLayoutStats().full_layouts == 1);
+
+		panel->SetProperty("height", "60px");
+		context->Update();
+		CHECK(context->GetLayoutStats().full_layouts == 1);
+		CHECK(document->GetChild(101)->GetAbsoluteOffset().y == next_offset.y + 10.f);
+
+		context->Update();
+		CHECK(context->GetLayoutStats().full_layouts == 0);
+		CHECK(context->GetLayoutStats().formatted_elements == 0);
+	}
+
+	TEST_CASE("[rmlui] a boundary is formatted under the containing block of the full layout") {
+		RmlTestContext test;
+		Rml::Context *context = test.context;
+
+		// The wrapper is sized automatically, so the percentage is resolved against the height of the body rather than the wrapper.
+		Rml::ElementDocument *document = test.load("<rml><head><style>"
+												   "body { display: block; font-size: 10px; width: 400px; height: 400px; }"
+												   "div, p { display: block; }"
+												   ".contained { width: 100px; height: 100px; max-height: 50%; contain: layout; }"
+												   "</style></head><body><div id=\"wrapper\"><div id=\"contained\" class=\"contained\"><p>text</p></div></div></body></rml>");
+		Rml::Element *contained = document->GetElementById("contained");
+		REQUIRE(contained != nullptr);
+		const Rml::Box box = contained->GetBox();
+		CHECK(box.GetSize().y == 100.f);
+		CHECK(document->GetElementById("wrapper")->GetBox().GetSize().y == 100.f);
+
+		contained->GetChild(0)->SetInnerRML("changed text");
+		context->Update();
+		CHECK(context->GetLayoutStats().full_layouts == 0);
+		CHECK(context->GetLayoutStats().boundary_layouts == 1);
+		CHECK(contained->GetBox() == box);
+	}
+}
+
+TEST_SUITE("[[rmlui]] Layout cache") {
+	TEST_CASE("[rmlui] unchanged flex items are not formatted again") {
+		RmlTestContext test;
+		Rml::Context *context = test.context;
+
+		const auto make_rml = [](const Rml::String &changed_text) {
+			Rml::String rml = "<rml><head><style>"
+							  "body { display: block; font-size: 10px; width: 400px; }"
+							  ".row { display: flex; }"
+							  ".label { flex: 1 1 auto; }"
+							  ".value { flex: 0 0 auto; padding: 0 5px; }"
+							  "</style></head><body>";
+			for (int i = 0; i < 100; i++)
+				rml += "<div class=\"row\"><div class=\"label\"><span>Setting</span> <span>name</span></div><div class=\"value\">" + (i == 50 ? changed_text : "Off") +
+					"</div></div>";
+			return rml + "</body></rml>";
+		};
+
+		Rml::ElementDocument *document = test.load(make_rml("Off"));
+
+		document->GetChild(50)->GetChild(1)->SetInnerRML("A much longer value");
+		uint64_t start = OS::get_singleton()->get_ticks_usec();
+		context->Update();
+		const uint64_t cached_elapsed = OS::get_singleton()->get_ticks_usec() - start;
+		const int cached_formatted_elements = context->GetLayoutStats().formatted_elements;
+		CHECK(context->GetLayoutStats().full_layouts == 1);
+
+		// Make the same change to a document where setting a layout property on every flex item has cleared all cached results.
+		Rml::ElementDocument *uncached = test.load(make_rml("Off"));
+		for (int i = 0; i < 100; i++) {
+			for (int j = 0; j < 2; j++)
+				uncached->GetChild(i)->GetChild(j)->SetProperty("padding-top", "0px");
+		}
+		uncached->GetChild(50)->GetChild(1)->SetInnerRML("A much longer value");
+		start = OS::get_singleton()->get_ticks_usec();
+		context->Update();
+		const uint64_t uncached_elapsed = OS::get_singleton()->get_ticks_usec() - start;
+		MESSAGE(vformat("Relayout after changing one row: %d usec formatting %d elements without the cache, %d usec formatting %d elements with it.",
+				(int64_t)uncached_elapsed, context->GetLayoutStats().formatted_elements, (int64_t)cached_elapsed, cached_formatted_elements));
+		CHECK(cached_formatted_elements * 4 < context->GetLayoutStats().formatted_elements);
+
+		// Both results must match a document formatted from scratch.
+		Rml::ElementDocument *reference = test.load(make_rml("A much longer value"));
+		for (Rml::ElementDocument *formatted : { document, uncached }) {
+			for (int i : { 0, 50, 99 }) {
+				for (int j = 0; j < 2; j++) {
+					Rml::Element *element = formatted->GetChild(i)->GetChild(j);
+					Rml::Element *expected = reference->GetChild(i)->GetChild(j);
+					CHECK(element->GetBox() == expected->GetBox());
+					CHECK(element->GetAbsoluteOffset() - formatted->GetAbsoluteOffset() == expected->GetAbsoluteOffset() - reference->GetAbsoluteOffset());
+				}
+			}
+		}
+	}
+}
+
+TEST_SUITE("[[rmlui]] Layout arena") {
+	TEST_CASE("[rmlui] repeated layout of a large document") {
+		RmlTestContext test;
+		Rml::Context *context = test.context;
+
+		Rml::String rml = "<rml><head><style>"
+						  "body { display: block; font-size: 10px; width: 400px; }"
+						  "div { display: block; }"
+						  "</style></head><body>";
+		for (int i = 0; i < 1250; i++)
+			rml += "<div><span>Label</span> value</div>";
+		rml += "</body></rml>";
+
+		// Loading formats the document outside Context::Update, so the arena use is measured on a later layout.
+		Rml::ElementDocument *document = test.load(rml);
+		document->SetProperty("width", "390px");
+		context->Update();
+		const int arena_bytes = context->GetLayoutStats().layout_arena_bytes;
+		CHECK(arena_bytes > 0);
+
+		const int iterations = 20;
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < iterations; i++) {
+			document->SetProperty("width", i % 2 ? "400px" : "380px");
+			context->Update();
+			CHECK(context->GetLayoutStats().full_layouts == 1);
+		}
+		MESSAGE(vformat("Formatted 5000 elements in %d usec on average, using %d bytes of layout boxes.",
+				(int64_t)(OS::get_singleton()->get_ticks_usec() - start) / iterations, arena_bytes));
+
+		// The arena is rewound after every layout, so repeated layouts need no more memory.
+		CHECK(context->GetLayoutStats().layout_arena_bytes <= arena_bytes + arena_bytes / 10);
+	}
+}
+
+TEST_SUITE("[[rmlui]] Hit testing") {
+	TEST_CASE("[rmlui] element at point follows layout, stacking and transforms") {
+		RmlTestContext test;
+		Rml::Context *context = test.context;
+
+		// A grid of 50x40 cells, each 10px wide and 8px high.
+		Rml::String rml = "<rml><head><style>"
+						  "body { display: block; width: 500px; height: 320px; }"
+						  "div { display: block; position: absolute; width: 10px; height: 8px; }"
+						  "#overlay { left: 100px; top: 100px; width: 50px; height: 50px; z-index: 1; }"
+						  "</style></head><body>";
+		for (int i = 0; i < 2000; i++)
+			rml += Rml::CreateString(96, "<div id=\"c%d\" style=\"left: %dpx; top: %dpx;\"/>", i, (i % 50) * 10, (i / 50) * 8);
+		rml += "<div id=\"overlay\"/></body></rml>";
+
+		Rml::ElementDocument *document = test.load(rml);
+
+		CHECK(context->GetElementAtPoint(Rml::Vector2f(5, 4)) == document->GetElementById("c0"));
+		CHECK(context->GetElementAtPoint(Rml::Vector2f(495, 316)) == document->GetElementById("c1999"));
+		CHECK(context->GetElementAtPoint(Rml::Vector2f(125, 125)) == document->GetElementById("overlay"));
+		CHECK(context->GetElementAtPoint(Rml::Vector2f(125, 125), document->GetElementById("overlay")) != document->GetElementById("overlay"));
+
+		// Compare against testing every element, front to back, as the context did before the index.
+		const auto find_by_walk = [document](Rml::Vector2f point) -> Rml::Element * {
+			for (int i = document->GetNumChildren() - 1; i >= 0; i--) {
+				if (document->GetChild(i)->IsPointWithinElement(point))
+					return document->GetChild(i);
+			}
+			return document;
+		};
+		const int num_points = 10000;
+		Rml::Vector<Rml::Vector2f> points;
+		for (int i = 0; i < num_points; i++)
+			points.push_back(Rml::Vector2f(float(i % 500) + 0.5f, float((i / 500) * 16 % 320) + 0.5f));
+
+		uint64_t start = OS::get_singleton()->get_ticks_usec();
+		Rml::Vector<Rml::Element *> walked;
+		for (const Rml::Vector2f &point : points)
+			walked.push_back(find_by_walk(point));
+		const uint64_t walk_elapsed = OS::get_singleton()->get_ticks_usec() - start;
+
+		start = OS::get_singleton()->get_ticks_usec();
+		Rml::Vector<Rml::Element *> indexed;
+		for (const Rml::Vector2f &point : points)
+			indexed.push_back(context->GetElementAtPoint(point));
+		const uint64_t index_elapsed = OS::get_singleton()->get_ticks_usec() - start;
+
+		MESSAGE(vformat("%d hit tests among 2001 elements: walk %d usec, index %d usec.", num_points, (int64_t)walk_elapsed, (int64_t)index_elapsed));
+		CHECK(walked == indexed);
+
+		// Moved, transformed and hidden elements are found at their new location.
+		Rml::Element *cell = document->GetElementById("c0");
+		cell->SetProperty("left", "600px");
+		context->Update();
+		CHECK(context->GetElementAtPoint(Rml::Vector2f(605, 4)) == cell);
+		CHECK(context->GetElementAtPoint(Rml::Vector2f(5, 4)) == document);
+
+		// Transforms are applied when the context renders.
+		cell->SetProperty("transform", "translateX(-600px)");
+		context->Update();
+		test.plugin.draw();
+		CHECK(context->GetElementAtPoint(Rml::Vector2f(5, 4)) == cell);
+
+		document->GetElementById("overlay")->SetProperty("display", "none");
+		context->Update();
+		CHECK(context->GetElementAtPoint(Rml::Vector2f(125, 125)) == document->GetElementById("c762"));
+	}
+
+	TEST_CASE("[rmlui] mouse moves hover the element found through the index") {
+		RmlTestContext test;
+		Rml::Context *context = test.context;
+
+		Rml::ElementDocument *document = test.load("<rml><head><style>"
+												   "body { display: block; width: 200px; height: 100px; }"
+												   "div { display: block; position: absolute; top: 0; width: 50px; height: 50px; }"
+												   "</style></head><body><div id=\"a\" style=\"left: 0;\"/><div id=\"b\" style=\"left: 100px;\"/></body></rml>");
+
+		context->ProcessMouseMove(25, 25, 0);
+		CHECK(context->GetHoverElement() == document->GetElementById("a"));
+		CHECK(document->GetElementById("a")->IsPseudoClassSet("hover"));
+
+		context->ProcessMouseMove(125, 25, 0);
+		CHECK(context->GetHoverElement() == document->GetElementById("b"));
+		CHECK(!document->GetElementById("a")->IsPseudoClassSet("hover"));
+
+		// A modal document in front keeps the mouse from reaching the documents behind it.
+		Rml::ElementDocument *modal = context->LoadDocumentFromMemory("<rml><head><style>"
+																	   "body { display: block; position: absolute; left: 100px; width: 100px; height: 100px; }"
+																	   "</style></head><body/></rml>");
+		REQUIRE(modal != nullptr);
+		modal->Show(Rml::ModalFlag::Modal);
+		context->Update();
+
+		context->ProcessMouseMove(25, 25, 0);
+		CHECK(context->GetHoverElement() == nullptr);
+		context->ProcessMouseMove(125, 25, 0);
+		CHECK(context->GetHoverElement() == modal);
+	}
+}
+
+TEST_SUITE("[[rmlui]] Data-for views") {
+	TEST_CASE("[rmlui] growing a list instances rows from the compiled template") {
+		RmlTestContext test;
+		Rml::Context *context = test.context;
+
+		Rml::Vector<int> values;
+		Rml::DataModelConstructor constructor = context->CreateDataModel("rows");
+		REQUIRE(constructor);
+		constructor.RegisterArray<Rml::Vector<int>>();
+		constructor.Bind("values", &values);
+		Rml::DataModelHandle handle = constructor.GetModelHandle();
+
+		Rml::String rml = "<rml><head><style>"
+						  "body { display: block; width: 400px; }"
+						  "div { display: block; }"
+						  "</style></head><body><div id=\"list\" data-model=\"rows\">"
+						  "<div data-for=\"value : values\"><span class=\"label\">Row {{it_index}}</span> {{value}}</div>"
+						  "</div></body></rml>";
+
+		Rml::ElementDocument *document = test.load(rml);
+
+		Rml::Element *list = document->GetElementById("list");
+		REQUIRE(list != nullptr);
+		CHECK(list->GetNumChildren() == 1);
+
+		const int num_rows = 10000;
+		const int step = 1000;
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		while ((int)values.size() < num_rows) {
+			for (int i = 0; i < step; i++)
+				values.push_back((int)values.size());
+			handle.DirtyVariable("values");
+			context->Update();
+		}
+		MESSAGE(vformat("Grew a data-for list from 0 to %d rows in %d usec.", num_rows, (int64_t)(OS::get_singleton()->get_ticks_usec() - start)));
+
+		// The rows come before the hidden data-for element, each with the full contents of the template.
+		REQUIRE(list->GetNumChildren() == num_rows + 1);
+		Rml::Element *row = list->GetChild(num_rows - 1);
+		REQUIRE(row->GetNumChildren() == 2);
+		CHECK(row->GetChild(0)->IsClassSet("label"));
+		Rml::ElementText *label = rmlui_dynamic_cast<Rml::ElementText *>(row->GetChild(0)->GetChild(0));
+		REQUIRE(label != nullptr);
+		CHECK(label->GetText() == "Row 9999");
+
+		values.resize(10);
+		handle.DirtyVariable("values");
+		context->Update();
+		CHECK(list->GetNumChildren() == 11);
+	}
+
+	TEST_CASE("[rmlui] keyed rows keep their elements when the list is reordered") {
+		RmlTestContext test;
+		Rml::Context *context = test.context;
+
+		Rml::Vector<Rml::String> names;
+		for (int i = 0; i < 1000; i++)
+			names.push_back(Rml::CreateString(16, "n%d", i));
+
+		Rml::DataModelConstructor constructor = context->CreateDataModel("scores");
+		REQUIRE(constructor);
+		constructor.RegisterArray<Rml::Vector<Rml::String>>();
+		constructor.Bind("names", &names);
+		Rml::DataModelHandle handle = constructor.GetModelHandle();
+
+		Rml::String rml = "<rml><head><style>"
+						  "body { display: block; width: 400px; }"
+						  "div { display: block; }"
+						  "</style></head><body><div id=\"list\" data-model=\"scores\">"
+						  "<div data-for=\"name, i : names\" data-for-key=\"name\">{{i}}:{{name}}</div>"
+						  "</div></body></rml>";
+
+		Rml::ElementDocument *document = test.load(rml);
+
+		Rml::Element *list = document->GetElementById("list");
+		REQUIRE(list != nullptr);
+		REQUIRE(list->GetNumChildren() == 1001);
+		Rml::Element *first = list->GetChild(0);
+
+		// Inserting at the front only creates the new row, the existing rows follow their items.
+		names.insert(names.begin(), "new");
+		handle.DirtyVariable("names");
+		context->Update();
+		REQUIRE(list->GetNumChildren() == 1002);
+		CHECK(list->GetChild(1) == first);
+		CHECK(GetRowText(list, 0) == "0:new");
+		CHECK(GetRowText(list, 1) == "1:n0");
+
+		std::reverse(names.begin(), names.end());
+		handle.DirtyVariable("names");
+		context->Update();
+		REQUIRE(list->GetNumChildren() == 1002);
+		CHECK(list->GetChild(999) == first);
+		CHECK(GetRowText(list, 999) == "999:n0");
+		CHECK(GetRowText(list, 1000) == "1000:new");
+
+		names.erase(names.begin(), names.begin() + 500);
+		handle.DirtyVariable("names");
+		context->Update();
+		REQUIRE(list->GetNumChildren() == 502);
+		CHECK(list->GetChild(499) == first);
+		CHECK(GetRowText(list, 0) == "0:n499");
+	}
+
+	TEST_CASE("[rmlui] virtualized rows only cover the viewport") {
+		RmlTestContext test;
+		Rml::Context *context = test.context;
+
+		const int num_entries = 100000;
+		Rml::Vector<int> entries(num_entries);
+		for (int i = 0; i < num_entries; i++)
+			entries[i] = i;
+
+		Rml::DataModelConstructor constructor = context->CreateDataModel("log");
+		REQUIRE(constructor);
+		constructor.RegisterArray<Rml::Vector<int>>();
+		constructor.Bind("entries", &entries);
+
+		Rml::String rml = "<rml><head><style>"
+						  "body { display: block; width: 400px; }"
+						  "div { display: block; }"
+						  "#list { height: 200px; overflow-y: auto; }"
+						  "</style></head><body><div id=\"list\" data-model=\"log\">"
+						  "<div data-for=\"entry : entries\" data-for-virtual=\"20px\" style=\"height: 20px;\">{{entry}}</div>"
+						  "</div></body></rml>";
+
+		Rml::ElementDocument *document = test.load(rml);
+
+		// The rows in view are known once the list has been laid out.
+		for (int i = 0; i < 3; i++)
+			context->Update();
+
+		Rml::Element *list = document->GetElementById("list");
+		REQUIRE(list != nullptr);
+
+		// Two spacers and the hidden data-for element surround the rows, which cover the 200px viewport.
+		const int num_children = list->GetNumChildren();
+		CHECK(num_children >= 3 + 200 / 20);
+		CHECK(num_children < 30);
+		CHECK(GetRowText(list, 1) == "0");
+		CHECK(list->GetScrollHeight() == doctest::Approx(num_entries * 20.f));
+
+		// Away from the top, rows are also instanced above the viewport.
+		list->SetScrollTop(50000.f);
+		context->Update();
+		CHECK(list->GetNumChildren() < 30);
+		CHECK(GetRowText(list, 1) == "2498");
+		CHECK(list->GetChild(1)->GetAbsoluteOffset(Rml::Box::BORDER).y - list->GetAbsoluteOffset(Rml::Box::PADDING).y == doctest::Approx(-40.f));
+
+		// Jumping back reuses the same number of rows.
+		list->SetScrollTop(0.f);
+		context->Update();
+		CHECK(list->GetNumChildren() == num_children);
+		CHECK(GetRowText(list, 1) == "0");
+	}
+}
+
+TEST_SUITE("[[rmlui]] Data expressions") {
+	struct Player {
+		int hp = 40;
+		int max_hp = 160;
+		Rml::String name = "Ayla";
+	};
+
+	TEST_CASE("[rmlui] compiled expressions match hand-written evaluation") {
+		Rml::DataTypeRegister type_register;
+		Rml::DataModel model(&type_register);
+		Rml::DataModelConstructor constructor(&model);
+
+		Player player;
+		float health = 0.75f;
+		if (auto player_handle = constructor.RegisterStruct<Player>()) {
+			player_handle.RegisterMember("hp", &Player::hp);
+			player_handle.RegisterMember("max_hp", &Player::max_hp);
+			player_handle.RegisterMember("name", &Player::name);
+		}
+		REQUIRE(constructor.Bind("player", &player));
+		REQUIRE(constructor.Bind("health", &health));
+
+		const char *sources[] = {
+			"health",
+			"player.hp / player.max_hp * 100",
+			"player.name + ' (' + player.hp + ')'",
+			"player.hp < 50 && health > 0.5 ? 'low' : 'ok'",
+			"2 * 60 + 30",
+			"!(1 < 2) ? 'yes' : 'no'",
+		};
+		const Rml::Variant expected[] = { Rml::Variant(0.75), Rml::Variant(25.0), Rml::Variant("Ayla (40)"), Rml::Variant("low"), Rml::Variant(150.0), Rml::Variant("no") };
+		const int num_sources = sizeof(sources) / sizeof(sources[0]);
+
+		// The baseline evaluates each source by hand, looking up every variable through its full address on each run.
+		Rml::DataExpressionInterface expression_interface(&model, nullptr);
+		const Rml::DataAddress health_address = expression_interface.ParseAddress("health");
+		const Rml::DataAddress hp_address = expression_interface.ParseAddress("player.hp");
+		const Rml::DataAddress max_hp_address = expression_interface.ParseAddress("player.max_hp");
+		const Rml::DataAddress name_address = expression_interface.ParseAddress("player.name");
+		auto get = [&](const Rml::DataAddress &address) { return expression_interface.GetValue(address); };
+		const Rml::Function<Rml::Variant()> evaluators[] = {
+			[&] { return get(health_address); },
+			[&] { return Rml::Variant(get(hp_address).Get<double>() / get(max_hp_address).Get<double>() * 100.0); },
+			[&] { return Rml::Variant(get(name_address).Get<Rml::String>() + " (" + get(hp_address).Get<Rml::String>() + ")"); },
+			[&] { return Rml::Variant(get(hp_address).Get<double>() < 50.0 && get(health_address).Get<double>() > 0.5 ? "low" : "ok"); },
+			[&] { return Rml::Variant(2.0 * 60.0 + 30.0); },
+			[&] { return Rml::Variant(!(1.0 < 2.0) ? "yes" : "no"); },
+		};
+
+		// A data-heavy HUD evaluates thousands of expressions per update.
+		const int num_copies = 500;
+		Rml::Vector<Rml::Function<Rml::Variant()>> baseline;
+		Rml::Vector<Rml::UniquePtr<Rml::DataExpression>> compiled;
+		for (int i = 0; i < num_copies; i++) {
+			for (int j = 0; j < num_sources; j++) {
+				baseline.push_back(evaluators[j]);
+				compiled.push_back(Rml::MakeUnique<Rml::DataExpression>(sources[j]));
+				REQUIRE(compiled.back()->Parse(expression_interface, false));
+			}
+		}
+
+		for (int j = 0; j < num_sources; j++) {
+			const Rml::Variant baseline_value = baseline[j]();
+			Rml::Variant compiled_value;
+			REQUIRE(compiled[j]->Run(expression_interface, compiled_value));
+			if (expected[j].GetType() == Rml::Variant::STRING) {
+				CHECK(baseline_value.Get<Rml::String>() == expected[j].Get<Rml::String>());
+				CHECK(compiled_value.Get<Rml::String>() == expected[j].Get<Rml::String>());
+			} else {
+				CHECK(baseline_value.Get<double>() == doctest::Approx(expected[j].Get<double>()));
+				CHECK(compiled_value.Get<double>() == doctest::Approx(expected[j].Get<double>()));
+			}
+		}
+
+		// Cached variable handles must follow changes to the bound values.
+		player.hp = 80;
+		Rml::Variant value;
+		REQUIRE(compiled[1]->Run(expression_interface, value));
+		CHECK(value.Get<int>() == 50);
+		player.hp = 40;
+
+		const int num_updates = 20;
+		uint64_t start = OS::get_singleton()->get_ticks_usec();
+		Rml::Variant result;
+		for (int update = 0; update < num_updates; update++) {
+			for (auto &evaluate : baseline)
+				result = evaluate();
+		}
+		const int64_t baseline_usec = (int64_t)(OS::get_singleton()->get_ticks_usec() - start) / num_updates;
+
+		start = OS::get_singleton()->get_ticks_usec();
+		for (int update = 0; update < num_updates; update++) {
+			for (auto &expression : compiled)
+				expression->Run(expression_interface, result);
+		}
+		const int64_t compiled_usec = (int64_t)(OS::get_singleton()->get_ticks_usec() - start) / num_updates;
+		MESSAGE(vformat("Evaluated %d expressions per update: %d usec by hand, %d usec compiled.", (int)compiled.size(), baseline_usec, compiled_usec));
+	}
+}
+
+TEST_SUITE("[[rmlui]] Data model dirty tracking") {
+	struct Fighter {
+		int hp = 100;
+		Rml::String name;
+	};
+
+	TEST_CASE("[rmlui] dirtying an array element only updates its views") {
+		RmlTestContext test;
+		Rml::Context *context = test.context;
+
+		Rml::Vector<Fighter> fighters(64);
+		for (int i = 0; i < (int)fighters.size(); i++)
+			fighters[i].name = Rml::CreateString(16, "f%d", i);
+
+		Rml::DataModelConstructor constructor = context->CreateDataModel("arena");
+		REQUIRE(constructor);
+		if (auto fighter_handle = constructor.RegisterStruct<Fighter>()) {
+			fighter_handle.RegisterMember("hp", &Fighter::hp);
+			fighter_handle.RegisterMember("name", &Fighter::name);
+		}
+		constructor.RegisterArray<Rml::Vector<Fighter>>();
+		constructor.Bind("fighters", &fighters);
+		Rml::DataModelHandle handle = constructor.GetModelHandle();
+
+		Rml::String rml = "<rml><head><style>"
+						  "body { display: block; width: 400px; }"
+						  "div { display: block; }"
+						  "</style></head><body><div id=\"list\" data-model=\"arena\">"
+						  "<div data-for=\"fighter : fighters\">{{fighter.name}}:{{fighter.hp}}</div>"
+						  "</div></body></rml>";
+
+		Rml::ElementDocument *document = test.load(rml);
+
+		Rml::Element *list = document->GetElementById("list");
+		REQUIRE(list != nullptr);
+		REQUIRE(list->GetNumChildren() == 65);
+
+		CHECK(GetRowText(list, 12) == "f12:100");
+
+		// Only the views of the dirtied element run, the undirtied change to its neighbour stays invisible.
+		fighters[12].hp = 40;
+		fighters[13].hp = 30;
+		handle.DirtyArrayElement("fighters", 12, "hp");
+		context->Update();
+		CHECK(GetRowText(list, 12) == "f12:40");
+		CHECK(GetRowText(list, 13) == "f13:100");
+
+		handle.DirtyVariable("fighters[13]");
+		context->Update();
+		CHECK(GetRowText(list, 13) == "f13:30");
+
+		// Dirtying the whole variable still updates every view.
+		for (Fighter &fighter : fighters)
+			fighter.hp = 1;
+		handle.DirtyVariable("fighters");
+		context->Update();
+		CHECK(GetRowText(list, 0) == "f0:1");
+		CHECK(GetRowText(list, 63) == "f63:1");
+	}
+}
+
 TEST_SUITE("[[rmlui]] Embedded RML examples") {
 	TEST_CASE("[rmlui] hello world example is valid") {
 		CHECK(RML_EXAMPLE_HELLO_WORLD != nullptr);
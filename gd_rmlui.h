@@ -17,6 +17,7 @@ class RmlDocument : public Reference {
 
 	friend class GdRmlUIControl;
 	void *_doc; // Rml::ElementDocument* (opaque to avoid header dependency)
+	bool _await_textures;
 
 protected:
 	static void _bind_methods();
@@ -36,6 +37,9 @@ public:
 	String get_element_inner_rml(const String &p_id) const;
 	void set_element_class(const String &p_id, const String &p_class, bool p_activate);
 
+	void set_await_textures(bool p_enable);
+	bool is_await_textures() const;
+
 	static Ref<RmlDocument> load_from_string(const String &p_rml, GdRmlUIControl *p_ctrl);
 
 	RmlDocument();
@@ -49,6 +53,13 @@ class GdRmlUIControl : public Control {
 	friend class RmlDocument;
 	GodotRmlPlugin *_plugin;
 	Vector<Ref<RmlDocument>> _documents;
+	bool _idle_mode;
+	bool _texture_atlas;
+	int _atlas_max_image_size;
+	bool _async_texture_loading;
+	int _pending_textures;
+	String _glyph_cache_path;
+	int _style_threads;
 
 protected:
 	static void _bind_methods();
@@ -59,7 +70,32 @@ public:
 	Ref<RmlDocument> load_document(const String &p_path);
 	Ref<RmlDocument> load_document_from_string(const String &p_rml);
 	void load_font(const String &p_path);
+	void prewarm_font(const String &p_family, const PoolIntArray &p_sizes, const String &p_charset);
 	int get_document_count() const;
+	Dictionary get_render_stats() const;
+	Dictionary get_style_stats() const;
+	void reset_style_stats();
+	Dictionary get_layout_stats() const;
+
+	void set_idle_mode(bool p_enable);
+	bool is_idle_mode() const;
+
+	void set_texture_atlas(bool p_enable);
+	bool is_texture_atlas() const;
+	void set_atlas_max_image_size(int p_size);
+	int get_atlas_max_image_size() const;
+	Dictionary get_atlas_stats() const;
+
+	void set_async_texture_loading(bool p_enable);
+	bool is_async_texture_loading() const;
+	int get_pending_texture_count() const;
+
+	void set_glyph_cache_path(const String &p_path);
+	String get_glyph_cache_path() const;
+	bool save_glyph_cache();
+
+	void set_style_threads(int p_count);
+	int get_style_threads() const;
 
 	void toggle_debugger();
 	void show_debugger();